@@ -111,6 +111,30 @@ cat <<-EOF
 	echo "dist_hax_DATA = lib/mod/__init__.py"
 	echo "dist_hax_DATA += lib/mod/latex.py"
 	echo ""
+	echo "# the library tests are exported to Python, so run them through the installed wrapper"
+	echo "installcheck-local:"
+	echo '	rm -rf installcheck && mkdir installcheck'
+	echo '	cd installcheck && "$(DESTDIR)$(bindir)/mod" -q --nopost \'
+	echo '		-e "test_dgDump()" \'
+	echo '		-e "test_dgCheckpoint()" \'
+	echo '		-e "test_dgRewrite()" \'
+	echo '		-e "test_dgThreads()" \'
+	echo '		-e "test_multiDimSelector()" \'
+	echo '		-e "test_graphCanon()" \'
+	echo '		-e "test_ruleHash()" \'
+	echo '		-e "test_graphState()" \'
+	echo '		-e "test_vertexOrder()" \'
+	echo '		-e "test_shortestPath()" \'
+	echo '		-e "test_multisetIndex()" \'
+	echo '		-e "test_boundRules()" \'
+	echo '		-e "test_termMorphism()" \'
+	echo '		-e "test_wamCells()" \'
+	echo '		-e "test_groundTerms()" \'
+	echo '		-e "test_stereoSearch()" \'
+	echo '		-e "test_sortByKey()"'
+	echo "clean-local:"
+	echo '	rm -rf installcheck'
+	echo ""
 	echo "endif"
 }
 
@@ -0,0 +1,69 @@
+#ifndef JLA_BOOST_GRAPH_BFSDISTANCES_HPP
+#define JLA_BOOST_GRAPH_BFSDISTANCES_HPP
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace jla_boost {
+
+// Unweighted shortest path distances by breadth-first search.
+// Vertices which are unreachable, or further away than maxDistance, get distance std::numeric_limits<int>::max().
+
+// Returns the distances from src to all vertices, indexed by vertex index.
+
+template<typename Graph>
+std::vector<int> bfs_distances(const Graph &g, typename boost::graph_traits<Graph>::vertex_descriptor src,
+		int maxDistance = std::numeric_limits<int>::max()) {
+	using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+	const auto idx = get(boost::vertex_index_t(), g);
+	std::vector<int> distance(num_vertices(g), std::numeric_limits<int>::max());
+	std::vector<Vertex> queue{src};
+	distance[get(idx, src)] = 0;
+	for(std::size_t i = 0; i < queue.size(); i++) {
+		const auto v = queue[i];
+		const int d = distance[get(idx, v)];
+		if(d >= maxDistance) break;
+		for(auto oes = out_edges(v, g); oes.first != oes.second; ++oes.first) {
+			const auto vAdj = target(*oes.first, g);
+			auto &dAdj = distance[get(idx, vAdj)];
+			if(dAdj != std::numeric_limits<int>::max()) continue;
+			dAdj = d + 1;
+			queue.push_back(vAdj);
+		}
+	}
+	return distance;
+}
+
+// Returns the distance from src to tar, and stops the search as soon as tar is reached.
+
+template<typename Graph>
+int bfs_distance(const Graph &g, typename boost::graph_traits<Graph>::vertex_descriptor src,
+		typename boost::graph_traits<Graph>::vertex_descriptor tar, int maxDistance = std::numeric_limits<int>::max()) {
+	using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+	if(src == tar) return 0;
+	const auto idx = get(boost::vertex_index_t(), g);
+	std::vector<int> distance(num_vertices(g), std::numeric_limits<int>::max());
+	std::vector<Vertex> queue{src};
+	distance[get(idx, src)] = 0;
+	for(std::size_t i = 0; i < queue.size(); i++) {
+		const auto v = queue[i];
+		const int d = distance[get(idx, v)];
+		if(d >= maxDistance) break;
+		for(auto oes = out_edges(v, g); oes.first != oes.second; ++oes.first) {
+			const auto vAdj = target(*oes.first, g);
+			if(vAdj == tar) return d + 1;
+			auto &dAdj = distance[get(idx, vAdj)];
+			if(dAdj != std::numeric_limits<int>::max()) continue;
+			dAdj = d + 1;
+			queue.push_back(vAdj);
+		}
+	}
+	return std::numeric_limits<int>::max();
+}
+
+} // namespace jla_boost
+
+#endif /* JLA_BOOST_GRAPH_BFSDISTANCES_HPP */
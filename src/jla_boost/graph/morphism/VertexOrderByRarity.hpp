@@ -0,0 +1,52 @@
+#ifndef JLA_BOOST_GRAPH_MORPHISM_VERTEXORDERBYRARITY_HPP
+#define JLA_BOOST_GRAPH_MORPHISM_VERTEXORDERBYRARITY_HPP
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+
+#include <tuple>
+#include <vector>
+
+namespace jla_boost {
+namespace GraphMorphism {
+
+// Returns a vertex order for matching where the most selective vertices come first.
+// The rarity function gives each vertex a value, where lower means fewer candidates in the host,
+// e.g., the frequency of its label in the host.
+// Each next vertex is chosen among those adjacent to an earlier vertex, if any,
+// by lowest rarity, then most earlier neighbours, then highest degree.
+// Otherwise the vertex is chosen among all remaining vertices by lowest rarity, then highest degree.
+
+template<typename Graph, typename Rarity>
+std::vector<typename boost::graph_traits<Graph>::vertex_descriptor>
+vertex_order_by_rarity(const Graph &g, Rarity rarity) {
+	using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+	const auto idx = get(boost::vertex_index_t(), g);
+	std::vector<Vertex> remaining(vertices(g).first, vertices(g).second);
+	std::vector<std::size_t> numOrderedNeighbours(num_vertices(g), 0);
+	std::vector<Vertex> order;
+	order.reserve(remaining.size());
+	while(!remaining.empty()) {
+		const auto key = [&](Vertex v) {
+			const long numNeighbours = numOrderedNeighbours[get(idx, v)];
+			const long degree = out_degree(v, g);
+			// lexicographically smallest is best
+			return std::make_tuple(numNeighbours == 0, rarity(v), -numNeighbours, -degree);
+		};
+		auto best = remaining.begin();
+		for(auto iter = remaining.begin() + 1; iter != remaining.end(); ++iter) {
+			if(key(*iter) < key(*best)) best = iter;
+		}
+		const Vertex v = *best;
+		remaining.erase(best);
+		order.push_back(v);
+		for(auto oes = out_edges(v, g); oes.first != oes.second; ++oes.first)
+			++numOrderedNeighbours[get(idx, target(*oes.first, g))];
+	}
+	return order;
+}
+
+} // namespace GraphMorphism
+} // namespace jla_boost
+
+#endif /* JLA_BOOST_GRAPH_MORPHISM_VERTEXORDERBYRARITY_HPP */
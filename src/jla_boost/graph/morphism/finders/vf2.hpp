@@ -28,6 +28,31 @@
 namespace jla_boost {
 namespace GraphMorphism {
 using namespace boost; // TODO: remvoe
+
+// Hooks for vertex predicates which keep state along the search, found by argument dependent lookup.
+// vf2_try_push(pred, v, w) is called when the pair (v, w) has been found feasible, right before it is added to the state,
+// and the pair is rejected if it returns false.
+// vf2_pop(pred, v, w) is called after a pair added to the state has been removed again.
+// The defaults do nothing.
+
+template<typename VertexPred, typename VertexDom, typename VertexCodom>
+bool vf2_try_push(VertexPred &pred, const VertexDom &v, const VertexCodom &w) {
+	return true;
+}
+
+template<typename VertexPred, typename VertexDom, typename VertexCodom>
+void vf2_pop(VertexPred &pred, const VertexDom &v, const VertexCodom &w) { }
+
+// The position of a monomorphism search which was stopped by the callback returning false,
+// such that a new search with the same graphs, predicates and vertex order can continue right after the last reported morphism.
+// A default constructed resume point starts the search from the beginning.
+
+struct vf2_resume_point {
+	// the pairs of the stopped match, as positions in the vertex order of the domain and in the vertex list of the codomain
+	std::vector<std::pair<std::size_t, std::size_t> > path;
+	bool stopped = false;
+};
+
 namespace detail {
 
 template<typename GraphDom, typename GraphCodom, typename IdxDom, typename IdxCodom>
@@ -388,6 +413,13 @@ public:
 		vertex2_type w = stateDom.core(v);
 		stateDom.pop(v, w);
 		stateCodom.pop(w, v);
+		vf2_pop(vertexPred, v, w);
+	}
+
+	// Lets the vertex predicate reject a feasible pair, right before it is added
+
+	bool try_push(const vertex1_type& v, const vertex2_type& w) {
+		return vf2_try_push(vertexPred, v, w);
 	}
 
 	// Checks the feasibility of a new vertex pair
@@ -616,6 +648,8 @@ struct vf2_match_continuation {
 // of a correspondence map (graph1 to graph2). Returning false from the
 // user_callback will terminate the search. Function match will return
 // true if the entire search space was explored.
+// If resume is not null, then a search stopped by user_callback is recorded in it,
+// and a search stopped earlier is continued by first pushing the recorded pairs again.
 
 template<typename Graph1,
 typename Graph2,
@@ -630,7 +664,7 @@ bool match(const Graph1& graph1, const Graph2& graph2,
 		SubGraphIsoMapCallback user_callback, const VertexOrder1& vertex_order1,
 		state<Graph1, Graph2, IndexMap1, IndexMap2,
 		EdgeEquivalencePredicate, VertexEquivalencePredicate,
-		SubGraphIsoMapCallback, problem_selection>& s) {
+		SubGraphIsoMapCallback, problem_selection>& s, vf2_resume_point *resume = nullptr) {
 
 	typename VertexOrder1::const_iterator graph1_verts_iter;
 
@@ -641,10 +675,40 @@ bool match(const Graph1& graph1, const Graph2& graph2,
 	std::vector<match_continuation_type> k;
 	bool found_match = false;
 
+	if(resume && resume->stopped) {
+		// the pairs were feasible in the stopped search, and pushing them in the same order recreates its state
+		resume->stopped = false;
+		graph2_verts_iter_end = vertices(graph2).second;
+		for(const auto &p : resume->path) {
+			graph1_verts_iter = std::next(vertex_order1.begin(), p.first);
+			graph2_verts_iter = std::next(vertices(graph2).first, p.second);
+			const bool pushed = s.feasible(*graph1_verts_iter, *graph2_verts_iter)
+					&& s.try_push(*graph1_verts_iter, *graph2_verts_iter);
+			BOOST_ASSERT(pushed);
+			(void) pushed;
+			match_continuation_type kk;
+			kk.graph1_verts_iter = graph1_verts_iter;
+			kk.graph2_verts_iter = graph2_verts_iter;
+			k.push_back(kk);
+			s.push(*graph1_verts_iter, *graph2_verts_iter);
+		}
+		found_match = true;
+		goto back_track;
+	}
+
 recur:
 	if(s.success()) {
-		if(!s.call_back(user_callback))
+		if(!s.call_back(user_callback)) {
+			if(resume) {
+				resume->path.clear();
+				for(const auto &kk : k) {
+					resume->path.emplace_back(std::distance(vertex_order1.begin(), kk.graph1_verts_iter),
+							std::distance(vertices(graph2).first, kk.graph2_verts_iter));
+				}
+				resume->stopped = true;
+			}
 			return true;
+		}
 		found_match = true;
 
 		goto back_track;
@@ -662,7 +726,8 @@ recur:
 	boost::tie(graph2_verts_iter, graph2_verts_iter_end) = vertices(graph2);
 	while(graph2_verts_iter != graph2_verts_iter_end) {
 		if(s.possible_candidate2(*graph2_verts_iter)) {
-			if(s.feasible(*graph1_verts_iter, *graph2_verts_iter)) {
+			if(s.feasible(*graph1_verts_iter, *graph2_verts_iter)
+					&& s.try_push(*graph1_verts_iter, *graph2_verts_iter)) {
 				match_continuation_type kk;
 				kk.graph1_verts_iter = graph1_verts_iter;
 				kk.graph2_verts_iter = graph2_verts_iter;
@@ -708,7 +773,8 @@ bool vf2_subgraph_morphism(const GraphSmall& graph_small, const GraphLarge& grap
 		IndexMapSmall index_map_small, IndexMapLarge index_map_large,
 		const VertexOrderSmall& vertex_order_small,
 		EdgeEquivalencePredicate edge_comp,
-		VertexEquivalencePredicate vertex_comp) {
+		VertexEquivalencePredicate vertex_comp,
+		vf2_resume_point *resume = nullptr) {
 
 	// Graph requirements
 	BOOST_CONCEPT_ASSERT((BidirectionalGraphConcept<GraphSmall>));
@@ -770,7 +836,7 @@ bool vf2_subgraph_morphism(const GraphSmall& graph_small, const GraphLarge& grap
 			SubGraphIsoMapCallback, problem_selection>
 			s(graph_small, graph_large, edge_comp, vertex_comp);
 
-	return detail::match(graph_small, graph_large, user_callback, vertex_order_small, s);
+	return detail::match(graph_small, graph_large, user_callback, vertex_order_small, s, resume);
 }
 
 } // namespace detail
@@ -803,6 +869,35 @@ bool vf2_subgraph_mono(const GraphSmall& graph_small, const GraphLarge& graph_la
 }
 
 
+// As vf2_subgraph_mono, but if user_callback stops the search, then it is recorded in resume,
+// and if resume holds a stopped search, then it is continued after the last morphism reported to it.
+
+template <typename GraphSmall,
+typename GraphLarge,
+typename IndexMapSmall,
+typename IndexMapLarge,
+typename VertexOrderSmall,
+typename EdgeEquivalencePredicate,
+typename VertexEquivalencePredicate,
+typename SubGraphIsoMapCallback>
+bool vf2_subgraph_mono(const GraphSmall& graph_small, const GraphLarge& graph_large,
+		SubGraphIsoMapCallback user_callback,
+		IndexMapSmall index_map_small, IndexMapLarge index_map_large,
+		const VertexOrderSmall& vertex_order_small,
+		EdgeEquivalencePredicate edge_comp,
+		VertexEquivalencePredicate vertex_comp,
+		vf2_resume_point &resume) {
+	return detail::vf2_subgraph_morphism<detail::subgraph_mono>
+			(graph_small, graph_large,
+			user_callback,
+			index_map_small, index_map_large,
+			vertex_order_small,
+			edge_comp,
+			vertex_comp,
+			&resume);
+}
+
+
 // All default interface for vf2_subgraph_iso
 
 template <typename GraphSmall,
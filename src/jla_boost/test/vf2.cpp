@@ -464,10 +464,42 @@ void test_return_value() {
 	}
 }
 
+void test_resume() {
+	typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> Graph;
+	Graph gSmall(3), gLarge(5);
+	add_edge(0, 1, gSmall);
+	add_edge(1, 2, gSmall);
+	for(int i = 0; i < 5; ++i)
+		for(int j = i + 1; j < 5; ++j)
+			add_edge(i, j, gLarge);
+	const auto order = vertex_order_by_mult(gSmall);
+	std::vector<std::vector<std::size_t> > all, resumed;
+	const auto store = [](std::vector<std::vector<std::size_t> > &ms, bool continue_) {
+		return [&ms, continue_](auto &&m, const auto &gDom, const auto &gCodom) {
+			std::vector<std::size_t> images;
+			for(auto v : asRange(vertices(gDom)))
+				images.push_back(get(vertex_index_t(), gCodom, get(m, gDom, gCodom, v)));
+			ms.push_back(images);
+			return continue_;
+		};
+	};
+	vf2_subgraph_mono(gSmall, gLarge, store(all, true),
+			get(vertex_index, gSmall), get(vertex_index, gLarge), order, AlwaysTrue(), AlwaysTrue());
+	BOOST_CHECK(all.size() == 5 * 4 * 3);
+	// stop after each morphism, and continue the search from where it stopped
+	vf2_resume_point resume;
+	do {
+		vf2_subgraph_mono(gSmall, gLarge, store(resumed, false),
+				get(vertex_index, gSmall), get(vertex_index, gLarge), order, AlwaysTrue(), AlwaysTrue(), resume);
+	} while(resume.stopped);
+	BOOST_CHECK(resumed == all);
+}
+
 void vf2() {
 	test_vf2(0, nullptr);
 	test_empty_graph_cases();
 	test_return_value();
+	test_resume();
 }
 
 } // namespace test
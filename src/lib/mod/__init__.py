@@ -127,6 +127,8 @@ def dgDerivations(ders):
 	return mod_.dgDerivations(_wrap(VecDerivation, ders))
 def dgRuleComp(graphs, strat, labelSettings=LabelSettings(LabelType.String, LabelRelation.Isomorphism), ignoreRuleLabelTypes=False):
 	return mod_.dgRuleComp(_wrap(VecGraph, graphs), dgStrat(strat), labelSettings, ignoreRuleLabelTypes)
+def dgRuleCompResume(graphs, strat, f, labelSettings=LabelSettings(LabelType.String, LabelRelation.Isomorphism), ignoreRuleLabelTypes=False):
+	return mod_.dgRuleCompResume(_wrap(VecGraph, graphs), dgStrat(strat), labelSettings, ignoreRuleLabelTypes, f)
 def dgDump(graphs, rules, f):
 	return mod_.dgDump(_wrap(VecGraph, graphs), _wrap(VecRule, rules), f)
 
@@ -305,6 +307,12 @@ def _DGStrat_makeSort(doUniverse, less):
 	return _DGStrat_makeSort_orig(doUniverse, _funcWrap(Func_BoolGraphGraphDGStratGraphState, less))
 DGStrat.makeSort = _DGStrat_makeSort
 
+_DGStrat_makeSortByKey_orig = DGStrat.makeSortByKey
+def _DGStrat_makeSortByKey(doUniverse, key, stringKeys=False):
+	F = Func_StringGraphDGStratGraphState if stringKeys else Func_DoubleGraphDGStratGraphState
+	return _DGStrat_makeSortByKey_orig(doUniverse, _funcWrap(F, key))
+DGStrat.makeSortByKey = _DGStrat_makeSortByKey
+
 
 #----------------------------------------------------------
 # Graph
@@ -581,6 +589,15 @@ class _DGStrat_SortProxy(object):
 sortSubset = _DGStrat_SortProxy(False)
 sortUniverse = _DGStrat_SortProxy(True)
 
+class _DGStrat_SortByKeyProxy(object):
+	def __init__(self, doUniverse):
+		self.doUniverse = doUniverse
+	def __call__(self, key, stringKeys=False):
+		return DGStrat.makeSortByKey(self.doUniverse, key, stringKeys)
+
+sortSubsetByKey = _DGStrat_SortByKeyProxy(False)
+sortUniverseByKey = _DGStrat_SortByKeyProxy(True)
+
 # take
 #----------------------------------------------------------
 
@@ -105,6 +105,12 @@ public:
 	bool withStereo;
 	// rst:		.. member:: LabelRelation stereoRelation
 	LabelRelation stereoRelation;
+	// rst:		.. member:: bool incrementalStereo
+	// rst:
+	// rst:		When stereo information is included, check the configuration of each vertex during the morphism search,
+	// rst:		as soon as the vertex and all its neighbours have been mapped, instead of only on complete morphisms.
+	// rst:		This only affects the running time, and it defaults to ``true``.
+	bool incrementalStereo = true;
 };
 
 // rst: .. function:: Config &getConfig()
@@ -189,9 +195,16 @@ struct Config {
 	))                                                                            \
 	((ComponentSG, componentSG,                                                   \
 		((bool, verbose, false))                                                    \
+		((unsigned int, morphismCacheSize, 100000))                                 \
+		((bool, verboseCache, false))                                               \
 	))                                                                            \
 	((DG, dg,                                                                     \
 		((bool, skipInitialGraphIsomorphismCheck, false))                           \
+		((bool, rewriteDirectly, true))                                             \
+		((bool, validateBinaryDump, false))                                         \
+		((std::string, checkpointFile, ""))                                         \
+		((unsigned int, checkpointInterval, 1))                                     \
+		((unsigned int, checkpointIntervalSeconds, 60))                             \
 		((bool, calculateVerbose, false))                                           \
 		((bool, calculateDetailsVerbose, false))                                    \
 		((bool, calculatePredicatesVerbose, false))                                 \
@@ -241,12 +254,14 @@ struct Config {
 		((bool, composeConstraints, true))                                          \
 		((bool, printMatches, false))                                               \
 		((bool, matchesWithIndex, false))                                           \
+		((bool, vertexOrderByLabelFrequency, false))                                \
 	))                                                                            \
 	((Stereo, stereo,                                                             \
 		((bool, silenceDeductionWarnings, false))                                   \
 	))                                                                            \
 	((Term, unification,                                                          \
 		((bool, verboseMGU, false))                                                 \
+		((unsigned int, groundTermStoreLimit, 1000000))                             \
 	))
 
 #define MOD_CONFIG_nsIter(rNS, dataNS, tNS)                                       \
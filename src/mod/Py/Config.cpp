@@ -105,6 +105,14 @@ void Config_doExport() {
 			// rst:
 			// rst:			:type: :py:class:`LabelRelation`
 			.def_readwrite("stereoRelation", &mod::LabelSettings::stereoRelation)
+			// rst:		.. py:attribute:: incrementalStereo
+			// rst:
+			// rst:			Whether stereo configurations are checked during the morphism search,
+			// rst:			as soon as a vertex and all its neighbours have been mapped, instead of only on complete morphisms.
+			// rst:			This only affects the running time, and it defaults to ``True``.
+			// rst:
+			// rst:			:type: bool
+			.def_readwrite("incrementalStereo", &mod::LabelSettings::incrementalStereo)
 			;
 
 #define NSIter(rNS, dataNS, tNS)                                                \
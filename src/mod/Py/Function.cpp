@@ -31,6 +31,8 @@ void Function_doExport() {
 	exportFunc < std::string(std::shared_ptr<graph::Graph>, std::shared_ptr<dg::DG>, bool)>("Func_StringGraphDGBool");
 	// Graph x Strategy::GraphState -> X
 	exportFunc<bool(std::shared_ptr<graph::Graph>, const dg::Strategy::GraphState&)>("Func_BoolGraphDGStratGraphState");
+	exportFunc<double(std::shared_ptr<graph::Graph>, const dg::Strategy::GraphState&)>("Func_DoubleGraphDGStratGraphState");
+	exportFunc < std::string(std::shared_ptr<graph::Graph>, const dg::Strategy::GraphState&)>("Func_StringGraphDGStratGraphState");
 	// Graph x Strategy::GraphState x bool -> X
 	exportFunc<bool(std::shared_ptr<graph::Graph>, const dg::Strategy::GraphState&, bool)>("Func_BoolGraphDGStratGraphStateBool");
 	// Graph x Graph x Strategy::GraphState -> X
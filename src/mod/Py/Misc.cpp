@@ -5,6 +5,23 @@
 #include <mod/dg/GraphInterface.h>
 #include <mod/lib/Graph/Single.h>
 #include <mod/lib/Random.h>
+#include <mod/lib/test/BoundRules.h>
+#include <mod/lib/test/DGCheckpoint.h>
+#include <mod/lib/test/DGDump.h>
+#include <mod/lib/test/DGRewrite.h>
+#include <mod/lib/test/DGThreads.h>
+#include <mod/lib/test/GraphCanon.h>
+#include <mod/lib/test/GraphState.h>
+#include <mod/lib/test/GroundTerms.h>
+#include <mod/lib/test/MultiDimSelector.h>
+#include <mod/lib/test/MultisetIndex.h>
+#include <mod/lib/test/RuleHash.h>
+#include <mod/lib/test/ShortestPath.h>
+#include <mod/lib/test/SortByKey.h>
+#include <mod/lib/test/StereoSearch.h>
+#include <mod/lib/test/TermMorphism.h>
+#include <mod/lib/test/VertexOrder.h>
+#include <mod/lib/test/WamCells.h>
 
 #include <jla_boost/test/vf2.hpp>
 
@@ -51,6 +68,25 @@ void Misc_doExport() {
 
 	// jla_boost tests
 	py::def("test_vf2", &jla_boost::test::vf2);
+
+	// libMØD tests
+	py::def("test_dgCheckpoint", &lib::test::dgCheckpoint);
+	py::def("test_dgDump", &lib::test::dgDump);
+	py::def("test_dgRewrite", &lib::test::dgRewrite);
+	py::def("test_dgThreads", &lib::test::dgThreads);
+	py::def("test_multiDimSelector", &lib::test::multiDimSelector);
+	py::def("test_graphCanon", &lib::test::graphCanon);
+	py::def("test_ruleHash", &lib::test::ruleHash);
+	py::def("test_graphState", &lib::test::graphState);
+	py::def("test_vertexOrder", &lib::test::vertexOrder);
+	py::def("test_shortestPath", &lib::test::shortestPath);
+	py::def("test_multisetIndex", &lib::test::multisetIndex);
+	py::def("test_boundRules", &lib::test::boundRules);
+	py::def("test_termMorphism", &lib::test::termMorphism);
+	py::def("test_wamCells", &lib::test::wamCells);
+	py::def("test_groundTerms", &lib::test::groundTerms);
+	py::def("test_stereoSearch", &lib::test::stereoSearch);
+	py::def("test_sortByKey", &lib::test::sortByKey);
 }
 
 } // namespace Py
@@ -131,6 +131,15 @@ void DG_doExport() {
 			// rst:			:rtype: string
 			// rst:			:raises: :py:class:`LogicError` if the DG has not been calculated.
 			.def("dump", &DG::dump)
+			// rst:		.. py:method:: dumpBinary()
+			// rst:
+			// rst:			Export the derivation graph to an external file in a binary format,
+			// rst:			which is faster to import, and which also supports stereo information.
+			// rst:
+			// rst:			:returns: the filename of the exported derivation graph.
+			// rst:			:rtype: string
+			// rst:			:raises: :py:class:`LogicError` if the DG has not been calculated.
+			.def("dumpBinary", &DG::dumpBinary)
 			// rst:		.. py:method:: list()
 			// rst:
 			// rst:			List information about the calculation.
@@ -177,9 +186,23 @@ void DG_doExport() {
 	// rst:		:raises: :class:`LogicError` if :any:`ignoreRuleLabelTypes` is `False` and a rule in the given strategy
 	// rst:			has an intended label type different from the given type in :any:`labelSettings`.
 	py::def("dgRuleComp", &DG::ruleComp);
+	// rst: .. py:method:: dgRuleCompResume(graphs, strat, file, labelSettings=LabelSettings(LabelType.String, LabelRelation.Isomorphism), ignoreRuleLabelTypes=False)
+	// rst:
+	// rst:		Initialize a derivation graph defined by a strategy, which when calculated is resumed from a checkpoint.
+	// rst:		See :cpp:func:`dg::DG::ruleCompResume` for how checkpoints are written and resumed.
+	// rst:		Only the repeat strategies which are not nested in other repeat strategies continue from the checkpoint.
+	// rst:		All other parts of the strategy, including those before the first of these repeat strategies,
+	// rst:		are executed again.
+	// rst:
+	// rst:		:param file: the name of the checkpoint file.
+	// rst:		:type file: string
+	// rst:		:returns: the derivation graph object. The calculation method must be called to resume the calculation.
+	// rst:		:rtype: :class:`DG`
+	// rst:		:raises: :class:`InputError` if the checkpoint can not be loaded or does not fit the strategy.
+	py::def("dgRuleCompResume", &DG::ruleCompResume);
 	// rst: .. py:method:: dgDump(graphs, rules, file)
 	// rst:
-	// rst:		Load a derivation graph dump.
+	// rst:		Load a derivation graph dump, in either the text or the binary format.
 	// rst:
 	// rst:		:param graphs: Any graph in the dump which is isomorphic one of these graphs is replaced by the given graph.
 	// rst:		:type graphs: list of :class:`Graph`
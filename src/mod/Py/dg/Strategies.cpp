@@ -67,10 +67,11 @@ void Strategy_doExport() {
 			// rst: 
 			// rst:			The references to all derivations in the underlying derivation graph.
 			// rst:			I.e., some derivations might involve graphs not in the universe.
+			// rst:			The list is a copy, so it does not include derivations added later.
 			// rst:
 			// rst:			:type: list of :py:class:`DGHyperEdge`
 			// rst:
-			.add_property("_hyperEdges", py::make_function(&Strategy::GraphState::getHyperEdges, py::return_internal_reference<1>()))
+			.add_property("_hyperEdges", py::make_function(&Strategy::GraphState::getHyperEdges, py::return_value_policy<py::copy_const_reference>()))
 			;
 
 
@@ -175,6 +176,21 @@ void Strategy_doExport() {
 			// rst:			:rtype: :class:`DGStrat`
 			.def("makeSequence", &Strategy::makeSequence).staticmethod("makeSequence")
 			.def("makeSort", &Strategy::makeSort).staticmethod("makeSort") // TODO: remove
+			// rst:		.. py:staticmethod:: makeSortByKey(doUniverse, key, stringKeys=False)
+			// rst:
+			// rst:			:param doUniverse: whether to sort the universe instead of the subset.
+			// rst:			:type doUniverse: bool
+			// rst:			:param key: the function computing the sorting key of a graph, which is called once for each graph.
+			// rst:			:type key: float(:class:`Graph`, :class:`DGStratGraphState`), or str(:class:`Graph`, :class:`DGStratGraphState`) if ``stringKeys``
+			// rst:			:param stringKeys: whether the keys are strings instead of numbers.
+			// rst:			:type stringKeys: bool
+			// rst:			:returns: a strategy which stably sorts the graphs by increasing key.
+			// rst:			:rtype: :class:`DGStrat`
+			.def("makeSortByKey", static_cast<std::shared_ptr<Strategy>(*)(bool,
+					std::shared_ptr<mod::Function<double(std::shared_ptr<graph::Graph>, const Strategy::GraphState&)> >)> (&Strategy::makeSortByKey))
+			.def("makeSortByKey", static_cast<std::shared_ptr<Strategy>(*)(bool,
+					std::shared_ptr<mod::Function<std::string(std::shared_ptr<graph::Graph>, const Strategy::GraphState&)> >)> (&Strategy::makeSortByKey))
+			.staticmethod("makeSortByKey")
 			.def("makeTake", &Strategy::makeTake).staticmethod("makeTake") // TODO: remove
 			;
 }
@@ -5,6 +5,7 @@
 #include <mod/dg/GraphInterface.h>
 #include <mod/dg/Printer.h>
 #include <mod/graph/Printer.h>
+#include <mod/lib/DG/Dump.h>
 #include <mod/lib/DG/Hyper.h>
 #include <mod/lib/DG/NonHyper.h>
 #include <mod/lib/DG/NonHyperDerivations.h>
@@ -56,11 +57,7 @@ const lib::DG::Hyper &DG::getHyper() const {
 
 std::size_t DG::numVertices() const {
 	if(!p->dg->getHasCalculated()) throw LogicError("Can not get number of vertices before the derivation graph it has been calculated.\n");
-	using boost::vertices;
-	auto vs = vertices(getHyper().getGraph());
-	return std::count_if(vs.first, vs.second, [this](lib::DG::HyperVertex v) {
-		return getHyper().getGraph()[v].kind == lib::DG::HyperVertexKind::Vertex;
-	});
+	return getHyper().getNumVertices();
 }
 
 DG::VertexRange DG::vertices() const {
@@ -70,11 +67,7 @@ DG::VertexRange DG::vertices() const {
 
 std::size_t DG::numEdges() const {
 	if(!p->dg->getHasCalculated()) throw LogicError("Can not get number of edges before the derivation graph it has been calculated.\n");
-	using boost::vertices;
-	auto vs = vertices(getHyper().getGraph());
-	return std::count_if(vs.first, vs.second, [this](lib::DG::HyperVertex v) {
-		return getHyper().getGraph()[v].kind == lib::DG::HyperVertexKind::Edge;
-	});
+	return getHyper().getNumEdges();
 }
 
 DG::EdgeRange DG::edges() const {
@@ -157,6 +150,11 @@ std::string DG::dump() const {
 	else return lib::IO::DG::Write::dump(*p->dg);
 }
 
+std::string DG::dumpBinary() const {
+	if(!p->dg->getHasCalculated()) throw LogicError("No dump can be done before the derivation graph it has been calculated.\n");
+	else return lib::IO::DG::Write::dumpBinary(*p->dg);
+}
+
 void DG::list() const {
 	p->dg->list(lib::IO::log());
 }
@@ -207,7 +205,16 @@ std::shared_ptr<DG> DG::abstract(const std::string &specification) {
 
 std::shared_ptr<DG> DG::ruleComp(const std::vector<std::shared_ptr<graph::Graph> > &graphs,
 		std::shared_ptr<Strategy> strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes) {
-	auto dgInternal = std::make_unique<lib::DG::NonHyperRuleComp>(graphs, strategy->getStrategy().clone(), labelSettings, ignoreRuleLabelTypes);
+	auto dgInternal = std::make_unique<lib::DG::NonHyperRuleComp>(graphs, strategy->getStrategy().clone(), labelSettings, ignoreRuleLabelTypes, nullptr);
+	return wrapIt(new DG(std::move(dgInternal)));
+}
+
+std::shared_ptr<DG> DG::ruleCompResume(const std::vector<std::shared_ptr<graph::Graph> > &graphs,
+		std::shared_ptr<Strategy> strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes, const std::string &file) {
+	std::ostringstream err;
+	auto checkpoint = lib::IO::DG::Read::checkpoint(prefixFilename(file), err);
+	if(!checkpoint) throw InputError(err.str());
+	auto dgInternal = std::make_unique<lib::DG::NonHyperRuleComp>(graphs, strategy->getStrategy().clone(), labelSettings, ignoreRuleLabelTypes, std::move(checkpoint));
 	return wrapIt(new DG(std::move(dgInternal)));
 }
 
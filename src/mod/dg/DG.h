@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 
 namespace mod {
@@ -125,6 +126,14 @@ public:
 	// rst: 	:returns: the name of the file with the exported data.
 	// rst: 	:throws: :class:`LogicError` if the DG has not been calculated.
 	std::string dump() const;
+	// rst: .. function:: std::string dumpBinary() const
+	// rst:
+	// rst: 	Exports the derivation graph to a binary file, which can be imported faster than the text format,
+	// rst: 	and which also supports derivation graphs with stereo information.
+	// rst:
+	// rst: 	:returns: the name of the file with the exported data.
+	// rst: 	:throws: :class:`LogicError` if the DG has not been calculated.
+	std::string dumpBinary() const;
 	// rst: .. function:: void list() const
 	// rst:
 	// rst: 	Output information on the calculation of the derivation graph.
@@ -158,8 +167,7 @@ public:
 	// rst:
 	// rst: 	:throws: :class:`InputError` on bad input.
 	static std::shared_ptr<DG> abstract(const std::string &specification);
-	// rst: .. function:: static std::shared_ptr<DG> ruleComp(const std::vector<std::shared_ptr<graph::Graph> > &graphs, \
-	// rst:               std::shared_ptr<Strategy> strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes)
+	// rst: .. function:: static std::shared_ptr<DG> ruleComp(const std::vector<std::shared_ptr<graph::Graph> > &graphs, std::shared_ptr<Strategy> strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes)
 	// rst:
 	// rst: 	Initialize a derivation graph with a :cpp:class:`Strategy` and an initial graph database.
 	// rst: 	Any derived graph isomorphic to a given graph is replaced by the given graph.
@@ -172,10 +180,31 @@ public:
 	// rst:			has an intended label type different from the given type in :cpp:any:`labelSettings`.
 	static std::shared_ptr<DG> ruleComp(const std::vector<std::shared_ptr<graph::Graph> > &graphs,
 			std::shared_ptr<Strategy> strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes);
+	// rst: .. function:: static std::shared_ptr<DG> ruleCompResume(const std::vector<std::shared_ptr<graph::Graph> > &graphs, std::shared_ptr<Strategy> strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes, const std::string &file)
+	// rst:
+	// rst: 	As :cpp:func:`ruleComp`, but when calculated the graphs and derivations of the given checkpoint are recreated first.
+	// rst: 	A checkpoint is written during calculation when the config option ``dg.checkpointFile`` is set,
+	// rst: 	after a completed iteration of the :cpp:class:`Strategy` repeat strategies which are not nested in other repeat strategies,
+	// rst: 	when at least ``dg.checkpointInterval`` such iterations have been completed and
+	// rst: 	at least ``dg.checkpointIntervalSeconds`` seconds have passed since the last checkpoint.
+	// rst: 	A checkpoint is also written when such a repeat strategy finishes.
+	// rst: 	Each checkpoint contains the complete derivation graph, so writing one takes time linear in its size.
+	// rst: 	The strategy must be the same as the one used when the checkpoint was written.
+	// rst: 	It is executed from the start, but each of these repeat strategies continues after its last checkpointed iteration.
+	// rst: 	Strategies outside these repeat strategies are thus executed again, so dynamic add strategies outside them
+	// rst: 	must only add graphs which are also given in :cpp:any:`graphs`.
+	// rst:
+	// rst: 	:throws: :class:`InputError` on bad input, if the label settings differ from the checkpoint,
+	// rst: 		or if the checkpoint contains derivations with rules not in the strategy.
+	static std::shared_ptr<DG> ruleCompResume(const std::vector<std::shared_ptr<graph::Graph> > &graphs,
+			std::shared_ptr<Strategy> strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes, const std::string &file);
 	// rst: .. function:: static std::shared_ptr<DG> dumpImport(const std::vector<std::shared_ptr<graph::Graph> > &graphs, const std::vector<std::shared_ptr<rule::Rule> > &rules, const std::string &file)
 	// rst:
 	// rst: 	Load a derivation graph dump. Any graph in the dump which is isomorphic to a given graph is replaced by the given graph.
 	// rst: 	The same procedure is done for the rules, however only using the name of the rule for comparison.
+	// rst: 	Both the text format and the binary format are accepted.
+	// rst: 	The graphs in a binary dump are trusted to be pairwise non-isomorphic,
+	// rst: 	unless the config option ``dg.validateBinaryDump`` is set.
 	// rst:
 	// rst: 	:throws: :class:`InputError` on bad input.
 	static std::shared_ptr<DG> dumpImport(const std::vector<std::shared_ptr<graph::Graph> > &graphs, const std::vector<std::shared_ptr<rule::Rule> > &rules, const std::string &file);
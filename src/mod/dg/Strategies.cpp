@@ -13,6 +13,7 @@
 #include <mod/lib/DG/Strategies/Rule.h>
 #include <mod/lib/DG/Strategies/Sequence.h>
 #include <mod/lib/DG/Strategies/Sort.h>
+#include <mod/lib/DG/Strategies/SortByKey.h>
 #include <mod/lib/DG/Strategies/Take.h>
 #include <mod/lib/IO/IO.h>
 
@@ -27,8 +28,8 @@ namespace dg {
 
 Strategy::GraphState::GraphState(std::function<void(std::vector<std::shared_ptr<graph::Graph> >&) > fSubset,
 		std::function<void(std::vector<std::shared_ptr<graph::Graph> >&) > fUniverse,
-		std::function<void(std::vector<DG::HyperEdge>&) > fEdges)
-: subsetInit(false), universeInit(false), edgesInit(false),
+		std::function<const std::vector<DG::HyperEdge>&() > fEdges)
+: subsetInit(false), universeInit(false), edges(nullptr),
 fSubset(fSubset), fUniverse(fUniverse), fEdges(fEdges) { }
 
 const std::vector<std::shared_ptr<graph::Graph> > &Strategy::GraphState::getSubset() const {
@@ -48,11 +49,8 @@ const std::vector<std::shared_ptr<graph::Graph> > &Strategy::GraphState::getUniv
 }
 
 const std::vector<DG::HyperEdge> &Strategy::GraphState::getHyperEdges() const {
-	if(!edgesInit) {
-		fEdges(edges);
-		edgesInit = true;
-	}
-	return edges;
+	if(!edges) edges = &fEdges();
+	return *edges;
 }
 
 //------------------------------------------------------------------------------
@@ -152,6 +150,16 @@ std::shared_ptr<Strategy> Strategy::makeSort(bool doUniverse,
 	return std::shared_ptr<Strategy>(new Strategy(std::make_unique<lib::DG::Strategies::Sort>(less, doUniverse)));
 }
 
+std::shared_ptr<Strategy> Strategy::makeSortByKey(bool doUniverse,
+		std::shared_ptr<mod::Function<double(std::shared_ptr<graph::Graph>, const Strategy::GraphState&)> > key) {
+	return std::shared_ptr<Strategy>(new Strategy(std::make_unique<lib::DG::Strategies::SortByKey<double> >(key, doUniverse)));
+}
+
+std::shared_ptr<Strategy> Strategy::makeSortByKey(bool doUniverse,
+		std::shared_ptr<mod::Function<std::string(std::shared_ptr<graph::Graph>, const Strategy::GraphState&)> > key) {
+	return std::shared_ptr<Strategy>(new Strategy(std::make_unique<lib::DG::Strategies::SortByKey<std::string> >(key, doUniverse)));
+}
+
 std::shared_ptr<Strategy> Strategy::makeTake(bool doUniverse, unsigned int limit) {
 	return std::shared_ptr<Strategy>(new Strategy(std::make_unique<lib::DG::Strategies::Take>(limit, doUniverse)));
 }
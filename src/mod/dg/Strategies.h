@@ -35,7 +35,7 @@ public:
 	struct GraphState {
 		GraphState(std::function<void(std::vector<std::shared_ptr<graph::Graph> >&) > fSubset,
 				std::function<void(std::vector<std::shared_ptr<graph::Graph> >&) > fUniverse,
-				std::function<void(std::vector<DG::HyperEdge>&) > fEdges);
+				std::function<const std::vector<DG::HyperEdge>&() > fEdges);
 		// rst:		.. function:: const std::vector<std::shared_ptr<graph::Graph> > &getSubset() const
 		// rst:
 		// rst:			:returns: the subset :math:`\mathcal{S}`.
@@ -53,11 +53,11 @@ public:
 		// rst:
 		const std::vector<DG::HyperEdge> &getHyperEdges() const;
 	private:
-		mutable bool subsetInit, universeInit, edgesInit;
+		mutable bool subsetInit, universeInit;
 		mutable std::vector<std::shared_ptr<graph::Graph> > subset, universe;
-		mutable std::vector<DG::HyperEdge> edges;
+		mutable const std::vector<DG::HyperEdge> *edges; // owned by the derivation graph
 		std::function<void(std::vector<std::shared_ptr<graph::Graph> >&) > fSubset, fUniverse;
-		std::function<void(std::vector<DG::HyperEdge>&) > fEdges;
+		std::function<const std::vector<DG::HyperEdge>&() > fEdges;
 	};
 	// rst-nested-end:
 private:
@@ -127,6 +127,12 @@ public:
 	// TODO: remove
 	static std::shared_ptr<Strategy> makeSort(bool doUniverse,
 			std::shared_ptr<Function<bool(std::shared_ptr<graph::Graph>, std::shared_ptr<graph::Graph>, const Strategy::GraphState&)> > less);
+	// Sorts the subset or universe by a key, which is computed once for each graph,
+	// instead of calling a comparator for each comparison as makeSort does.
+	static std::shared_ptr<Strategy> makeSortByKey(bool doUniverse,
+			std::shared_ptr<Function<double(std::shared_ptr<graph::Graph>, const Strategy::GraphState&)> > key);
+	static std::shared_ptr<Strategy> makeSortByKey(bool doUniverse,
+			std::shared_ptr<Function<std::string(std::shared_ptr<graph::Graph>, const Strategy::GraphState&)> > key);
 	// TODO: remove
 	static std::shared_ptr<Strategy> makeTake(bool doUniverse, unsigned int limit);
 };
@@ -1,5 +1,6 @@
 #include "Automorphism.h"
 
+#include <mod/Error.h>
 #include <mod/graph/GraphInterface.h>
 #include <mod/lib/Graph/Single.h>
 
@@ -84,7 +85,10 @@ void Graph::AutGroup::Gens::iterator::advance(std::size_t n) {
 //==============================================================================
 
 Graph::AutGroup::AutGroup(std::shared_ptr<Graph> g, LabelSettings labelSettings)
-: g(g), lt(labelSettings.type), withStereo(labelSettings.withStereo) { }
+: g(g), lt(labelSettings.type), withStereo(labelSettings.withStereo) {
+	// the group from the canonicalisation does not take the stereo embeddings into account
+	if(withStereo) throw LogicError("Can not compute automorphism groups with stereo.");
+}
 
 Graph::AutGroup::Gens Graph::AutGroup::gens() const {
 	return Gens(g, lt, withStereo);
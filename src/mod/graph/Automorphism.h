@@ -80,6 +80,8 @@ struct Graph::AutGroup {
 public:
 	// rst: .. function:: AutGroup(std::shared_ptr<const Graph> g, LabelSettings labelSettings)
 	// rst:
+	// rst:		:throws: :class:`LogicError` if ``labelSettings.withStereo`` is true,
+	// rst:			as automorphism groups can not yet be computed with stereo information.
 	AutGroup(std::shared_ptr<Graph> g, LabelSettings labelSettings);
 	// rst: .. function:: Gens gens() const
 	// rst:
@@ -3,9 +3,12 @@
 
 #include <mod/Error.h>
 
+#include <boost/optional.hpp>
+
 #include <algorithm>
 #include <cassert>
 #include <tuple>
+#include <vector>
 
 // - findAndInsert
 // - MultiDimSelector
@@ -29,9 +32,27 @@ std::pair<T, bool> findAndInsert(Container &c, T t, Pred pred) {
 // MultiDimSelector
 //------------------------------------------------------------------------------
 
-template<bool AllowPartial, typename InnerRangeProvider>
+// Enumerates the combinations of choosing a morphism from each pattern into some host.
+// The range of morphisms for a pair of pattern and host is only requested when the enumeration first needs it,
+// and only advanced as far as the enumeration goes, so a lazy range is only fetched as far as needed
+// (see RC/MatchMaker/LazyComponentMorphisms.h).
+// The ranges of the outermost pattern are released again when the enumeration has moved past its host,
+// so only a single pass over the selector is supported.
+// The choices of two patterns into the same host are required to be compatible, as given by the predicate
+// compatible(patternA, morphismA, patternB, morphismB), and incompatible partial combinations are pruned
+// before any of the inner patterns are enumerated.
+
+struct MultiDimSelectorAlwaysCompatible {
+
+	template<typename Morphism>
+	bool operator()(std::size_t, const Morphism&, std::size_t, const Morphism&) const {
+		return true;
+	}
+};
+
+template<bool AllowPartial, typename InnerRangeProvider, typename Compatible>
 struct MultiDimSelector {
-	using Self = MultiDimSelector<AllowPartial, InnerRangeProvider>;
+	using Self = MultiDimSelector<AllowPartial, InnerRangeProvider, Compatible>;
 	using InnerRange = decltype(std::declval<InnerRangeProvider>()(0, 0));
 	using InnerIterator = decltype(std::declval<const InnerRange>().begin());
 
@@ -39,21 +60,11 @@ struct MultiDimSelector {
 	friend class const_iterator;
 public:
 
-	MultiDimSelector(std::size_t numPatterns, std::size_t numHosts, InnerRangeProvider morphismProvider)
-	: preDisabled(numPatterns, false) {
+	MultiDimSelector(std::size_t numPatterns, std::size_t numHosts, InnerRangeProvider morphismProvider, Compatible compatible)
+	: numHosts(numHosts), morphismProvider(std::move(morphismProvider)), compatible(std::move(compatible)),
+	morphisms(numPatterns, std::vector<boost::optional<InnerRange> >(numHosts)), preDisabled(numPatterns, false) {
 		assert(numPatterns > 0);
 		assert(numHosts > 0);
-		morphisms.reserve(numPatterns);
-		for(std::size_t iPattern = 0; iPattern < numPatterns; iPattern++) {
-			assert(morphisms.size() == iPattern);
-			std::vector<InnerRange> morphismsInner;
-			morphismsInner.reserve(numHosts);
-			for(std::size_t iHost = 0; iHost < numHosts; iHost++) {
-				assert(morphismsInner.size() == iHost);
-				morphismsInner.push_back(morphismProvider(iPattern, iHost));
-			}
-			morphisms.push_back(std::move(morphismsInner));
-		}
 	}
 
 	const_iterator begin() const {
@@ -63,22 +74,44 @@ public:
 	const_iterator end() const {
 		return const_iterator();
 	}
+private:
+
+	const InnerRange &getMorphisms(std::size_t pattern, std::size_t host) const {
+		auto &ms = morphisms[pattern][host];
+		if(!ms) ms = morphismProvider(pattern, host);
+		return *ms;
+	}
+
+	void releaseMorphisms(std::size_t pattern, std::size_t host) const {
+		morphisms[pattern][host] = boost::none;
+	}
+private:
+	const std::size_t numHosts;
+	InnerRangeProvider morphismProvider;
+	Compatible compatible;
+	// pattern -> host -> morphisms, if computed
+	mutable std::vector<std::vector<boost::optional<InnerRange> > > morphisms;
 public:
-	// pattern -> host -> morphisms
-	std::vector<std::vector<InnerRange> > morphisms;
 	std::vector<bool> preDisabled;
 };
 
+template<bool AllowPartial, typename InnerRangeProvider, typename Compatible>
+MultiDimSelector<AllowPartial, InnerRangeProvider, Compatible>
+makeMultiDimSelector(std::size_t numPatterns, std::size_t numHosts, InnerRangeProvider morphismProvider, Compatible compatible) {
+	return MultiDimSelector<AllowPartial, InnerRangeProvider, Compatible>(numPatterns, numHosts, std::move(morphismProvider), std::move(compatible));
+}
+
 template<bool AllowPartial, typename InnerRangeProvider>
-MultiDimSelector<AllowPartial, InnerRangeProvider> makeMultiDimSelector(std::size_t numPatterns, std::size_t numHosts, InnerRangeProvider morphismProvider) {
-	return MultiDimSelector<AllowPartial, InnerRangeProvider>(numPatterns, numHosts, std::forward<InnerRangeProvider>(morphismProvider));
+MultiDimSelector<AllowPartial, InnerRangeProvider, MultiDimSelectorAlwaysCompatible>
+makeMultiDimSelector(std::size_t numPatterns, std::size_t numHosts, InnerRangeProvider morphismProvider) {
+	return makeMultiDimSelector<AllowPartial>(numPatterns, numHosts, std::move(morphismProvider), MultiDimSelectorAlwaysCompatible());
 }
 
 // Implementation details
 //------------------------------------------------------------------------------
 
-template<bool AllowPartial, typename InnerRangeProvider>
-struct MultiDimSelector<AllowPartial, InnerRangeProvider>::const_iterator {
+template<bool AllowPartial, typename InnerRangeProvider, typename Compatible>
+struct MultiDimSelector<AllowPartial, InnerRangeProvider, Compatible>::const_iterator {
 
 	struct Position {
 		std::size_t host;
@@ -100,30 +133,30 @@ public:
 
 	const_iterator(const Self *owner) : owner(owner) {
 		assert(owner);
-		if(owner->morphisms.empty()) {
-			owner = nullptr;
+		const std::size_t numPatterns = owner->morphisms.size();
+		if(numPatterns == 0) {
+			this->owner = nullptr;
 			return;
 		}
-		position.resize(owner->morphisms.size());
-		maxHosts = owner->morphisms.front().size();
-		std::size_t numUnmatched = 0;
-		// find the first match
-		for(std::size_t pattern = 0; pattern < position.size(); ++pattern) {
-			auto &pos = position[pattern];
-			pos.disabled = owner->preDisabled[pattern];
-			if(!setFirst(pattern, 0)) {
-				if(AllowPartial) {
-					pos.host = maxHosts;
-					pos.disabled = true;
-					++numUnmatched;
-				} else {
+		position.resize(numPatterns);
+		maxHosts = owner->numHosts;
+		outermost = numPatterns;
+		for(std::size_t pattern = 0; pattern < numPatterns; ++pattern) {
+			position[pattern].disabled = owner->preDisabled[pattern];
+			if(!position[pattern].disabled) outermost = pattern;
+		}
+		if(!AllowPartial) {
+			// a pattern without any morphisms means there are no combinations at all,
+			// so check that before searching through the other patterns
+			for(std::size_t pattern = 0; pattern < numPatterns; ++pattern) {
+				if(position[pattern].disabled) continue;
+				if(!setFirstFromHost(pattern, 0)) {
 					this->owner = nullptr;
 					return;
 				}
 			}
 		}
-		if(numUnmatched == position.size())
-			this->owner = nullptr;
+		search(numPatterns - 1, true);
 	}
 
 	reference operator*() const {
@@ -131,7 +164,8 @@ public:
 	}
 
 	const_iterator &operator++() {
-		inc(0);
+		assert(owner);
+		search(0, false);
 		return *this;
 	}
 
@@ -146,74 +180,83 @@ public:
 	}
 private:
 
-	bool setFirst(std::size_t pattern, std::size_t firstHost) {
-		auto &pos = position[pattern];
-		assert(!pos.disabled);
-		const auto &mPerHost = owner->morphisms[pattern];
-		auto hostIter = std::find_if(mPerHost.begin() + firstHost, mPerHost.end(), [&](const InnerRange & ms) {
-			return ms.begin() != ms.end();
-		});
-		if(hostIter == mPerHost.end()) {
-			return false;
-		} else {
-			pos.host = hostIter - mPerHost.begin();
-			pos.iterMorphism = hostIter->begin();
-			pos.iterMorphismEnd = hostIter->end();
-			return true;
-		}
-	}
-
-	void inc(std::size_t pattern) {
-		assert(owner);
-		//			std::cout << ">>> morphism++, " << pattern << "\n";
-		if(pattern == position.size()) {
-			//				std::cout << ">>>	nullptr\n";
-			owner = nullptr;
-			return;
-		}
-		if(position[pattern].disabled) {
-			//				std::cout << ">>>	disabled\n";
-			inc(pattern + 1);
-			return;
-		}
-		auto &pos = position[pattern];
-		if(pos.host == maxHosts) {
-			if(!AllowPartial) MOD_ABORT;
-			//				std::cout << ">>>	maxHosts\n";
-			if(!setFirst(pattern, 0))
-				MOD_ABORT;
-			inc(pattern + 1);
-			return;
-		}
-		++pos.iterMorphism;
-		if(pos.iterMorphism != pos.iterMorphismEnd) {
-			//				std::cout << ">>>	morphism\n";
-			return;
-		}
-		//			std::cout << ">>>	setFirst(" << pattern << ", " << (pos.host + 1) << ")\n";
-		if(setFirst(pattern, pos.host + 1)) {
-			//				std::cout << ">>>	got next\n";
-			return;
+	// Find the next combination where the choices for the patterns above the given one are kept.
+	// The given pattern is either reset to its first choice or advanced from its current choice.
+	void search(std::size_t pattern, bool fresh) {
+		const std::size_t numPatterns = position.size();
+		while(true) {
+			bool found = fresh ? setFirst(pattern) : setNext(pattern);
+			while(found && !isCompatible(pattern)) found = setNext(pattern);
+			if(found) {
+				if(pattern == 0) break;
+				--pattern;
+				fresh = true;
+			} else {
+				if(pattern + 1 == numPatterns) {
+					owner = nullptr;
+					return;
+				}
+				++pattern;
+				fresh = false;
+			}
 		}
 		if(AllowPartial) {
-			pos.host = maxHosts;
-			//				std::cout << ">>>	!setFirst, " << pos.host << "/" << (pos.iterMorphismEnd - pos.iterMorphismEnd) << std::endl;
+			// leaving all patterns unmatched is the last combination, and it is not a match
 			bool atEnd = std::all_of(position.begin(), position.end(), [this](const Position & p) {
 				return p.disabled || p.host == maxHosts;
 			});
-			//				std::cout << ">>>	atEnd=" << std::boolalpha << atEnd << std::endl;
 			if(atEnd) owner = nullptr;
-			return;
-		} else {
-			//				std::cout << ">>>	setFirst(" << pattern << ", 0)\n";
-			if(!setFirst(pattern, 0)) MOD_ABORT;
-			inc(pattern + 1);
-			return;
 		}
 	}
+
+	bool setFirst(std::size_t pattern) {
+		if(position[pattern].disabled) return true;
+		return setFirstFromHost(pattern, 0);
+	}
+
+	bool setNext(std::size_t pattern) {
+		auto &pos = position[pattern];
+		if(pos.disabled) return false;
+		if(pos.host == maxHosts) return false;
+		++pos.iterMorphism;
+		if(pos.iterMorphism != pos.iterMorphismEnd) return true;
+		// the outermost pattern never returns to a host
+		if(pattern == outermost) owner->releaseMorphisms(pattern, pos.host);
+		return setFirstFromHost(pattern, pos.host + 1);
+	}
+
+	bool setFirstFromHost(std::size_t pattern, std::size_t firstHost) {
+		auto &pos = position[pattern];
+		assert(!pos.disabled);
+		for(std::size_t host = firstHost; host < maxHosts; ++host) {
+			const auto &ms = owner->getMorphisms(pattern, host);
+			if(ms.begin() == ms.end()) continue;
+			pos.host = host;
+			pos.iterMorphism = ms.begin();
+			pos.iterMorphismEnd = ms.end();
+			return true;
+		}
+		if(!AllowPartial) return false;
+		pos.host = maxHosts;
+		pos.iterMorphism = pos.iterMorphismEnd = InnerIterator();
+		return true;
+	}
+
+	bool isCompatible(std::size_t pattern) const {
+		const auto &pos = position[pattern];
+		if(pos.disabled || pos.host == maxHosts) return true;
+		for(std::size_t other = pattern + 1; other < position.size(); ++other) {
+			const auto &posOther = position[other];
+			if(posOther.disabled || posOther.host != pos.host) continue;
+			if(!owner->compatible(pattern, *pos.iterMorphism, other, *posOther.iterMorphism))
+				return false;
+		}
+		return true;
+	}
 public:
 	const Self *owner;
 	std::size_t maxHosts;
+	std::size_t outermost;
 	Positions position;
 };
 
@@ -1,5 +1,6 @@
 #include "Dump.h"
 
+#include <mod/Config.h>
 #include <mod/Error.h>
 #include <mod/graph/Graph.h>
 #include <mod/rule/Rule.h>
@@ -14,6 +15,7 @@
 
 #include <jla_boost/graph/PairToRangeAdaptor.hpp>
 
+#include <boost/graph/connected_components.hpp>
 #include <boost/spirit/home/x3/char/char.hpp>
 #include <boost/spirit/home/x3/char/char_class.hpp>
 #include <boost/spirit/home/x3/directive/lexeme.hpp>
@@ -24,12 +26,25 @@
 #include <boost/spirit/home/x3/operator/kleene.hpp>
 #include <boost/spirit/include/support_multi_pass.hpp>
 
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+
 namespace mod {
 namespace lib {
 namespace DG {
 namespace Dump {
 namespace {
 
+std::unordered_map<std::string, std::shared_ptr<rule::Rule> > makeRulesByName(const std::vector<std::shared_ptr<rule::Rule> > &rules) {
+	std::unordered_map<std::string, std::shared_ptr<rule::Rule> > res;
+	// the first rule with a given name is the one linked
+	for(const auto &r : rules) res.emplace(r->getName(), r);
+	return res;
+}
+
 struct ConstructionData {
 	const std::vector<std::shared_ptr<rule::Rule> > &rules;
 	std::vector<std::tuple<unsigned int, std::string, std::unique_ptr<lib::Graph::GraphType>, std::unique_ptr<lib::Graph::PropString> > > vertices;
@@ -57,12 +72,11 @@ private:
 		const auto &edges = constructionData->edges;
 		std::unordered_map<unsigned int, std::shared_ptr<rule::Rule> > ruleMap;
 		std::unordered_map<unsigned int, std::shared_ptr<graph::Graph> > graphMap;
+		const auto rulesByName = makeRulesByName(rules);
 		for(const auto &t : rulesParsed) {
-			auto iter = std::find_if(begin(rules), end(rules), [&t](std::shared_ptr<rule::Rule> r) -> bool {
-				return r->getName() == get<1>(t);
-			});
-			if(iter != end(rules)) {
-				std::shared_ptr<rule::Rule> r = *iter;
+			auto iter = rulesByName.find(get<1>(t));
+			if(iter != end(rulesByName)) {
+				std::shared_ptr<rule::Rule> r = iter->second;
 				IO::log() << "Rule linked: " << r->getName() << std::endl;
 				this->rules.push_back(r);
 				ruleMap[get<0>(t)] = r;
@@ -271,7 +285,7 @@ NonHyper *load(const std::vector<std::shared_ptr<graph::Graph> > &graphs, const
 
 void write(const NonHyper &dgNonHyper, std::ostream & s) {
 	if(dgNonHyper.getLabelSettings().withStereo) {
-		throw mod::LogicError("Can not yet dump DGs with stereo data.");
+		throw mod::LogicError("Can not dump DGs with stereo data in the text format, use the binary format instead.");
 	}
 	using Vertex = lib::DG::HyperVertex;
 	using Edge = lib::DG::HyperEdge;
@@ -331,6 +345,718 @@ void write(const NonHyper &dgNonHyper, std::ostream & s) {
 	}
 }
 
+//------------------------------------------------------------------------------
+// Binary format
+//------------------------------------------------------------------------------
+
+namespace {
+namespace Binary {
+
+// Layout, all integers in native byte order, each section padded to a multiple of 8 bytes:
+// header:       magic[8], u32 version, u32 byteOrder, u32 labelType, u32 labelRelation,
+//               u32 withStereo, u32 stereoRelation, u32 isomorphismAlg, u32 padding,
+//               u64 numStrings, u64 numGraphs, u64 numRules, u64 numEdges
+// string table: u64 offsets[numStrings + 1], char data[offsets[numStrings]]
+// graph:        u64 id, u64 invariantHash, u32 name, u32 stereoGML, u32 numVertices, u32 numEdges,
+//               u32 vertexLabels[numVertices], u32 edges[3 * numEdges] as (source, target, label)
+// rules:        u32 names[numRules]
+// edge:         u64 id, u32 numRules, u32 numSources, u32 numTargets,
+//               u32 rules[numRules], u32 sources[numSources], u32 targets[numTargets]
+// Ids are the hyper vertex ids, and the graphs and edges are recreated in order of increasing id.
+// Strings are referenced by index in the string table, rules by index in the rule list,
+// and graphs by index in the graph list.
+// Graphs with explicit stereo information are stored as GML in the string table with no vertices or edges.
+// The invariant hashes are boost::hash_combine values, which differ between Boost versions and platforms,
+// so they are only informational, and the hashes are recomputed from the graphs when loading.
+//
+// A checkpoint has its own magic, and additionally stores the graphs which are only in the graph database,
+// with the id noVertex after all other graphs. After the edges follows
+// products:     u64 numProducts, u32 products[numProducts], in the order they were given product status
+// repeat:       u64 numRepeats, and for each, u64 repeatId, u64 numIterations, u32 finished,
+//               u32 numUniverse, u32 numSubset, u32 padding, u32 universe[numUniverse], u32 subset[numSubset]
+
+constexpr char magic[8] = {'M', 'O', 'D', 'D', 'G', 'B', 'I', 'N'};
+constexpr char checkpointMagic[8] = {'M', 'O', 'D', 'D', 'G', 'C', 'K', 'P'};
+constexpr std::uint32_t version = 1;
+constexpr std::uint32_t byteOrder = 0x01020304;
+constexpr std::uint32_t noString = std::numeric_limits<std::uint32_t>::max();
+constexpr std::uint64_t noVertex = Checkpoint::noVertex;
+
+struct Writer {
+
+	explicit Writer(std::ostream &s) : s(s) { }
+
+	template<typename T>
+	void put(T value) {
+		static_assert(std::is_integral<T>::value, "Only integers are written.");
+		s.write(reinterpret_cast<const char*> (&value), sizeof(T));
+		pos += sizeof(T);
+	}
+
+	template<typename T>
+	void put(const std::vector<T> &values) {
+		static_assert(std::is_integral<T>::value, "Only integers are written.");
+		s.write(reinterpret_cast<const char*> (values.data()), values.size() * sizeof(T));
+		pos += values.size() * sizeof(T);
+	}
+
+	void put(const std::string &str) {
+		s.write(str.data(), str.size());
+		pos += str.size();
+	}
+
+	void align() {
+		while(pos % 8 != 0) put<char>(0);
+	}
+private:
+	std::ostream &s;
+	std::size_t pos = 0;
+};
+
+struct Reader {
+
+	Reader(const char *data, std::size_t size) : data(data), size(size) { }
+
+	template<typename T>
+	bool get(T &value) {
+		if(size - pos < sizeof(T)) return false;
+		std::memcpy(&value, data + pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+
+	template<typename T>
+	bool get(std::vector<T> &values, std::size_t n) {
+		if((size - pos) / sizeof(T) < n) return false;
+		values.resize(n);
+		std::memcpy(values.data(), data + pos, n * sizeof(T));
+		pos += n * sizeof(T);
+		return true;
+	}
+
+	bool get(std::string &str, std::size_t n) {
+		if(size - pos < n) return false;
+		str.assign(data + pos, n);
+		pos += n;
+		return true;
+	}
+
+	bool align() {
+		const std::size_t padding = (8 - pos % 8) % 8;
+		if(size - pos < padding) return false;
+		pos += padding;
+		return true;
+	}
+private:
+	const char *data;
+	const std::size_t size;
+	std::size_t pos = 0;
+};
+
+bool truncated(std::ostream &err) {
+	err << "Parsed data is corrupt, the binary DG dump is truncated." << std::endl;
+	return false;
+}
+
+#define MOD_DUMP_READ(...) if(!reader.get(__VA_ARGS__)) return truncated(err)
+#define MOD_DUMP_ALIGN() if(!reader.align()) return truncated(err)
+
+std::string stereoGML(const lib::Graph::Single &gLib) {
+	const auto &lg = gLib.getLabelledGraph();
+	const auto &g = get_graph(lg);
+	const auto &pString = get_string(lg);
+	const auto &pStereo = get_stereo(lg);
+	std::ostringstream s;
+	s << "graph [\n";
+	for(const auto v : asRange(vertices(g))) {
+		const auto getNeighbourId = [&](const lib::Stereo::EmbeddingEdge & emb) {
+			return get(boost::vertex_index_t(), g, target(emb.getEdge(v, g), g));
+		};
+		s << "\tnode [ id " << get(boost::vertex_index_t(), g, v) << " label \"" << pString[v] << "\""
+				<< " stereo \"" << pStereo[v]->asRawString(getNeighbourId) << "\" ]\n";
+	}
+	for(const auto e : asRange(edges(g))) {
+		s << "\tedge [ source " << get(boost::vertex_index_t(), g, source(e, g))
+				<< " target " << get(boost::vertex_index_t(), g, target(e, g))
+				<< " label \"" << pString[e] << "\"";
+		if(pStereo[e] == lib::Stereo::EdgeCategory::Any) s << " stereo \"*\"";
+		s << " ]\n";
+	}
+	s << "]\n";
+	return s.str();
+}
+
+// The data to write, collected from a DG.
+
+struct Content {
+
+	struct GraphData {
+		std::uint64_t id, invariantHash;
+		std::uint32_t name, stereo;
+		std::vector<std::uint32_t> vLabels, eData;
+	};
+
+	struct EdgeData {
+		std::uint64_t id;
+		std::vector<std::uint32_t> rules, sources, targets;
+	};
+public:
+
+	Content(const NonHyper &dgNonHyper, bool withDatabase) : labelSettings(dgNonHyper.getLabelSettings()) {
+		using VertexKind = lib::DG::HyperVertexKind;
+		// the const version is also available during calculation
+		const lib::DG::HyperGraphType &dg = dgNonHyper.getHyper().getGraph();
+		std::set<const lib::Rules::Real*, lib::Rules::LessById> rules;
+		for(const auto v : asRange(vertices(dg))) {
+			if(dg[v].kind == VertexKind::Edge) {
+				for(const auto *r : dg[v].rules) rules.insert(r);
+			} else {
+				assert(dg[v].graph);
+				addGraph(*dg[v].graph, get(boost::vertex_index_t(), dg, v));
+			}
+		}
+		if(withDatabase) {
+			for(const auto &g : dgNonHyper.getGraphDatabase()) {
+				if(graphIndex.find(&g->getGraph()) == end(graphIndex)) addGraph(g->getGraph(), noVertex);
+			}
+		}
+		std::unordered_map<const lib::Rules::Real*, std::uint32_t> ruleIndex;
+		for(const auto *r : rules) {
+			ruleIndex[r] = ruleNames.size();
+			ruleNames.push_back(intern(r->getName()));
+		}
+		for(const auto v : asRange(vertices(dg))) {
+			if(dg[v].kind != VertexKind::Edge) continue;
+			EdgeData e{get(boost::vertex_index_t(), dg, v),
+				{},
+				{},
+				{}};
+			for(const auto *r : dg[v].rules) e.rules.push_back(ruleIndex[r]);
+			for(const auto eIn : asRange(in_edges(v, dg))) e.sources.push_back(graphIndex[dg[source(eIn, dg)].graph]);
+			for(const auto eOut : asRange(out_edges(v, dg))) e.targets.push_back(graphIndex[dg[target(eOut, dg)].graph]);
+			std::sort(begin(e.sources), end(e.sources));
+			std::sort(begin(e.targets), end(e.targets));
+			derivations.push_back(std::move(e));
+		}
+	}
+
+	void write(Writer &w, const char *magic) const {
+		w.put(std::string(magic, sizeof(Binary::magic)));
+		w.put(version);
+		w.put(byteOrder);
+		w.put(static_cast<std::uint32_t> (labelSettings.type));
+		w.put(static_cast<std::uint32_t> (labelSettings.relation));
+		w.put(static_cast<std::uint32_t> (labelSettings.withStereo));
+		w.put(static_cast<std::uint32_t> (labelSettings.stereoRelation));
+		w.put(static_cast<std::uint32_t> (getConfig().graph.isomorphismAlg.get()));
+		w.put(std::uint32_t(0));
+		w.put(std::uint64_t(strings.size()));
+		w.put(std::uint64_t(graphs.size()));
+		w.put(std::uint64_t(ruleNames.size()));
+		w.put(std::uint64_t(derivations.size()));
+
+		std::vector<std::uint64_t> offsets(1, 0);
+		for(const auto &str : strings) offsets.push_back(offsets.back() + str.size());
+		w.put(offsets);
+		for(const auto &str : strings) w.put(str);
+		w.align();
+
+		for(const auto &g : graphs) {
+			w.put(g.id);
+			w.put(g.invariantHash);
+			w.put(g.name);
+			w.put(g.stereo);
+			w.put(std::uint32_t(g.vLabels.size()));
+			w.put(std::uint32_t(g.eData.size() / 3));
+			w.put(g.vLabels);
+			w.put(g.eData);
+			w.align();
+		}
+
+		w.put(ruleNames);
+		w.align();
+
+		for(const auto &e : derivations) {
+			w.put(e.id);
+			w.put(std::uint32_t(e.rules.size()));
+			w.put(std::uint32_t(e.sources.size()));
+			w.put(std::uint32_t(e.targets.size()));
+			w.put(e.rules);
+			w.put(e.sources);
+			w.put(e.targets);
+			w.align();
+		}
+	}
+private:
+
+	std::uint32_t intern(const std::string &str) {
+		const auto iter = stringIds.find(str);
+		if(iter != end(stringIds)) return iter->second;
+		const std::uint32_t id = strings.size();
+		if(id == noString) throw mod::LogicError("Too many strings for a binary DG dump.");
+		strings.push_back(str);
+		stringIds.emplace(str, id);
+		return id;
+	}
+
+	void addGraph(const lib::Graph::Single &gLib, std::uint64_t id) {
+		const auto &lg = gLib.getLabelledGraph();
+		GraphData gData{id, gLib.getInvariantHash(labelSettings.type), intern(gLib.getName()), noString,
+			{},
+			{}};
+		if(has_stereo(lg)) {
+			gData.stereo = intern(stereoGML(gLib));
+		} else {
+			const auto &g = get_graph(lg);
+			const auto &pString = get_string(lg);
+			for(const auto v : asRange(vertices(g))) gData.vLabels.push_back(intern(pString[v]));
+			for(const auto e : asRange(edges(g))) {
+				gData.eData.push_back(get(boost::vertex_index_t(), g, source(e, g)));
+				gData.eData.push_back(get(boost::vertex_index_t(), g, target(e, g)));
+				gData.eData.push_back(intern(pString[e]));
+			}
+		}
+		graphIndex[&gLib] = graphs.size();
+		graphs.push_back(std::move(gData));
+	}
+public:
+	const LabelSettings labelSettings;
+	std::vector<std::string> strings;
+	std::unordered_map<std::string, std::uint32_t> stringIds;
+	std::vector<GraphData> graphs;
+	std::unordered_map<const lib::Graph::Single*, std::uint32_t> graphIndex;
+	std::vector<std::uint32_t> ruleNames;
+	std::vector<EdgeData> derivations;
+};
+
+// The data read, before it is given to a DG.
+
+struct Parsed {
+
+	struct GraphRecord {
+		std::uint64_t id;
+		std::uint32_t name;
+		std::unique_ptr<lib::Graph::Single> g;
+	};
+
+	struct EdgeRecord {
+		std::uint64_t id;
+		std::vector<std::uint32_t> rules, sources, targets;
+	};
+public:
+	LabelSettings labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	std::vector<std::string> strings;
+	std::vector<GraphRecord> graphs;
+	std::vector<std::uint32_t> ruleNames;
+	std::vector<EdgeRecord> edges;
+};
+
+// The stored invariant hashes are used unless validating.
+
+bool read(Reader &reader, const char *magic, Parsed &content, std::ostream &err, bool validate) {
+	char fileMagic[sizeof(Binary::magic)];
+	for(char &c : fileMagic) MOD_DUMP_READ(c);
+	if(!std::equal(fileMagic, fileMagic + sizeof(fileMagic), magic)) {
+		err << "Not a binary DG " << (magic == checkpointMagic ? "checkpoint" : "dump") << "." << std::endl;
+		return false;
+	}
+	std::uint32_t fileVersion, fileByteOrder, labelType, labelRelation, withStereo, stereoRelation, isomorphismAlg, padding;
+	MOD_DUMP_READ(fileVersion);
+	MOD_DUMP_READ(fileByteOrder);
+	if(fileVersion != version) {
+		err << "Unsupported binary DG dump version, " << fileVersion << ", expected " << version << "." << std::endl;
+		return false;
+	}
+	if(fileByteOrder != byteOrder) {
+		err << "The binary DG dump was written on a machine with a different byte order." << std::endl;
+		return false;
+	}
+	MOD_DUMP_READ(labelType);
+	MOD_DUMP_READ(labelRelation);
+	MOD_DUMP_READ(withStereo);
+	MOD_DUMP_READ(stereoRelation);
+	MOD_DUMP_READ(isomorphismAlg);
+	MOD_DUMP_READ(padding);
+	if(labelType > static_cast<std::uint32_t> (LabelType::Term)
+			|| labelRelation > static_cast<std::uint32_t> (LabelRelation::Unification)
+			|| stereoRelation > static_cast<std::uint32_t> (LabelRelation::Unification)) {
+		err << "Parsed data is corrupt, invalid label settings." << std::endl;
+		return false;
+	}
+	content.labelSettings = LabelSettings{static_cast<LabelType> (labelType), static_cast<LabelRelation> (labelRelation),
+		withStereo != 0, static_cast<LabelRelation> (stereoRelation)};
+	std::uint64_t numStrings, numGraphs, numRules, numEdges;
+	MOD_DUMP_READ(numStrings);
+	MOD_DUMP_READ(numGraphs);
+	MOD_DUMP_READ(numRules);
+	MOD_DUMP_READ(numEdges);
+	if(numStrings >= noString) {
+		err << "Parsed data is corrupt, too many strings." << std::endl;
+		return false;
+	}
+
+	// strings
+	std::vector<std::uint64_t> offsets;
+	std::string stringData;
+	MOD_DUMP_READ(offsets, numStrings + 1);
+	MOD_DUMP_READ(stringData, offsets.back());
+	MOD_DUMP_ALIGN();
+	auto &strings = content.strings;
+	strings.reserve(numStrings);
+	for(std::size_t i = 0; i < numStrings; i++) {
+		if(offsets[i] > offsets[i + 1] || offsets[i + 1] > stringData.size()) {
+			err << "Parsed data is corrupt, invalid offset for string " << i << "." << std::endl;
+			return false;
+		}
+		strings.push_back(stringData.substr(offsets[i], offsets[i + 1] - offsets[i]));
+	}
+	const auto checkString = [&](std::uint32_t s, const char *what, std::size_t i) {
+		if(s < numStrings) return true;
+		err << "Parsed data is corrupt, string id, " << s << ", out of range for " << what << " " << i << "." << std::endl;
+		return false;
+	};
+
+	// graphs, the count is not used for reserving memory as it is not trusted until all of them have been read
+	std::uint64_t prevId = 0;
+	for(std::size_t i = 0; i < numGraphs; i++) {
+		std::uint64_t id, invariantHash;
+		std::uint32_t name, stereo, numVertices, numGraphEdges;
+		std::vector<std::uint32_t> vLabels, eData;
+		MOD_DUMP_READ(id);
+		MOD_DUMP_READ(invariantHash);
+		MOD_DUMP_READ(name);
+		MOD_DUMP_READ(stereo);
+		MOD_DUMP_READ(numVertices);
+		MOD_DUMP_READ(numGraphEdges);
+		MOD_DUMP_READ(vLabels, numVertices);
+		MOD_DUMP_READ(eData, 3 * std::size_t(numGraphEdges));
+		MOD_DUMP_ALIGN();
+		// only the graphs without a vertex may share the id
+		if(i != 0 && (id < prevId || (id == prevId && id != noVertex))) {
+			err << "Parsed data is corrupt, graph ids are not increasing at graph " << i << "." << std::endl;
+			return false;
+		}
+		prevId = id;
+		if(!checkString(name, "graph", i)) return false;
+		std::unique_ptr<lib::Graph::GraphType> gBoost;
+		std::unique_ptr<lib::Graph::PropString> pString;
+		std::unique_ptr<lib::Graph::PropStereo> pStereo;
+		if(stereo != noString) {
+			if(!checkString(stereo, "graph", i)) return false;
+			std::istringstream ss(strings[stereo]);
+			auto gData = IO::Graph::Read::gml(ss, err);
+			if(!gData.g) {
+				err << "Stereo GML could not be parsed for graph " << i << "." << std::endl;
+				return false;
+			}
+			gBoost = std::move(gData.g);
+			pString = std::move(gData.pString);
+			pStereo = std::move(gData.pStereo);
+		} else {
+			gBoost = std::make_unique<lib::Graph::GraphType>();
+			pString = std::make_unique<lib::Graph::PropString>(*gBoost);
+			for(const auto label : vLabels) {
+				if(!checkString(label, "graph", i)) return false;
+				const auto v = add_vertex(*gBoost);
+				pString->addVertex(v, strings[label]);
+			}
+			for(std::size_t eId = 0; eId < numGraphEdges; eId++) {
+				const auto src = eData[3 * eId], tar = eData[3 * eId + 1], label = eData[3 * eId + 2];
+				if(!checkString(label, "graph", i)) return false;
+				if(src >= numVertices || tar >= numVertices || src == tar) {
+					err << "Parsed data is corrupt, invalid edge (" << src << ", " << tar << ") in graph " << i << "." << std::endl;
+					return false;
+				}
+				const auto vSrc = vertex(src, *gBoost), vTar = vertex(tar, *gBoost);
+				if(edge(vSrc, vTar, *gBoost).second) {
+					err << "Parsed data is corrupt, duplicate edge (" << src << ", " << tar << ") in graph " << i << "." << std::endl;
+					return false;
+				}
+				const auto e = add_edge(vSrc, vTar, *gBoost).first;
+				pString->addEdge(e, strings[label]);
+			}
+		}
+		// lib::Graph::Single aborts on disconnected graphs
+		std::vector<std::size_t> cMap(num_vertices(*gBoost));
+		if(boost::connected_components(*gBoost, cMap.data()) > 1) {
+			err << "Parsed data is corrupt, graph " << i << " is not connected." << std::endl;
+			return false;
+		}
+		auto gLib = std::make_unique<lib::Graph::Single>(std::move(gBoost), std::move(pString), std::move(pStereo));
+		content.graphs.push_back(Parsed::GraphRecord{id, name, std::move(gLib)});
+	}
+
+	// rules
+	MOD_DUMP_READ(content.ruleNames, numRules);
+	MOD_DUMP_ALIGN();
+	for(std::size_t i = 0; i < numRules; i++) {
+		if(!checkString(content.ruleNames[i], "rule", i)) return false;
+	}
+
+	// edges
+	std::size_t iVertices = 0;
+	for(std::size_t i = 0; i < numEdges; i++) {
+		Parsed::EdgeRecord e;
+		std::uint32_t numEdgeRules, numSources, numTargets;
+		MOD_DUMP_READ(e.id);
+		MOD_DUMP_READ(numEdgeRules);
+		MOD_DUMP_READ(numSources);
+		MOD_DUMP_READ(numTargets);
+		MOD_DUMP_READ(e.rules, numEdgeRules);
+		MOD_DUMP_READ(e.sources, numSources);
+		MOD_DUMP_READ(e.targets, numTargets);
+		MOD_DUMP_ALIGN();
+		if(numSources == 0 || numTargets == 0) {
+			err << "Parsed data is corrupt, edge " << i << " has an empty side." << std::endl;
+			return false;
+		}
+		if(e.id == noVertex || (i != 0 && e.id <= content.edges.back().id)) {
+			err << "Parsed data is corrupt, edge ids are not increasing at edge " << i << "." << std::endl;
+			return false;
+		}
+		// the graphs of the edge must have been created before it
+		while(iVertices < content.graphs.size() && content.graphs[iVertices].id < e.id) iVertices++;
+		if(iVertices < content.graphs.size() && content.graphs[iVertices].id == e.id) {
+			err << "Parsed data is corrupt, id " << e.id << " is duplicated." << std::endl;
+			return false;
+		}
+		for(const auto rId : e.rules) {
+			if(rId >= numRules) {
+				err << "Parsed data is corrupt, rule, " << rId << ", out of range [0, " << numRules << "[ for edge " << i << "." << std::endl;
+				return false;
+			}
+		}
+		for(const auto &side : {&e.sources, &e.targets}) {
+			for(const auto vId : *side) {
+				if(vId >= iVertices) {
+					err << "Parsed data is corrupt, adjacency, " << vId << ", is not a valid graph for edge " << i << "." << std::endl;
+					return false;
+				}
+			}
+		}
+		content.edges.push_back(std::move(e));
+	}
+	return true;
+}
+
+// The products and repeat states following the DG in a checkpoint.
+
+bool readCheckpointTail(Reader &reader, Checkpoint &checkpoint, std::ostream &err) {
+	const auto checkGraphs = [&](const std::vector<std::uint32_t> &indices, const char *what) {
+		for(const auto i : indices) {
+			if(i < checkpoint.graphs.size()) continue;
+			err << "Parsed data is corrupt, graph index, " << i << ", out of range for " << what << "." << std::endl;
+			return false;
+		}
+		return true;
+	};
+	std::uint64_t numProducts, numRepeats;
+	MOD_DUMP_READ(numProducts);
+	MOD_DUMP_READ(checkpoint.products, numProducts);
+	MOD_DUMP_ALIGN();
+	if(!checkGraphs(checkpoint.products, "the products")) return false;
+	MOD_DUMP_READ(numRepeats);
+	for(std::size_t i = 0; i < numRepeats; i++) {
+		Checkpoint::Repeat r;
+		std::uint64_t repeatId, numIterations;
+		std::uint32_t finished, numUniverse, numSubset, padding;
+		MOD_DUMP_READ(repeatId);
+		MOD_DUMP_READ(numIterations);
+		MOD_DUMP_READ(finished);
+		MOD_DUMP_READ(numUniverse);
+		MOD_DUMP_READ(numSubset);
+		MOD_DUMP_READ(padding);
+		MOD_DUMP_READ(r.universe, numUniverse);
+		MOD_DUMP_READ(r.subset, numSubset);
+		MOD_DUMP_ALIGN();
+		r.repeatId = repeatId;
+		r.numIterations = numIterations;
+		r.finished = finished != 0;
+		if(!checkGraphs(r.universe, "a repeat universe")) return false;
+		if(!checkGraphs(r.subset, "a repeat subset")) return false;
+		checkpoint.repeats.push_back(std::move(r));
+	}
+	return true;
+}
+
+struct ConstructionData {
+	const std::vector<std::shared_ptr<graph::Graph> > &graphs;
+	const std::vector<std::shared_ptr<rule::Rule> > &rules;
+	const bool validate;
+	Parsed content;
+};
+
+struct NonHyperDump : public NonHyper {
+
+	NonHyperDump(ConstructionData &&constructionData)
+	: NonHyper(constructionData.graphs, constructionData.content.labelSettings), constructionData(&constructionData) {
+		calculate();
+	}
+private:
+
+	std::string getType() const {
+		return "DGDump";
+	}
+
+	void calculateImpl() {
+		const auto &strings = constructionData->content.strings;
+		auto &vertices = constructionData->content.graphs;
+		const auto &edges = constructionData->content.edges;
+		const auto labelSettings = getLabelSettings();
+
+		const auto rulesByName = makeRulesByName(constructionData->rules);
+		std::vector<const lib::Rules::Real*> ruleMap;
+		for(const auto name : constructionData->content.ruleNames) {
+			const auto iter = rulesByName.find(strings[name]);
+			assert(iter != end(rulesByName)); // checked while loading
+			std::shared_ptr<rule::Rule> r = iter->second;
+			IO::log() << "Rule linked: " << r->getName() << std::endl;
+			this->rules.push_back(r);
+			ruleMap.push_back(&r->getRule());
+		}
+
+		// only the given graphs can be isomorphic to graphs in a trusted dump
+		std::unordered_map<std::size_t, std::vector<std::shared_ptr<graph::Graph> > > givenByHash;
+		if(!constructionData->validate) {
+			for(const auto &g : constructionData->graphs)
+				givenByHash[g->getGraph().getInvariantHash(labelSettings.type)].push_back(g);
+		}
+		const auto isoSettings = LabelSettings{labelSettings.type, LabelRelation::Isomorphism, labelSettings.withStereo, LabelRelation::Isomorphism};
+		const auto findGiven = [&](const lib::Graph::Single &gCand) -> std::shared_ptr<graph::Graph> {
+			const auto iter = givenByHash.find(gCand.getInvariantHash(labelSettings.type));
+			if(iter == end(givenByHash)) return nullptr;
+			for(const auto &g : iter->second) {
+				if(1 == lib::Graph::Single::isomorphism(gCand, g->getGraph(), 1, isoSettings)) return g;
+			}
+			return nullptr;
+		};
+
+		// do merge of vertices and edges in order of increasing id
+		std::vector<std::shared_ptr<graph::Graph> > graphMap;
+		graphMap.reserve(vertices.size());
+		std::size_t iVertices = 0, iEdges = 0;
+		while(iVertices < vertices.size() || iEdges < edges.size()) {
+			if(iEdges == edges.size() || (iVertices < vertices.size() && vertices[iVertices].id < edges[iEdges].id)) {
+				auto &v = vertices[iVertices];
+				std::shared_ptr<graph::Graph> g;
+				bool linked;
+				if(constructionData->validate) {
+					auto p = checkIfNew(std::move(v.g));
+					g = p.first;
+					linked = !p.second;
+				} else {
+					g = findGiven(*v.g);
+					linked = bool(g);
+					if(!linked) g = graph::Graph::makeGraph(std::move(v.g));
+				}
+				bool wasNew = addGraphAsVertex(g);
+				graphMap.push_back(g);
+				if(linked) IO::log() << "Graph linked: " << strings[v.name] << " -> " << g->getName() << std::endl;
+				if(wasNew) giveProductStatus(g);
+				iVertices++;
+			} else {
+				const auto &e = edges[iEdges];
+				std::vector<const lib::Graph::Single*> srcGraphs, tarGraphs;
+				for(const auto vId : e.sources) srcGraphs.push_back(&graphMap[vId]->getGraph());
+				for(const auto vId : e.targets) tarGraphs.push_back(&graphMap[vId]->getGraph());
+				GraphMultiset gmsSrc(std::move(srcGraphs)), gmsTar(std::move(tarGraphs));
+				suggestDerivation(gmsSrc, gmsTar, nullptr);
+				for(const auto rId : e.rules) suggestDerivation(gmsSrc, gmsTar, ruleMap[rId]);
+				iEdges++;
+			}
+		}
+		constructionData = nullptr;
+	}
+
+	void listImpl(std::ostream &s) const { }
+private:
+	std::vector<std::shared_ptr<rule::Rule> > rules;
+	ConstructionData *constructionData;
+};
+
+#undef MOD_DUMP_READ
+#undef MOD_DUMP_ALIGN
+
+} // namespace Binary
+} // namespace
+
+bool isBinary(std::istream &s) {
+	char buf[sizeof(Binary::magic)];
+	const auto start = s.tellg();
+	s.read(buf, sizeof(buf));
+	const bool res = s.gcount() == sizeof(buf) && std::equal(buf, buf + sizeof(buf), Binary::magic);
+	s.clear();
+	s.seekg(start);
+	return res;
+}
+
+NonHyper *loadBinary(const std::vector<std::shared_ptr<graph::Graph> > &graphs, const std::vector<std::shared_ptr<rule::Rule> > &rules, const char *data, std::size_t size, std::ostream &err, bool validate) {
+	Binary::Reader reader(data, size);
+	Binary::ConstructionData cData{graphs, rules, validate,
+		{}};
+	if(!Binary::read(reader, Binary::magic, cData.content, err, validate)) return nullptr;
+	if(!cData.content.graphs.empty() && cData.content.graphs.back().id == Binary::noVertex) {
+		err << "Parsed data is corrupt, graph " << (cData.content.graphs.size() - 1) << " is not a vertex." << std::endl;
+		return nullptr;
+	}
+	const auto rulesByName = makeRulesByName(rules);
+	for(const auto name : cData.content.ruleNames) {
+		const auto &str = cData.content.strings[name];
+		if(rulesByName.find(str) == end(rulesByName)) {
+			err << "Rule '" << str << "' in the DG dump has not been given." << std::endl;
+			return nullptr;
+		}
+	}
+	return new Binary::NonHyperDump(std::move(cData));
+}
+
+void writeBinary(const NonHyper &dg, std::ostream &s) {
+	Binary::Writer w(s);
+	Binary::Content(dg, false).write(w, Binary::magic);
+}
+
+void writeCheckpoint(const NonHyper &dg, const std::vector<RepeatState> &repeats, std::ostream &s) {
+	const Binary::Content content(dg, true);
+	Binary::Writer w(s);
+	content.write(w, Binary::checkpointMagic);
+	std::vector<std::uint32_t> products;
+	for(const auto &g : dg.getProducts()) products.push_back(content.graphIndex.at(&g->getGraph()));
+	w.put(std::uint64_t(products.size()));
+	w.put(products);
+	w.align();
+	w.put(std::uint64_t(repeats.size()));
+	for(const auto &r : repeats) {
+		std::vector<std::uint32_t> universe, subset;
+		for(const auto *g : r.universe) universe.push_back(content.graphIndex.at(g));
+		for(const auto *g : r.subset) subset.push_back(content.graphIndex.at(g));
+		w.put(std::uint64_t(r.repeatId));
+		w.put(std::uint64_t(r.numIterations));
+		w.put(std::uint32_t(r.finished));
+		w.put(std::uint32_t(universe.size()));
+		w.put(std::uint32_t(subset.size()));
+		w.put(std::uint32_t(0));
+		w.put(universe);
+		w.put(subset);
+		w.align();
+	}
+}
+
+std::unique_ptr<Checkpoint> loadCheckpoint(const char *data, std::size_t size, std::ostream &err) {
+	Binary::Reader reader(data, size);
+	Binary::Parsed content;
+	if(!Binary::read(reader, Binary::checkpointMagic, content, err, false)) return nullptr;
+	auto res = std::make_unique<Checkpoint>(content.labelSettings);
+	for(auto &g : content.graphs)
+		res->graphs.push_back(Checkpoint::GraphEntry{g.id, content.strings[g.name], std::move(g.g)});
+	for(auto &e : content.edges) {
+		res->derivations.push_back(Checkpoint::Derivation{e.id,
+			{}, std::move(e.sources), std::move(e.targets)});
+		for(const auto rId : e.rules) res->derivations.back().rules.push_back(content.strings[content.ruleNames[rId]]);
+	}
+	if(!Binary::readCheckpointTail(reader, *res, err)) return nullptr;
+	return res;
+}
+
 } // namespace Dump
 } // namespace DG
 } // namespace lib
@@ -1,15 +1,22 @@
 #ifndef MOD_LIB_DG_DUMP_H
 #define MOD_LIB_DG_DUMP_H
 
+#include <mod/Config.h>
 #include <mod/graph/ForwardDecl.h>
 #include <mod/rule/ForwardDecl.h>
 
+#include <cstdint>
 #include <iosfwd>
+#include <limits>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace mod {
 namespace lib {
+namespace Graph {
+struct Single;
+} // namespace Graph
 namespace DG {
 class NonHyper;
 namespace Dump {
@@ -17,6 +24,64 @@ namespace Dump {
 NonHyper *load(const std::vector<std::shared_ptr<graph::Graph> > &graphs, const std::vector<std::shared_ptr<rule::Rule> > &rules, std::istream &s, std::ostream &err);
 void write(const NonHyper &dg, std::ostream &s);
 
+// The binary format stores a string table, the vertex labels and edge list of each graph as arrays of string ids,
+// and the invariant hash of each graph, which is only informational as it is not stable across builds.
+// All sections are 8-byte aligned and position independent.
+// loadBinary reads the fields from the given buffer and builds the graphs from them,
+// so the buffer is not referenced after it returns.
+// Without validation the graphs in the dump are trusted to be pairwise non-isomorphic,
+// and only the given graphs with the same invariant hash, recomputed when loading, are checked for isomorphism.
+// With validation every graph is checked against the complete graph database, as for the text format.
+
+// true iff the stream starts with the binary magic, the stream position is restored
+bool isBinary(std::istream &s);
+NonHyper *loadBinary(const std::vector<std::shared_ptr<graph::Graph> > &graphs, const std::vector<std::shared_ptr<rule::Rule> > &rules, const char *data, std::size_t size, std::ostream &err, bool validate);
+void writeBinary(const NonHyper &dg, std::ostream &s);
+
+// A checkpoint is a binary dump of a DG during calculation, which additionally contains the complete graph database,
+// the order of the products, and the state of the Repeat strategies, such that the calculation can be resumed.
+
+struct RepeatState {
+	std::size_t repeatId, numIterations;
+	bool finished;
+	// the input for the next iteration, or the output if finished
+	std::vector<const lib::Graph::Single*> universe, subset;
+};
+
+struct Checkpoint {
+	static constexpr std::uint64_t noVertex = std::numeric_limits<std::uint64_t>::max();
+
+	struct GraphEntry {
+		std::uint64_t id; // the hyper vertex id, or noVertex if the graph is only in the graph database
+		std::string name;
+		std::unique_ptr<lib::Graph::Single> g;
+	};
+
+	struct Derivation {
+		std::uint64_t id; // the hyper vertex id
+		std::vector<std::string> rules;
+		std::vector<std::uint32_t> sources, targets; // indices into graphs
+	};
+
+	struct Repeat {
+		std::size_t repeatId, numIterations;
+		bool finished;
+		std::vector<std::uint32_t> universe, subset; // indices into graphs
+	};
+public:
+
+	explicit Checkpoint(LabelSettings labelSettings) : labelSettings(labelSettings) { }
+public:
+	LabelSettings labelSettings;
+	std::vector<GraphEntry> graphs; // in order of increasing id
+	std::vector<Derivation> derivations; // in order of increasing id
+	std::vector<std::uint32_t> products; // in the order they were given product status
+	std::vector<Repeat> repeats;
+};
+
+void writeCheckpoint(const NonHyper &dg, const std::vector<RepeatState> &repeats, std::ostream &s);
+std::unique_ptr<Checkpoint> loadCheckpoint(const char *data, std::size_t size, std::ostream &err);
+
 } // namespace Dump
 } // namespace DG
 } // namespace lib
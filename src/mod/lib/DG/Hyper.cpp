@@ -54,6 +54,8 @@ void HyperCreator::addEdge(NonHyper::Edge eNon) {
 	hyper[v].outVertex = vTarNon;
 	hyper[v].reverse = hyper.null_vertex();
 	pimpl->edgeToHyper[eNon] = v;
+	owner.nonHyperEdgeToHyperVertex[std::make_pair(vSrcNon, vTarNon)] = v;
+	++owner.numEdges;
 
 	{ // source edges
 		for(const lib::Graph::Single *g : dg[vSrcNon].graphs) {
@@ -174,12 +176,13 @@ void Hyper::addVertex(const lib::Graph::Single *g) {
 		assert(iter != nonHyper.getGraphDatabase().end());
 #endif
 	}
-	std::map<const lib::Graph::Single*, Vertex>::iterator idIter = graphToHyperVertex.find(g);
+	const auto idIter = graphToHyperVertex.find(g);
 	if(idIter == graphToHyperVertex.end()) { // create the vertex
 		Vertex vNew = add_vertex(hyper);
 		hyper[vNew].kind = VertexKind::Vertex;
 		hyper[vNew].graph = g;
 		graphToHyperVertex[g] = vNew;
+		++numVertices;
 	}
 }
 
@@ -196,7 +199,7 @@ const Hyper::GraphType &Hyper::getGraph() const {
 void Hyper::printStats(std::ostream &s) const {
 	// statistics stuff
 	unsigned int numVerts = 0, numIn = 0, numOut = 0, numReverse = 0;
-	unsigned int numEdges = 0, numEdgePairs = 0;
+	unsigned int numHyperEdges = 0, numEdgePairs = 0;
 	std::map<unsigned int, unsigned int> countNumIn, countNumOut;
 	double avgInReverseRatio = 0, avgInReverseRatioWithVirtual = 0;
 	double avgOutReverseRatio = 0, avgOutReverseRatioWithVirtual = 0;
@@ -209,7 +212,7 @@ void Hyper::printStats(std::ostream &s) const {
 
 	for(Vertex v : asRange(vertices(hyper))) {
 		if(hyper[v].kind != VertexKind::Vertex) {
-			numEdges++;
+			numHyperEdges++;
 			if(hyper[v].reverse != hyper.null_vertex()) numEdgePairs++;
 			continue;
 		}
@@ -279,11 +282,11 @@ void Hyper::printStats(std::ostream &s) const {
 	s << "Stat--------------------------------------------------------------" << std::endl;
 	s << "numVerts:\t" << numVerts << std::endl << "numIn:\t\t" << numIn << std::endl
 			<< "numOut:\t\t" << numOut << std::endl << "numReverse:\t" << numReverse << std::endl
-			<< "numEdges:\t" << numEdges << std::endl << "numEdgePairs:\t" << numEdgePairs << std::endl;
+			<< "numEdges:\t" << numHyperEdges << std::endl << "numEdgePairs:\t" << numEdgePairs << std::endl;
 	s << "out/vert:\t" << (numOut / ((double) numVerts)) << std::endl;
 	s << "in/vert:\t" << (numIn / ((double) numVerts)) << std::endl;
 	s << "reverse/vert:\t" << (numReverse / ((double) numVerts)) << std::endl;
-	s << "pairs/edge:\t" << (numEdgePairs / ((double) numEdges)) << std::endl;
+	s << "pairs/edge:\t" << (numEdgePairs / ((double) numHyperEdges)) << std::endl;
 	s << "------------------------------------------------------------------" << std::endl;
 	typedef std::pair<unsigned int, unsigned int> P;
 	s << "numIn histogram:" << std::endl;
@@ -327,6 +330,20 @@ Hyper::Vertex Hyper::getVertexFromGraph(const lib::Graph::Single *g) const {
 	return iter->second;
 }
 
+Hyper::Vertex Hyper::getEdgeOrNullFromNonHyper(NonHyperVertex vSrc, NonHyperVertex vTar) const {
+	const auto iter = nonHyperEdgeToHyperVertex.find(std::make_pair(vSrc, vTar));
+	if(iter == nonHyperEdgeToHyperVertex.end()) return getGraph().null_vertex();
+	else return iter->second;
+}
+
+std::size_t Hyper::getNumVertices() const {
+	return numVertices;
+}
+
+std::size_t Hyper::getNumEdges() const {
+	return numEdges;
+}
+
 dg::DG::Vertex Hyper::getInterfaceVertex(Vertex v) const {
 	if(v == hyper.null_vertex()) return dg::DG::Vertex();
 	assert(hyper[v].kind == VertexKind::Vertex);
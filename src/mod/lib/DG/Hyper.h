@@ -5,6 +5,11 @@
 #include <mod/Derivation.h>
 #include <mod/lib/DG/NonHyper.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <unordered_map>
+#include <utility>
+
 namespace mod {
 template<typename> class Function;
 namespace lib {
@@ -62,6 +67,11 @@ public:
 	Vertex getVertexOrNullFromGraph(const lib::Graph::Single *g) const;
 	// requires: isVertexGraph(g)
 	Vertex getVertexFromGraph(const lib::Graph::Single *g) const;
+	// returns the hyper vertex representing the NonHyper edge (vSrc, vTar), or null_vertex() if there is no such edge
+	Vertex getEdgeOrNullFromNonHyper(NonHyperVertex vSrc, NonHyperVertex vTar) const;
+	// the number of hyper vertices of each kind, i.e., the number of vertices and edges of the hypergraph
+	std::size_t getNumVertices() const;
+	std::size_t getNumEdges() const;
 public:
 	dg::DG::Vertex getInterfaceVertex(Vertex v) const;
 	dg::DG::HyperEdge getInterfaceEdge(Vertex e) const;
@@ -72,7 +82,9 @@ private:
 	const NonHyper &nonHyper;
 	GraphType hyper;
 private:
-	std::map<const lib::Graph::Single*, Vertex> graphToHyperVertex;
+	std::unordered_map<const lib::Graph::Single*, Vertex> graphToHyperVertex;
+	std::unordered_map<std::pair<NonHyperVertex, NonHyperVertex>, Vertex, boost::hash<std::pair<NonHyperVertex, NonHyperVertex> > > nonHyperEdgeToHyperVertex;
+	std::size_t numVertices = 0, numEdges = 0;
 public:
 	static void temp_compare(const Hyper &a, const Hyper &b);
 };
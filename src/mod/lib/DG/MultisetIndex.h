@@ -0,0 +1,71 @@
+#ifndef MOD_LIB_DG_MULTISETINDEX_H
+#define MOD_LIB_DG_MULTISETINDEX_H
+
+#include <mod/lib/DG/GraphDecl.h>
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace DG {
+
+// An index of the vertices of a NonHyper graph by their graph multisets,
+// as an open addressing hash table with linear probing.
+// Only the vertex descriptors are stored, the multisets are those of the vertex properties,
+// and their precomputed hash values are used, which are mixed so their low bits can be used directly.
+// Vertices must not be removed from the graph.
+
+struct MultisetIndex {
+	explicit MultisetIndex(const NonHyperGraphType &dg) : dg(dg) { }
+
+	// returns the vertex with the given multiset, or null_vertex()
+	NonHyperVertex find(const GraphMultiset &gms) const {
+		if(slots.empty()) return nullVertex();
+		const std::size_t mask = slots.size() - 1;
+		for(std::size_t i = gms.getHash() & mask;; i = (i + 1) & mask) {
+			const auto v = slots[i];
+			if(v == nullVertex()) return v;
+			if(dg[v].graphs == gms) return v;
+		}
+	}
+
+	// requires: find(dg[v].graphs) == null_vertex()
+	void insert(NonHyperVertex v) {
+		assert(find(dg[v].graphs) == nullVertex());
+		// keep the load factor at most 1/2
+		if(2 * (numVertices + 1) > slots.size()) grow();
+		insertNoGrow(v);
+		++numVertices;
+	}
+private:
+
+	static NonHyperVertex nullVertex() {
+		return boost::graph_traits<NonHyperGraphType>::null_vertex();
+	}
+
+	void grow() {
+		std::vector<NonHyperVertex> old(std::max<std::size_t>(16, 2 * slots.size()), nullVertex());
+		old.swap(slots);
+		for(const auto v : old)
+			if(v != nullVertex()) insertNoGrow(v);
+	}
+
+	void insertNoGrow(NonHyperVertex v) {
+		const std::size_t mask = slots.size() - 1;
+		std::size_t i = dg[v].graphs.getHash() & mask;
+		while(slots[i] != nullVertex()) i = (i + 1) & mask;
+		slots[i] = v;
+	}
+private:
+	const NonHyperGraphType &dg;
+	std::vector<NonHyperVertex> slots; // the size is 0 or a power of 2
+	std::size_t numVertices = 0;
+};
+
+} // namespace DG
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_DG_MULTISETINDEX_H */
@@ -36,29 +36,25 @@ std::size_t nextDGNum = 0;
 }// namespace 
 
 NonHyper::NonHyper(const std::vector<std::shared_ptr<graph::Graph> > &graphDatabase, LabelSettings labelSettings)
-: id(nextDGNum++), labelSettings(labelSettings), hyperCreator(nullptr), hasCalculated(false),
+: id(nextDGNum++), labelSettings(labelSettings), multisetToVertex(dg), hyperCreator(nullptr), hasCalculated(false),
 productNum(0) {
 	if(getConfig().dg.skipInitialGraphIsomorphismCheck.get()) {
-		for(std::shared_ptr<graph::Graph> gCand : graphDatabase) this->graphDatabase.insert(gCand);
+		for(std::shared_ptr<graph::Graph> gCand : graphDatabase) insertInDatabase(gCand);
 	} else {
-		const auto ls = LabelSettings{this->labelSettings.type, LabelRelation::Isomorphism, this->labelSettings.withStereo, LabelRelation::Isomorphism};
 		for(std::shared_ptr<graph::Graph> gCand : graphDatabase) {
-			for(const auto &g : this->graphDatabase) {
-				if(g == gCand) break;
-				const bool equal = gCand->isomorphism(g, 1, ls);
-				if(equal) {
-					std::string msg = "Isomorphic graphs '" + g->getName() + "' and '" + gCand->getName() + "' in initial graph database.";
-					throw LogicError(std::move(msg));
-				}
+			const auto g = findIsomorphicInDatabase(gCand->getGraph());
+			if(g) {
+				std::string msg = "Isomorphic graphs '" + g->getName() + "' and '" + gCand->getName() + "' in initial graph database.";
+				throw LogicError(std::move(msg));
 			}
-			if(ls.type == LabelType::Term) {
+			if(this->labelSettings.type == LabelType::Term) {
 				const auto &term = get_term(gCand->getGraph().getLabelledGraph());
 				if(!isValid(term)) {
 					std::string msg = "Parsing failed for graph '" + gCand->getName() + "' in graph database. " + term.getParsingError();
 					throw TermParsingError(std::move(msg));
 				}
 			}
-			this->graphDatabase.insert(gCand);
+			insertInDatabase(gCand);
 		}
 	}
 }
@@ -108,7 +104,7 @@ bool NonHyper::getHasCalculated() const {
 
 bool NonHyper::addGraph(std::shared_ptr<graph::Graph> g) {
 	if(getHasCalculated()) std::abort();
-	return graphDatabase.insert(g).second;
+	return insertInDatabase(g);
 }
 
 bool NonHyper::addGraphAsVertex(std::shared_ptr<graph::Graph> g) {
@@ -120,32 +116,24 @@ bool NonHyper::addGraphAsVertex(std::shared_ptr<graph::Graph> g) {
 
 std::pair<std::shared_ptr<graph::Graph>, bool> NonHyper::checkIfNew(std::unique_ptr<lib::Graph::Single> gCand) const {
 	assert(gCand);
-	const auto labelSettings = LabelSettings{this->labelSettings.type, LabelRelation::Isomorphism, this->labelSettings.withStereo, LabelRelation::Isomorphism};
-	for(std::shared_ptr<graph::Graph> g : graphDatabase) {
-		bool isEqual = 1 == lib::Graph::Single::isomorphism(*gCand, g->getGraph(), 1, labelSettings);
-		if(isEqual) {
-			//			if(getConfig().dg.calculateDetailsVerbose.get()) {
-			//				IO::log() << "Discarding product " << gCand->getName() << ", isomorphic to " << g->getName() << std::endl;
-			//				IO::log() << "\tLabelSettings: withStereo=" << std::boolalpha << this->labelSettings.withStereo << std::endl;
-			//				mod::postSection("Discarded");
-			//				mod::lib::IO::Graph::Write::Options opts, optsGraph;
-			//				opts.edgesAsBonds = opts.withIndex = true;
-			//				optsGraph.collapseHydrogens = optsGraph.edgesAsBonds = optsGraph.raiseCharges = true;
-			//				optsGraph.simpleCarbons = optsGraph.withColour = optsGraph.withIndex = true;
-			//				mod::lib::IO::Graph::Write::summary(*gCand, optsGraph, optsGraph);
-			//				std::shared_ptr<graph::Graph> gCandWrapped = graph::Graph::makeGraph(std::move(gCand));
-			//				for(auto v : gCandWrapped->vertices()) {
-			//					if(v.getStringLabel() == "C")
-			//						v.printStereo();
-			//				}
-			//			}
-			return std::make_pair(g, false);
-		}
-	}
-	std::shared_ptr<graph::Graph> g = graph::Graph::makeGraph(std::move(gCand));
+	std::shared_ptr<graph::Graph> g = findIsomorphicInDatabase(*gCand);
+	if(g) return std::make_pair(g, false);
+	g = graph::Graph::makeGraph(std::move(gCand));
 	return std::make_pair(g, true);
 }
 
+std::shared_ptr<graph::Graph> NonHyper::findIsomorphicInDatabase(const lib::Graph::Single &gCand) const {
+	const auto iter = graphDatabaseIndex.find(gCand.getInvariantHash(labelSettings.type));
+	if(iter == end(graphDatabaseIndex)) return nullptr;
+	const auto ls = LabelSettings{labelSettings.type, LabelRelation::Isomorphism, labelSettings.withStereo, LabelRelation::Isomorphism};
+	for(const auto &g : iter->second) {
+		if(&g->getGraph() == &gCand) continue;
+		const bool isEqual = 1 == lib::Graph::Single::isomorphism(gCand, g->getGraph(), 1, ls);
+		if(isEqual) return g;
+	}
+	return nullptr;
+}
+
 void NonHyper::giveProductStatus(std::shared_ptr<graph::Graph> g) {
 	assert(std::find(begin(graphDatabase), end(graphDatabase), g) != end(graphDatabase));
 
@@ -175,11 +163,11 @@ bool NonHyper::addProduct(std::shared_ptr<graph::Graph> g) {
 }
 
 std::pair < NonHyper::Edge, bool> NonHyper::isDerivation(const GraphMultiset &gmsSrc, const GraphMultiset &gmsTar, const lib::Rules::Real *r) const {
-	const auto iterLeft = multisetToVertex.find(gmsSrc);
-	if(iterLeft == end(multisetToVertex)) return std::make_pair(Edge(), false);
-	const auto iterRight = multisetToVertex.find(gmsTar);
-	if(iterRight == end(multisetToVertex)) return std::make_pair(Edge(), false);
-	return edge(iterLeft->second, iterRight->second, dg);
+	const auto vSrc = multisetToVertex.find(gmsSrc);
+	if(vSrc == dg.null_vertex()) return std::make_pair(Edge(), false);
+	const auto vTar = multisetToVertex.find(gmsTar);
+	if(vTar == dg.null_vertex()) return std::make_pair(Edge(), false);
+	return edge(vSrc, vTar, dg);
 }
 
 std::pair<NonHyper::Edge, bool> NonHyper::suggestDerivation(const GraphMultiset &gmsSrc, const GraphMultiset &gmsTar, const lib::Rules::Real *r) {
@@ -209,16 +197,22 @@ const NonHyper::GraphType &NonHyper::getGraphDuringCalculation() const {
 }
 
 NonHyper::Vertex NonHyper::getVertex(const GraphMultiset &gms) {
-	const auto iter = multisetToVertex.find(gms);
-	if(iter != multisetToVertex.end()) return iter->second;
+	const auto vFound = multisetToVertex.find(gms);
+	if(vFound != dg.null_vertex()) return vFound;
 	assert(hyperCreator);
 	Vertex v = add_vertex(dg);
 	dg[v].graphs = gms;
-	multisetToVertex[gms] = v;
+	multisetToVertex.insert(v);
 	for(auto *gSub : gms) hyperCreator->addVertex(gSub);
 	return v;
 }
 
+bool NonHyper::insertInDatabase(std::shared_ptr<graph::Graph> g) {
+	const bool inserted = graphDatabase.insert(g).second;
+	if(inserted) graphDatabaseIndex[g->getGraph().getInvariantHash(labelSettings.type)].push_back(g);
+	return inserted;
+}
+
 void NonHyper::findReversiblePairs() {
 	for(Edge e : asRange(edges(dg))) {
 		Vertex vSource = source(e, dg);
@@ -278,35 +272,23 @@ HyperVertex NonHyper::findHyperEdge(const std::vector<Hyper::Vertex> &sources, c
 	for(const auto v : sources) srcGraphs.push_back(dg[v].graph);
 	for(const auto v : targets) tarGraphs.push_back(dg[v].graph);
 	GraphMultiset gmsSrc(std::move(srcGraphs)), gmsTar(std::move(tarGraphs));
-	const auto iterSrc = multisetToVertex.find(gmsSrc);
-	if(iterSrc == end(multisetToVertex)) return boost::graph_traits<HyperGraphType>::null_vertex();
-	const auto iterTar = multisetToVertex.find(gmsTar);
-	if(iterTar == end(multisetToVertex)) return boost::graph_traits<HyperGraphType>::null_vertex();
-	const auto vSrc = iterSrc->second, vTar = iterTar->second;
-
-	const std::pair<Edge, bool> p = edge(vSrc, vTar, getGraph());
-	if(!p.second) return boost::graph_traits<HyperGraphType>::null_vertex();
-	const HyperGraphType &dgHyper = getHyper().getGraph();
-	for(const auto v : asRange(vertices(dgHyper))) {
-		if(dgHyper[v].kind != HyperVertexKind::Edge) continue;
-		if(dgHyper[v].inVertex == vSrc && dgHyper[v].outVertex == vTar) {
-			return v;
-		}
-	}
-	// the edge must be there by now
-	MOD_ABORT;
+	const auto vSrc = multisetToVertex.find(gmsSrc);
+	if(vSrc == this->dg.null_vertex()) return boost::graph_traits<HyperGraphType>::null_vertex();
+	const auto vTar = multisetToVertex.find(gmsTar);
+	if(vTar == this->dg.null_vertex()) return boost::graph_traits<HyperGraphType>::null_vertex();
+	return getHyper().getEdgeOrNullFromNonHyper(vSrc, vTar);
 }
 
-std::vector<dg::DG::HyperEdge> NonHyper::getAllHyperEdges() const {
-	std::vector<dg::DG::HyperEdge> result;
+const std::vector<dg::DG::HyperEdge> &NonHyper::getAllHyperEdges() const {
 	const HyperGraphType &dgHyper = getHyper().getGraph();
-
-	for(HyperVertex v : asRange(vertices(dgHyper))) {
+	assert(numHyperVerticesScanned <= num_vertices(dgHyper));
+	for(; numHyperVerticesScanned < num_vertices(dgHyper); ++numHyperVerticesScanned) {
+		const HyperVertex v = vertex(numHyperVerticesScanned, dgHyper);
 		if(dgHyper[v].kind != HyperVertexKind::Edge) continue;
-		result.push_back(getHyper().getInterfaceEdge(v));
-		assert(!result.back().isNull());
+		hyperEdges.push_back(getHyper().getInterfaceEdge(v));
+		assert(!hyperEdges.back().isNull());
 	}
-	return result;
+	return hyperEdges;
 }
 
 void NonHyper::diff(const NonHyper &dg1, const NonHyper &dg2) {
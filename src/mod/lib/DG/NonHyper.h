@@ -5,6 +5,7 @@
 #include <mod/dg/DG.h>
 #include <mod/graph/Graph.h>
 #include <mod/lib/DG/GraphDecl.h>
+#include <mod/lib/DG/MultisetIndex.h>
 #include <mod/lib/Graph/GraphDecl.h>
 
 #include <boost/graph/adjacency_list.hpp>
@@ -14,6 +15,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -61,6 +63,9 @@ protected: // calculation
 	// if not found, returns the given wrapped given graph and true
 	// does NOT change the graphDatabse
 	std::pair<std::shared_ptr<graph::Graph>, bool> checkIfNew(std::unique_ptr<lib::Graph::Single> g) const;
+	// searches the database for a graph isomorphic to the given graph, but different from it
+	// returns nullptr if no such graph is found
+	std::shared_ptr<graph::Graph> findIsomorphicInDatabase(const lib::Graph::Single &gCand) const;
 	// gives a graph product status, i.e., rename it, put it in the product list and maybe print a status message
 	void giveProductStatus(std::shared_ptr<graph::Graph> g);
 	// adds the graph to the database if it's not there already
@@ -78,6 +83,9 @@ protected: // calculation
 private: // calculation
 	// adds the graph as a vertex, if it's not there already, and returns the vertex
 	Vertex getVertex(const GraphMultiset &gms);
+	// inserts the graph into the graph database and the isomorphism index
+	// returns true iff it was not in the database already
+	bool insertInDatabase(std::shared_ptr<graph::Graph> g);
 	void findReversiblePairs();
 public: // post calculation
 	void list(std::ostream &s) const;
@@ -88,7 +96,8 @@ public: // post calculation
 	const std::vector<std::shared_ptr<graph::Graph> > &getProducts() const;
 	void print() const;
 	HyperVertex findHyperEdge(const std::vector<HyperVertex> &sources, const std::vector<HyperVertex> &targets) const;
-	std::vector<dg::DG::HyperEdge> getAllHyperEdges() const;
+	// the list is extended with the edges added since the last call
+	const std::vector<dg::DG::HyperEdge> &getAllHyperEdges() const;
 protected:
 	virtual void listImpl(std::ostream &s) const = 0;
 private: // general
@@ -96,10 +105,15 @@ private: // general
 	std::weak_ptr<dg::DG> apiReference;
 	const LabelSettings labelSettings;
 	StdGraphSet graphDatabase;
+	// the graph database bucketed by Single::getInvariantHash, so only graphs in the same bucket need isomorphism checks
+	std::unordered_map<std::size_t, std::vector<std::shared_ptr<graph::Graph> > > graphDatabaseIndex;
 	GraphType dg;
-	std::map<GraphMultiset, Vertex> multisetToVertex;
+	MultisetIndex multisetToVertex;
 	std::unique_ptr<Hyper> hyper;
 	HyperCreator *hyperCreator; // only valid during calculation
+	// hyper vertices are only appended, so we only scan the new ones for edges
+	mutable std::vector<dg::DG::HyperEdge> hyperEdges;
+	mutable std::size_t numHyperVerticesScanned = 0;
 private: // calculation
 	bool hasCalculated;
 	unsigned int productNum;
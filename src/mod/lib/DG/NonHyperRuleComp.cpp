@@ -4,17 +4,24 @@
 #include <mod/Function.h>
 #include <mod/dg/GraphInterface.h>
 #include <mod/Derivation.h>
+#include <mod/lib/DG/Dump.h>
 #include <mod/lib/DG/Strategies/GraphState.h>
 #include <mod/lib/DG/Strategies/Strategy.h>
 #include <mod/lib/Graph/Single.h>
 #include <mod/lib/Graph/Properties/String.h>
 #include <mod/lib/Graph/Properties/Term.h>
 #include <mod/lib/IO/IO.h>
+#include <mod/lib/RC/MatchMaker/ComponentMorphismCache.h>
 #include <mod/lib/Rules/Real.h>
 
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+
 namespace mod {
 namespace lib {
 namespace DG {
@@ -22,19 +29,16 @@ namespace DG {
 struct NonHyperRuleComp::ExecutionEnv : public Strategies::ExecutionEnv {
 
 	ExecutionEnv(NonHyperRuleComp &owner, LabelSettings labelSettings)
-	: Strategies::ExecutionEnv(labelSettings), owner(owner) { }
+	: Strategies::ExecutionEnv(labelSettings), owner(owner),
+	morphismCache(getConfig().componentSG.morphismCacheSize.get()) { }
 
 	bool tryAddGraph(std::shared_ptr<graph::Graph> gCand) override {
-		const auto ls = LabelSettings{owner.getLabelSettings().type, LabelRelation::Isomorphism, owner.getLabelSettings().withStereo, LabelRelation::Isomorphism};
-		for(const auto &g : owner.getGraphDatabase()) {
-			if(g == gCand) break;
-			const bool equal = gCand->isomorphism(g, 1, ls);
-			if(equal) {
-				std::string msg = "Isomorphic graphs '" + g->getName() + "' and '" + gCand->getName() + "' in initial graph database and/or add strategies.";
-				throw LogicError(std::move(msg));
-			}
+		const auto g = owner.findIsomorphicInDatabase(gCand->getGraph());
+		if(g) {
+			std::string msg = "Isomorphic graphs '" + g->getName() + "' and '" + gCand->getName() + "' in initial graph database and/or add strategies.";
+			throw LogicError(std::move(msg));
 		}
-		if(ls.type == LabelType::Term) {
+		if(owner.getLabelSettings().type == LabelType::Term) {
 			const auto &term = get_term(gCand->getGraph().getLabelledGraph());
 			if(!isValid(term)) {
 				std::string msg = "Parsing failed for graph '" + gCand->getName() + "' in dynamic add strategy. " + term.getParsingError();
@@ -117,31 +121,117 @@ struct NonHyperRuleComp::ExecutionEnv : public Strategies::ExecutionEnv {
 	}
 public:
 
-	void fillHyperEdges(std::vector<dg::DG::HyperEdge> &edges) const override {
-		edges = owner.getAllHyperEdges();
+	const std::vector<dg::DG::HyperEdge> &getHyperEdges() const override {
+		return owner.getAllHyperEdges();
+	}
+
+	lib::RC::ComponentMorphismCache *getComponentMorphismCache() override {
+		if(getConfig().componentSG.morphismCacheSize.get() == 0) return nullptr;
+		return &morphismCache;
+	}
+public:
+
+	boost::optional<std::size_t> enterRepeat() override {
+		if(repeatDepth++ != 0) return boost::none;
+		return nextRepeatId++;
+	}
+
+	void leaveRepeat() override {
+		assert(repeatDepth > 0);
+		--repeatDepth;
+	}
+
+	std::unique_ptr<Strategies::GraphState> resumeRepeat(std::size_t repeatId, std::size_t &numIterations, bool &finished) override {
+		const auto iter = resumeStates.find(repeatId);
+		if(iter == end(resumeStates)) return nullptr;
+		numIterations = iter->second.numIterations;
+		finished = iter->second.finished;
+		auto state = std::move(iter->second.state);
+		resumeStates.erase(iter);
+		return state;
+	}
+
+	void checkpointRepeat(std::size_t repeatId, std::size_t numIterations, bool finished, const Strategies::GraphState &state) override {
+		if(getConfig().dg.checkpointFile.get().empty()) return;
+		setRepeatState(repeatId, numIterations, finished, state);
+		++numIterationsSinceCheckpoint;
+		if(finished) {
+			writeCheckpoint();
+			return;
+		}
+		// each checkpoint contains the complete derivation graph, so do not write them too often
+		const auto &config = getConfig().dg;
+		if(numIterationsSinceCheckpoint < config.checkpointInterval.get()) return;
+		const auto elapsed = std::chrono::steady_clock::now() - lastCheckpoint;
+		if(elapsed < std::chrono::seconds(config.checkpointIntervalSeconds.get())) return;
+		writeCheckpoint();
+	}
+
+	void setRepeatState(std::size_t repeatId, std::size_t numIterations, bool finished, const Strategies::GraphState &state) {
+		auto &rs = repeatStates[repeatId];
+		rs.repeatId = repeatId;
+		rs.numIterations = numIterations;
+		rs.finished = finished;
+		rs.universe = state.getUniverse();
+		rs.subset.assign(state.getSubset(0).begin(), state.getSubset(0).end());
+	}
+private:
+
+	void writeCheckpoint() {
+		numIterationsSinceCheckpoint = 0;
+		lastCheckpoint = std::chrono::steady_clock::now();
+		const std::string &file = getConfig().dg.checkpointFile.get();
+		std::vector<lib::DG::Dump::RepeatState> repeats;
+		for(const auto &p : repeatStates) repeats.push_back(p.second);
+		// write to a temporary file first, so a complete checkpoint always exists
+		const std::string tmpFile = file + ".tmp";
+		bool good;
+		{
+			std::ofstream s(tmpFile, std::ios::binary);
+			if(s) lib::DG::Dump::writeCheckpoint(owner, repeats, s);
+			good = bool(s);
+		}
+		if(!good || std::rename(tmpFile.c_str(), file.c_str()) != 0) {
+			IO::log() << "DG::RuleComp:	could not write checkpoint '" << file << "'" << std::endl;
+			return;
+		}
+		if(getConfig().dg.calculateVerbose.get())
+			IO::log() << "DG::RuleComp:	checkpoint written to '" << file << "'" << std::endl;
 	}
 public:
+
+	struct ResumeState {
+		std::size_t numIterations;
+		bool finished;
+		std::unique_ptr<Strategies::GraphState> state;
+	};
+public:
 	NonHyperRuleComp &owner;
+	lib::RC::ComponentMorphismCache morphismCache;
+	unsigned int repeatDepth = 0;
+	std::size_t nextRepeatId = 0;
+	std::map<std::size_t, lib::DG::Dump::RepeatState> repeatStates;
+	std::size_t numIterationsSinceCheckpoint = 0;
+	std::chrono::steady_clock::time_point lastCheckpoint = std::chrono::steady_clock::now();
+	std::map<std::size_t, ResumeState> resumeStates;
 };
 
 NonHyperRuleComp::NonHyperRuleComp(const std::vector<std::shared_ptr<graph::Graph> > &graphDatabase,
-		Strategies::Strategy *strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes)
-: NonHyper(graphDatabase, labelSettings), strategy(strategy), input(new Strategies::GraphState()), doExit(false) {
+		Strategies::Strategy *strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes,
+		std::unique_ptr<Dump::Checkpoint> checkpoint)
+: NonHyper(graphDatabase, labelSettings), strategy(strategy), input(new Strategies::GraphState()),
+checkpoint(std::move(checkpoint)), doExit(false) {
 	env.reset(new ExecutionEnv(*this, labelSettings));
 	strategy->setExecutionEnv(*env);
-	const auto ls = LabelSettings{getLabelSettings().type, LabelRelation::Isomorphism, getLabelSettings().withStereo, LabelRelation::Isomorphism};
-	strategy->preAddGraphs([this, ls](std::shared_ptr<graph::Graph> gCand) {
+	strategy->preAddGraphs([this](std::shared_ptr<graph::Graph> gCand) {
 		if(!getConfig().dg.skipInitialGraphIsomorphismCheck.get()) {
-			for(const auto &g : getGraphDatabase()) {
-				if(g == gCand) break;
-				const bool equal = gCand->isomorphism(g, 1, ls);
-				if(equal) {
-					std::string msg = "Isomorphic graphs '" + g->getName() + "' and '" + gCand->getName() + "' in initial graph database and/or add strategies.";
-					throw LogicError(std::move(msg));
-				}
+			const auto g = findIsomorphicInDatabase(gCand->getGraph());
+			if(g) {
+				std::string msg = "Isomorphic graphs '" + g->getName() + "' and '" + gCand->getName() + "' in initial graph database and/or add strategies.";
+				throw LogicError(std::move(msg));
 			}
 		}
-		if(ls.type == LabelType::Term) {
+		if(getLabelSettings().type == LabelType::Term) {
 			const auto &term = get_term(gCand->getGraph().getLabelledGraph());
 			if(!isValid(term)) {
 				std::string msg = "Parsing failed for graph '" + gCand->getName() + "' in static add strategy. " + term.getParsingError();
@@ -161,6 +251,23 @@ NonHyperRuleComp::NonHyperRuleComp(const std::vector<std::shared_ptr<graph::Grap
 			}
 		});
 	}
+	if(this->checkpoint) {
+		const auto ls = this->checkpoint->labelSettings;
+		if(ls.type != labelSettings.type || ls.relation != labelSettings.relation
+				|| ls.withStereo != labelSettings.withStereo || ls.stereoRelation != labelSettings.stereoRelation) {
+			throw InputError("The checkpoint was made with different label settings.");
+		}
+		std::unordered_set<std::string> ruleNames;
+		strategy->forEachRule([&](const lib::Rules::Real &r) {
+			ruleNames.insert(r.getName());
+		});
+		for(const auto &d : this->checkpoint->derivations) {
+			for(const auto &name : d.rules) {
+				if(ruleNames.find(name) == end(ruleNames))
+					throw InputError("Rule '" + name + "' in the checkpoint is not in the strategy.");
+			}
+		}
+	}
 }
 
 NonHyperRuleComp::~NonHyperRuleComp() { }
@@ -171,7 +278,80 @@ std::string NonHyperRuleComp::getType() const {
 
 void NonHyperRuleComp::calculateImpl() {
 	if(getHasCalculated()) return;
+	if(checkpoint) resume();
 	strategy->execute(IO::log(), *input);
+	if(getConfig().componentSG.verboseCache.get()) env->morphismCache.printStats(IO::log());
+}
+
+void NonHyperRuleComp::resume() {
+	auto &cp = *checkpoint;
+	const auto labelType = getLabelSettings().type;
+	std::unordered_map<std::string, const lib::Rules::Real*> rulesByName;
+	strategy->forEachRule([&](const lib::Rules::Real &r) {
+		rulesByName.emplace(r.getName(), &r);
+	});
+	// the graphs of the checkpoint are pairwise non-isomorphic,
+	// so only the graphs already in the database are checked
+	std::unordered_map<std::size_t, std::vector<std::shared_ptr<graph::Graph> > > givenByHash;
+	for(const auto &g : getGraphDatabase())
+		givenByHash[g->getGraph().getInvariantHash(labelType)].push_back(g);
+	std::vector<std::shared_ptr<graph::Graph> > graphs;
+	std::vector<bool> isNew;
+	graphs.reserve(cp.graphs.size());
+	isNew.reserve(cp.graphs.size());
+	for(auto &entry : cp.graphs) {
+		std::shared_ptr<graph::Graph> g;
+		const auto iter = givenByHash.find(entry.g->getInvariantHash(labelType));
+		if(iter != end(givenByHash)) {
+			for(const auto &gGiven : iter->second) {
+				const auto ls = LabelSettings{labelType, LabelRelation::Isomorphism, getLabelSettings().withStereo, LabelRelation::Isomorphism};
+				if(1 == lib::Graph::Single::isomorphism(*entry.g, gGiven->getGraph(), 1, ls)) {
+					g = gGiven;
+					break;
+				}
+			}
+		}
+		isNew.push_back(!g);
+		if(!g) {
+			g = graph::Graph::makeGraph(std::move(entry.g));
+			addGraph(g);
+		}
+		graphs.push_back(g);
+	}
+	// this restores the product numbering
+	for(const auto i : cp.products) {
+		if(isNew[i]) giveProductStatus(graphs[i]);
+	}
+	// recreate vertices and derivations in order of increasing id
+	std::size_t iGraphs = 0, iDerivations = 0;
+	while(true) {
+		const auto nextDerivationId = iDerivations < cp.derivations.size()
+				? cp.derivations[iDerivations].id : Dump::Checkpoint::noVertex;
+		if(iGraphs < cp.graphs.size() && cp.graphs[iGraphs].id < nextDerivationId) {
+			addGraphAsVertex(graphs[iGraphs]);
+			iGraphs++;
+		} else if(iDerivations < cp.derivations.size()) {
+			const auto &d = cp.derivations[iDerivations];
+			std::vector<const lib::Graph::Single*> srcGraphs, tarGraphs;
+			for(const auto i : d.sources) srcGraphs.push_back(&graphs[i]->getGraph());
+			for(const auto i : d.targets) tarGraphs.push_back(&graphs[i]->getGraph());
+			GraphMultiset gmsSrc(std::move(srcGraphs)), gmsTar(std::move(tarGraphs));
+			suggestDerivation(gmsSrc, gmsTar, nullptr);
+			for(const auto &name : d.rules) suggestDerivation(gmsSrc, gmsTar, rulesByName[name]);
+			iDerivations++;
+		} else break;
+	}
+	for(const auto &r : cp.repeats) {
+		std::vector<const lib::Graph::Single*> universe;
+		for(const auto i : r.universe) universe.push_back(&graphs[i]->getGraph());
+		auto state = std::make_unique<Strategies::GraphState>(universe);
+		for(const auto i : r.subset) state->addToSubset(0, &graphs[i]->getGraph());
+		env->setRepeatState(r.repeatId, r.numIterations, r.finished, *state);
+		env->resumeStates[r.repeatId] = ExecutionEnv::ResumeState{r.numIterations, r.finished, std::move(state)};
+	}
+	IO::log() << "DG::RuleComp:	resumed from checkpoint with " << cp.graphs.size() << " graphs and "
+			<< cp.derivations.size() << " derivations" << std::endl;
+	checkpoint.reset();
 }
 
 void NonHyperRuleComp::listImpl(std::ostream &s) const {
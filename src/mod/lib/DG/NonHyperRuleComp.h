@@ -7,6 +7,9 @@
 namespace mod {
 namespace lib {
 namespace DG {
+namespace Dump {
+struct Checkpoint;
+} // namespace Dump
 namespace Strategies {
 class GraphState;
 class Add;
@@ -18,8 +21,10 @@ class Rule;
 } // namespace Strategies
 
 struct NonHyperRuleComp : public NonHyper {
+	// if checkpoint is not null, then the calculation is resumed from it
 	NonHyperRuleComp(const std::vector<std::shared_ptr<graph::Graph> > &graphDatabase,
-			Strategies::Strategy *strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes);
+			Strategies::Strategy *strategy, LabelSettings labelSettings, bool ignoreRuleLabelTypes,
+			std::unique_ptr<Dump::Checkpoint> checkpoint);
 	~NonHyperRuleComp();
 	std::string getType() const;
 	void printStrategyInfo(std::ostream &s) const;
@@ -27,11 +32,14 @@ struct NonHyperRuleComp : public NonHyper {
 private:
 	void calculateImpl();
 	void listImpl(std::ostream &s) const;
+	// recreates the graphs and derivations of the checkpoint, and gives the Repeat states to the execution environment
+	void resume();
 private:
 	struct ExecutionEnv;
 	std::unique_ptr<ExecutionEnv> env;
 	std::unique_ptr<Strategies::Strategy> strategy;
 	std::unique_ptr<Strategies::GraphState> input;
+	std::unique_ptr<Dump::Checkpoint> checkpoint;
 private: // state for computation
 	std::vector<std::shared_ptr<mod::Function<bool(const mod::Derivation&)> > > leftPredicates;
 	std::vector<std::shared_ptr<mod::Function<bool(const mod::Derivation&)> > > rightPredicates;
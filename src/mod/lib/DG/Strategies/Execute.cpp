@@ -39,16 +39,7 @@ bool Execute::isConsumed(const lib::Graph::Single *g) const {
 
 void Execute::executeImpl(std::ostream &s, const GraphState &input) {
 	if(getConfig().dg.calculateVerbose.get()) printInfo(s);
-	dg::Strategy::GraphState gs(
-			[&input](std::vector<std::shared_ptr<graph::Graph> > &subset) {
-				for(const lib::Graph::Single *g : input.getSubset(0)) subset.push_back(g->getAPIReference());
-			},
-	[&input](std::vector<std::shared_ptr<graph::Graph> > &universe) {
-		for(const lib::Graph::Single *g : input.getUniverse()) universe.push_back(g->getAPIReference());
-	},
-	[this](std::vector<dg::DG::HyperEdge> &edges) {
-		getExecutionEnv().fillHyperEdges(edges);
-	});
+	const auto gs = makeAPIGraphState(input);
 	(*func)(gs);
 }
 
@@ -52,8 +52,8 @@ void Filter::executeImpl(std::ostream &s, const GraphState &input) {
 	[&input](std::vector<std::shared_ptr<graph::Graph> > &universe) {
 		for(const lib::Graph::Single *g : input.getUniverse()) universe.push_back(g->getAPIReference());
 	},
-	[this](std::vector<dg::DG::HyperEdge> &edges) {
-		getExecutionEnv().fillHyperEdges(edges);
+	[this]() -> const std::vector<dg::DG::HyperEdge>& {
+		return getExecutionEnv().getHyperEdges();
 	});
 	if(!filterUniverse) {
 		output = new GraphState(input.getUniverse());
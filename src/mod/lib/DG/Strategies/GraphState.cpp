@@ -3,6 +3,10 @@
 #include <mod/lib/Graph/Single.h>
 #include <mod/lib/IO/IO.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <atomic>
+
 namespace mod {
 namespace lib {
 namespace DG {
@@ -19,7 +23,8 @@ GraphState::GraphState() {
 	commonInit();
 }
 
-GraphState::GraphState(const GraphState &other) : universe(other.universe) {
+GraphState::GraphState(const GraphState &other)
+: universe(other.universe), graphToIndex(other.graphToIndex), fingerprint(other.fingerprint) {
 	assert(other.subsets.size() >= 1);
 	assert(other.subsets.begin()->first == 0);
 	// commonInit is not needed, as other should have subset 0
@@ -32,6 +37,13 @@ GraphState::GraphState(const GraphState &other) : universe(other.universe) {
 
 GraphState::GraphState(const std::vector<const Graph::Single*> &universe) : universe(universe) {
 	commonInit();
+	graphToIndex.reserve(universe.size());
+	for(unsigned int i = 0; i < universe.size(); i++) {
+		const bool inserted = graphToIndex.emplace(universe[i], i).second;
+		assert(inserted);
+		(void) inserted;
+		fingerprint += getFingerprint(universe[i]);
+	}
 }
 
 GraphState::GraphState(const std::vector<const GraphState*> &resultSets) {
@@ -66,16 +78,18 @@ GraphState::GraphState(const std::vector<const GraphState*> &resultSets) {
 		}
 	}
 
-	using GraphToIndex = std::map<const Graph::Single*, unsigned int>;
-	GraphToIndex graphToIndex;
-	for(unsigned int i = 0; i < universe.size(); i++) graphToIndex[universe[i]] = i;
+	graphToIndex.reserve(universe.size());
+	for(unsigned int i = 0; i < universe.size(); i++) {
+		graphToIndex[universe[i]] = i;
+		fingerprint += getFingerprint(universe[i]);
+	}
 
 	for(const NewSubsetStore::value_type &newSubset : newSubsets) {
 		assert(newSubset.first == 0); // TODO: remove
 		std::pair < SubsetStore::iterator, bool> p = subsets.insert(std::make_pair(newSubset.first, Subset(*this)));
 		assert(p.second);
 		Subset &subset = p.first->second;
-		for(const Graph::Single *g : newSubset.second) subset.indices.push_back(graphToIndex[g]);
+		for(const Graph::Single *g : newSubset.second) subset.addIndex(graphToIndex[g], g);
 	}
 
 	assert(subsets.size() >= 1);
@@ -105,11 +119,9 @@ void GraphState::addToSubset(unsigned int subsetIndex, const lib::Graph::Single
 	SubsetStore::iterator iter = subsets.find(subsetIndex);
 	if(iter == subsets.end()) iter = subsets.insert(SubsetStore::value_type(subsetIndex, Subset(*this))).first;
 	Subset &subset = iter->second;
-
-	for(unsigned int index : subset.indices) {
-		if(index == gIndex) return;
-	}
-	subset.indices.push_back(gIndex);
+	if(subset.hasIndex(gIndex)) return;
+	subset.addIndex(gIndex, g);
+	bumpGeneration();
 }
 
 void GraphState::addToUniverse(const Graph::Single *g) {
@@ -137,54 +149,120 @@ const GraphState::GraphList &GraphState::getUniverse() const {
 	return universe;
 }
 
+std::size_t GraphState::getGeneration() const {
+	return generation;
+}
+
 bool GraphState::isInUniverse(const lib::Graph::Single *g) const {
-	for(unsigned int i = 0; i < universe.size(); i++) {
-		if(universe[i] == g) return true;
-	}
-	return false;
+	return graphToIndex.find(g) != graphToIndex.end();
 }
 
 bool operator==(const GraphState &a, const GraphState &b) {
-	typedef GraphState::SubsetStore::const_iterator Iter;
-	{// check sizes
-		if(a.universe.size() != b.universe.size()) return false;
-		if(a.subsets.size() != b.subsets.size()) return false;
-		Iter ai, ae, bi, be;
-		for(ai = a.subsets.begin(), ae = a.subsets.end(),
-				bi = b.subsets.begin(), be = b.subsets.end();
-				ai != ae && bi != be; ai++, bi++) {
-			if(ai->first != bi->first) return false;
-			if(ai->second.size() != bi->second.size()) return false;
-		}
+	// first the cheap checks, sizes and fingerprints
+	if(a.universe.size() != b.universe.size()) return false;
+	if(a.fingerprint != b.fingerprint) return false;
+	if(a.subsets.size() != b.subsets.size()) return false;
+	for(const auto &p : a.subsets) {
+		const auto iter = b.subsets.find(p.first);
+		if(iter == b.subsets.end()) return false;
+		if(p.second.size() != iter->second.size()) return false;
+		if(p.second.fingerprint != iter->second.fingerprint) return false;
 	}
-	GraphState aCopy(a), bCopy(b);
-	std::less<const Graph::Single*> comp;
-	aCopy.sortUniverse(comp);
-	bCopy.sortUniverse(comp);
-	for(unsigned int i = 0; i < a.universe.size(); i++) {
-		if(aCopy.universe[i] != bCopy.universe[i]) return false;
+	// the fingerprints may collide, so check the elements, but as the sizes are equal we only need inclusion
+	for(const Graph::Single *g : a.universe) {
+		if(!b.isInUniverse(g)) return false;
 	}
-	Iter ai, ae, bi, be;
-	for(ai = aCopy.subsets.begin(), ae = aCopy.subsets.end(),
-			bi = bCopy.subsets.begin(), be = bCopy.subsets.end();
-			ai != ae && bi != be; ai++, bi++) {
-		aCopy.sortSubset(ai->first, comp);
-		bCopy.sortSubset(bi->first, comp);
-		for(unsigned int i = 0; i < ai->second.size(); i++) {
-			if(*(ai->second.begin() + i) != *(bi->second.begin() + i)) return false;
+	for(const auto &p : a.subsets) {
+		const GraphState::Subset &subsetB = b.subsets.find(p.first)->second;
+		for(const Graph::Single *g : p.second) {
+			if(!subsetB.hasIndex(b.graphToIndex.find(g)->second)) return false;
 		}
 	}
 	return true;
 }
 
 unsigned int GraphState::addUniverseGetIndex(const lib::Graph::Single *g) {
-	for(unsigned int i = 0; i < universe.size(); i++) {
-		if(universe[i] == g) return i;
-	}
+	const auto p = graphToIndex.emplace(g, universe.size());
+	if(!p.second) return p.first->second;
 	universe.push_back(g);
+	fingerprint += getFingerprint(g);
+	bumpGeneration();
 	return universe.size() - 1;
 }
 
+void GraphState::setUniverseOrder(const GraphList &order) {
+	assert(order.size() == universe.size());
+	std::vector<unsigned int> newToOld;
+	newToOld.reserve(order.size());
+	for(const lib::Graph::Single *g : order) {
+		assert(graphToIndex.find(g) != graphToIndex.end());
+		newToOld.push_back(graphToIndex[g]);
+	}
+	permuteUniverse(newToOld);
+}
+
+void GraphState::setSubsetOrder(unsigned int subsetIndex, const GraphList &order) {
+	assert(hasSubset(subsetIndex));
+	Subset &subset = subsets.find(subsetIndex)->second;
+	assert(order.size() == subset.indices.size());
+	for(unsigned int i = 0; i < order.size(); i++) {
+		assert(graphToIndex.find(order[i]) != graphToIndex.end());
+		subset.indices[i] = graphToIndex[order[i]];
+		assert(subset.hasIndex(subset.indices[i]));
+	}
+	bumpGeneration();
+}
+
+void GraphState::permuteUniverse(const std::vector<unsigned int> &newToOld) {
+	assert(newToOld.size() == universe.size());
+	std::vector<unsigned int> oldToNew(universe.size());
+	for(unsigned int i = 0; i < universe.size(); i++) oldToNew[newToOld[i]] = i;
+	{
+		GraphList newUniverse(universe.size());
+		for(unsigned int i = 0; i < universe.size(); i++) newUniverse[i] = universe[newToOld[i]];
+		std::swap(newUniverse, universe);
+	}
+	// substitute subset ids
+	for(SubsetStore::value_type &p : subsets)
+		for(unsigned int i = 0; i < p.second.indices.size(); i++)
+			p.second.indices[i] = oldToNew[p.second.indices[i]];
+	reindex();
+	bumpGeneration();
+}
+
+void GraphState::reindex() {
+	for(unsigned int i = 0; i < universe.size(); i++) graphToIndex[universe[i]] = i;
+	for(SubsetStore::value_type &p : subsets) {
+		Subset &subset = p.second;
+		subset.isMember.assign(universe.size(), false);
+		for(unsigned int index : subset.indices) subset.isMember[index] = true;
+	}
+}
+
+std::size_t GraphState::getFingerprint(const lib::Graph::Single *g) {
+	// the fingerprints of sets are sums, so spread the ids over all bits
+	std::size_t res = 0;
+	boost::hash_combine(res, g->getId());
+	return res;
+}
+
+std::size_t GraphState::nextGeneration() {
+	static std::atomic<std::size_t> next(0);
+	return next++;
+}
+
+void GraphState::bumpGeneration() {
+	generation = nextGeneration();
+}
+
+void GraphState::Subset::addIndex(unsigned int index, const lib::Graph::Single *g) {
+	assert(!hasIndex(index));
+	if(index >= isMember.size()) isMember.resize(std::max<std::size_t>(index + 1, isMember.size() * 2), false);
+	isMember[index] = true;
+	indices.push_back(index);
+	fingerprint += getFingerprint(g);
+}
+
 } // namespace Strategies
 } // namespace DG
 } // namespace lib
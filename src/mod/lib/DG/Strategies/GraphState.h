@@ -39,7 +39,8 @@ struct GraphState {
 
 		explicit Subset(const GraphState &rs) : rs(rs) { }
 
-		explicit Subset(const GraphState &rs, const Subset &other) : rs(rs), indices(other.indices) { }
+		explicit Subset(const GraphState &rs, const Subset &other)
+		: rs(rs), indices(other.indices), isMember(other.isMember), fingerprint(other.fingerprint) { }
 
 		const_iterator begin() const {
 			return const_iterator(indices.begin(), Transformer(rs.getUniverse()));
@@ -56,10 +57,20 @@ struct GraphState {
 		bool empty() const {
 			return indices.empty();
 		}
+	private:
+		bool hasIndex(unsigned int index) const {
+			return index < isMember.size() && isMember[index];
+		}
+
+		// pre: !hasIndex(index)
+		void addIndex(unsigned int index, const lib::Graph::Single *g);
 	private:
 		friend class GraphState;
+		friend bool operator==(const GraphState &a, const GraphState &b);
 		const GraphState &rs;
 		std::vector<unsigned int> indices;
+		std::vector<bool> isMember; // indexed by universe index
+		std::size_t fingerprint = 0; // independent of the order of the graphs
 	};
 	typedef std::unordered_map<unsigned int, Subset> SubsetStore;
 private:
@@ -78,17 +89,35 @@ public:
 	template<typename T> struct Compare;
 	template<typename T> void sortUniverse(const T compare);
 	template<typename T> void sortSubset(unsigned int subsetIndex, const T compare);
+	// requires: order is a permutation of the universe
+	void setUniverseOrder(const GraphList &order);
+	// requires: order is a permutation of the subset
+	void setSubsetOrder(unsigned int subsetIndex, const GraphList &order);
 	bool hasSubset(unsigned int subsetIndex) const;
 	const Subset &getSubset(unsigned int i) const;
 	const SubsetStore &getSubsets() const;
 	const GraphList &getUniverse() const;
 	bool isInUniverse(const lib::Graph::Single *g) const;
+	// A value which is unique among all states and all their modifications,
+	// so unlike the address of a state it identifies the contents even after states have been freed.
+	std::size_t getGeneration() const;
 	friend bool operator==(const GraphState &a, const GraphState &b);
 private:
 	unsigned int addUniverseGetIndex(const lib::Graph::Single *g);
+	// newToOld[i] is the old index of the graph which gets index i
+	void permuteUniverse(const std::vector<unsigned int> &newToOld);
+	// rebuild the lookup structures after the universe has been permuted
+	void reindex();
+	static std::size_t getFingerprint(const lib::Graph::Single *g);
+	static std::size_t nextGeneration();
+	// call after each modification
+	void bumpGeneration();
 private:
 	GraphList universe;
 	SubsetStore subsets;
+	std::unordered_map<const lib::Graph::Single*, unsigned int> graphToIndex; // into universe
+	std::size_t fingerprint = 0; // of the universe, independent of the order of the graphs
+	std::size_t generation = nextGeneration();
 };
 
 template<typename T>
@@ -116,20 +145,10 @@ void GraphState::sortUniverse(T compare) {
 	for(unsigned int i = 0; i < newToOld.size(); i++) newToOld[i] = i;
 	Compare<T> comp(universe, compare);
 	std::stable_sort(newToOld.begin(), newToOld.end(), comp);
-	std::vector<unsigned int> oldToNew(universe.size());
-	for(unsigned int i = 0; i < universe.size(); i++) oldToNew[newToOld[i]] = i;
-	{
-		GraphList newUniverse(universe.size());
-		for(unsigned int i = 0; i < universe.size(); i++) newUniverse[i] = universe[newToOld[i]];
-		std::swap(newUniverse, universe);
-	}
+	permuteUniverse(newToOld);
 	{ // TODO: remove, stupid sanity check
 		for(unsigned int i = 1; i < universe.size(); i++) assert(!compare(universe[i], universe[i - 1]));
 	}
-	// substitute subset ids
-	for(SubsetStore::value_type &p : subsets)
-		for(unsigned int i = 0; i < p.second.indices.size(); i++)
-			p.second.indices[i] = oldToNew[p.second.indices[i]];
 }
 
 template<typename T>
@@ -140,6 +159,7 @@ void GraphState::sortSubset(unsigned int subsetIndex, T compare) {
 	Subset &subset = iter->second;
 	Compare<T> comp(universe, compare);
 	std::stable_sort(subset.indices.begin(), subset.indices.end(), comp);
+	bumpGeneration();
 }
 
 } // namespace Strategies
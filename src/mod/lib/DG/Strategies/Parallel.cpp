@@ -2,8 +2,10 @@
 
 #include <mod/Config.h>
 #include <mod/lib/DG/Strategies/GraphState.h>
+#include <mod/lib/DG/Strategies/Rule.h>
 #include <mod/lib/Graph/Single.h>
 #include <mod/lib/IO/IO.h>
+#include <mod/lib/ParallelFor.h>
 
 namespace mod {
 namespace lib {
@@ -76,7 +78,9 @@ void Parallel::executeImpl(std::ostream& s, const GraphState &input) {
 		indentLevel++;
 	}
 
+	std::size_t stagedEnd = 0;
 	for(unsigned int i = 0; i < strats.size(); i++) {
+		if(i >= stagedEnd) stagedEnd = stageRules(input, i);
 		Strategy *strat = strats[i];
 		if(getConfig().dg.calculateVerbose.get()) {
 			s << indent << "substrat " << i << ":" << std::endl;
@@ -95,6 +99,28 @@ void Parallel::executeImpl(std::ostream& s, const GraphState &input) {
 	if(getConfig().dg.calculateVerbose.get()) indentLevel--;
 }
 
+// The rule substrategies from the given one find their derivations concurrently, at most one per thread,
+// and they are then added in order when each substrategy is executed.
+// So each substrategy is committed right after its group, and only the derivations of a single group are held at a time.
+// Returns the index of the first substrategy after the group.
+std::size_t Parallel::stageRules(const GraphState &input, std::size_t first) {
+	const unsigned int numThreads = getConfig().common.numThreads.get();
+	if(getExecutionEnv().doExit()) return strats.size();
+	if(!Rule::canStage(getExecutionEnv().labelSettings)) return strats.size();
+	std::vector<Rule*> rules;
+	std::size_t last = first;
+	for(; last < strats.size() && rules.size() < numThreads; last++) {
+		if(auto *rule = dynamic_cast<Rule*>(strats[last]))
+			rules.push_back(rule);
+	}
+	if(rules.size() < 2) return last;
+	for(Rule *rule : rules) rule->prepareStaging(input);
+	parallelFor(numThreads, rules.size(), [&](std::size_t i) {
+		rules[i]->stage(input);
+	});
+	return last;
+}
+
 } // namespace Strategies
 } // namespace DG
 } // namespace lib
@@ -21,6 +21,7 @@ struct Parallel : Strategy {
 private:
 	void setExecutionEnvImpl();
 	void executeImpl(std::ostream &s, const GraphState &input);
+	std::size_t stageRules(const GraphState &input, std::size_t first);
 private:
 	std::vector<Strategy*> strats;
 };
@@ -9,6 +9,27 @@ namespace mod {
 namespace lib {
 namespace DG {
 namespace Strategies {
+namespace {
+
+// Pairs ExecutionEnv::enterRepeat with leaveRepeat, also when the execution throws.
+
+struct RepeatScope {
+
+	explicit RepeatScope(ExecutionEnv &env) : env(env), repeatId(env.enterRepeat()) { }
+
+	RepeatScope(const RepeatScope&) = delete;
+	RepeatScope &operator=(const RepeatScope&) = delete;
+
+	~RepeatScope() {
+		env.leaveRepeat();
+	}
+private:
+	ExecutionEnv &env;
+public:
+	const boost::optional<std::size_t> repeatId;
+};
+
+} // namespace
 
 Repeat::Repeat(Strategy* strat, std::size_t limit)
 : Strategy(strat->getMaxComponents()), strat(strat), limit(limit) { }
@@ -44,9 +65,13 @@ void Repeat::printInfo(std::ostream &s) const {
 }
 
 const GraphState &Repeat::getOutput() const {
-	assert(!subStrats.empty());
+	const GraphState &first = resumedState ? *resumedState : *input;
+	if(subStrats.empty()) {
+		assert(resumedState);
+		return first;
+	}
 	if(subStrats.back()->getOutput().getSubset(0).empty()) {
-		if(subStrats.size() == 1) return *input;
+		if(subStrats.size() == 1) return first;
 		else return subStrats[subStrats.size() - 2]->getOutput();
 	} else return subStrats.back()->getOutput();
 }
@@ -65,41 +90,47 @@ void Repeat::setExecutionEnvImpl() {
 void Repeat::executeImpl(std::ostream& s, const GraphState& input) {
 	s << indent << "Repeat, limit = " << limit << std::endl;
 	if(limit == 0) return;
-	indentLevel++;
-	// handle the first
-	Strategy *firstStrat = strat->clone();
-	firstStrat->setExecutionEnv(getExecutionEnv());
-	s << indent << "Substrat 0" << std::endl;
-	indentLevel++;
-	firstStrat->execute(s, input);
-	indentLevel--;
-	s << indent << "Got " << firstStrat->getOutput().getSubset(0).size() << " graphs" << std::endl;
-	subStrats.push_back(firstStrat);
-	if(firstStrat->getOutput().getSubset(0).empty()) {
-		indentLevel--;
-		return;
+	auto &env = getExecutionEnv();
+	const RepeatScope scope(env);
+	const auto &repeatId = scope.repeatId;
+	std::size_t numIterations = 0;
+	bool finished = false;
+	if(repeatId) {
+		resumedState = env.resumeRepeat(*repeatId, numIterations, finished);
+		if(resumedState) s << indent << "Resumed after " << numIterations << " substrats" << std::endl;
 	}
-	for(unsigned int i = 0; i < limit - 1; i++) {
+	indentLevel++;
+	for(std::size_t i = numIterations; i < limit && !finished; i++) {
+		const GraphState &subInput = !subStrats.empty() ? subStrats.back()->getOutput()
+				: resumedState ? *resumedState : input;
 		Strategy *subStrat = strat->clone();
-		subStrat->setExecutionEnv(getExecutionEnv());
-		s << indent << "Substrat " << (i + 1) << std::endl;
+		subStrat->setExecutionEnv(env);
+		s << indent << "Substrat " << i << std::endl;
 		indentLevel++;
-		subStrat->execute(s, subStrats.at(i)->getOutput());
+		subStrat->execute(s, subInput);
 		indentLevel--;
-		s << indent << "Got " << subStrat->getOutput().getSubset(0).size() << " graphs" << std::endl;
+		const GraphState &subOutput = subStrat->getOutput();
+		s << indent << "Got " << subOutput.getSubset(0).size() << " graphs" << std::endl;
 		subStrats.push_back(subStrat);
-		if(!getConfig().dg.ignoreSubset.get()) {
-			if(subStrat->getOutput().getSubset(0).empty()) {
-				if(getConfig().dg.calculateVerbose.get()) s << indent << "Breaking repeat due to empty subset" << std::endl;
-				break;
+		if(i == 0) {
+			finished = subOutput.getSubset(0).empty();
+		} else {
+			if(!getConfig().dg.ignoreSubset.get()) {
+				if(subOutput.getSubset(0).empty()) {
+					if(getConfig().dg.calculateVerbose.get()) s << indent << "Breaking repeat due to empty subset" << std::endl;
+					finished = true;
+				}
 			}
-		}
-		if(!getConfig().dg.disableRepeatFixedPointCheck.get()) {
-			if(subStrat->getOutput() == subStrats[i]->getOutput()) {
-				if(getConfig().dg.calculateVerbose.get()) s << indent << "Breaking repeat due to fixed point" << std::endl;
-				break;
+			if(!finished && !getConfig().dg.disableRepeatFixedPointCheck.get()) {
+				if(subOutput == subInput) {
+					if(getConfig().dg.calculateVerbose.get()) s << indent << "Breaking repeat due to fixed point" << std::endl;
+					finished = true;
+				}
 			}
 		}
+		if(i + 1 == limit) finished = true;
+		// an iteration cut short by the product limit is not complete
+		if(repeatId && !env.doExit()) env.checkpointRepeat(*repeatId, i + 1, finished, finished ? getOutput() : subOutput);
 	}
 	indentLevel--;
 }
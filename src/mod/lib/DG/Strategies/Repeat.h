@@ -24,6 +24,8 @@ private:
 	Strategy *strat;
 	std::size_t limit;
 	std::vector<Strategy*> subStrats;
+	// the state the iterations were continued from, when resumed from a checkpoint
+	std::unique_ptr<GraphState> resumedState;
 };
 
 } // namespace Strategies
@@ -6,14 +6,22 @@
 #include <mod/rule/Rule.h>
 #include <mod/lib/DG/NonHyperRuleComp.h>
 #include <mod/lib/DG/Strategies/GraphState.h>
+#include <mod/lib/DG/Strategies/RuleBinding.h>
 #include <mod/lib/Graph/Single.h>
 #include <mod/lib/Graph/Properties/Stereo.h>
 #include <mod/lib/Graph/Properties/String.h>
+#include <mod/lib/GraphMorphism/LabelFingerprint.h>
 #include <mod/lib/IO/IO.h>
-#include <mod/lib/RC/ComposeRuleReal.h>
-#include <mod/lib/RC/MatchMaker/Super.h>
+#include <mod/lib/ParallelFor.h>
+#include <mod/lib/RC/MatchMaker/ComponentMorphismCache.h>
 #include <mod/lib/Rules/Real.h>
-#include <mod/lib/Stereo/CloneUtil.h>
+#include <mod/lib/StringStore.h>
+#include <mod/lib/Term/WAM.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <unordered_map>
 
 namespace mod {
 namespace lib {
@@ -65,167 +73,121 @@ struct BoundRule {
 	std::vector<const lib::Graph::Single*> boundGraphs;
 };
 
+// a complete derivation, found but not yet added to the derivation graph
+struct StagedDerivation {
+	Binding binding;
+	std::vector<const lib::Graph::Single*> educts;
+};
+
 struct Context {
 	const std::shared_ptr<rule::Rule> &r;
 	ExecutionEnv &executionEnv;
 	GraphState *output;
 	std::unordered_set<const lib::Graph::Single*> &consumedGraphs;
+	// if not null, complete derivations are stored here instead of being handled
+	std::vector<StagedDerivation> *staged;
 };
 
+// The intermediary bound rules of one binding round, where isomorphic rules with the same bound graphs are only stored once.
+// The stored rules are indexed by their invariant hash and bound graphs, so isomorphism is only checked within a bucket.
+
 struct BoundRuleStorage {
 
-	BoundRuleStorage(LabelType labelType, bool withStereo, std::vector<BoundRule> &ruleStore, const BoundRule &rule, const lib::Graph::Single *graph)
-	: labelType(labelType), withStereo(withStereo), ruleStore(ruleStore), rule(rule), graph(graph) { }
+	BoundRuleStorage(LabelType labelType, bool withStereo, std::vector<BoundRule> &ruleStore)
+	: labelType(labelType), withStereo(withStereo), ruleStore(ruleStore) {
+		// the stored rules have their bound graphs sorted already
+		for(std::size_t i = 0; i < ruleStore.size(); i++) {
+			const BoundRule &rp = ruleStore[i];
+			if(rp.rule->isOnlyRightSide()) continue;
+			assert(std::is_sorted(begin(rp.boundGraphs), end(rp.boundGraphs), lib::Graph::Single::IdLess()));
+			index[getKey(rp)].push_back(i);
+		}
+	}
 
-	void add(lib::Rules::Real *r) {
+	// stores r as the result of binding graph to rule,
+	// returns false iff it was a duplicate, in which case it has been deleted
+	bool add(lib::Rules::Real *r, const BoundRule &rule, const lib::Graph::Single *graph) {
 		BoundRule p{r, rule.boundGraphs};
 		p.boundGraphs.push_back(graph);
 		bool found = false;
 		const bool doBoundRulesDuplicateCheck = true;
 		// if it's only right side, we will rather split it instead
-		if(doBoundRulesDuplicateCheck && !r->isOnlyRightSide()) {
-			std::vector<const lib::Graph::Single*> &rThis = p.boundGraphs;
-
-			std::sort(begin(rThis), end(rThis), [](const lib::Graph::Single *g1, const lib::Graph::Single * g2) {
-				return g1->getId() < g2->getId();
-			});
-
-			for(BoundRule &rp : ruleStore) {
-				if(rThis.size() != rp.boundGraphs.size()) continue;
-				std::vector<const lib::Graph::Single*> &rOther = rp.boundGraphs;
-
-				std::sort(rOther.begin(), rOther.end(), [](const lib::Graph::Single *g1, const lib::Graph::Single * g2) {
-					return g1->getId() < g2->getId();
-				});
-				bool doContinue = false;
-				for(unsigned int i = 0; i < rThis.size(); i++) {
-					if(rThis[i] != rOther[i]) {
-						doContinue = true;
-						break;
-					}
+		const bool doCheck = doBoundRulesDuplicateCheck && !r->isOnlyRightSide();
+		std::size_t key = 0;
+		if(doCheck) {
+			// the bound graphs of rule are sorted, so only the new one must be moved into place
+			std::inplace_merge(begin(p.boundGraphs), end(p.boundGraphs) - 1, end(p.boundGraphs), lib::Graph::Single::IdLess());
+			key = getKey(p);
+			// only bound rules with the same invariant hash and the same bound graphs can be equal
+			const auto iter = index.find(key);
+			if(iter != end(index)) {
+				for(const std::size_t i : iter->second) {
+					const BoundRule &rp = ruleStore[i];
+					if(p.boundGraphs != rp.boundGraphs) continue;
+					found = 1 == lib::Rules::Real::isomorphism(*r, *rp.rule, 1,{labelType, LabelRelation::Isomorphism, withStereo, LabelRelation::Isomorphism});
+					if(found) break;
 				}
-				if(doContinue) continue;
-				found = 1 == lib::Rules::Real::isomorphism(*r, *rp.rule, 1,{labelType, LabelRelation::Isomorphism, withStereo, LabelRelation::Isomorphism});
-				if(found) break;
 			}
 		}
 		if(found) {
 			//			IO::log() << "Duplicate BRP found" << std::endl;
 			delete r;
-		} else {
-			ruleStore.push_back(p);
-			if(getConfig().dg.calculateDetailsVerbose.get()) {
-				IO::log() << "DG::RuleComp\tadded <"
-						<< r->getName() << ", {";
-				for(const lib::Graph::Single *g : p.boundGraphs)
-					IO::log() << " " << g->getName();
-				IO::log() << " }> onlyRight: " << std::boolalpha << r->isOnlySide(lib::Rules::Membership::Right) << std::endl;
-			}
+			return false;
+		}
+		if(doCheck) index[key].push_back(ruleStore.size());
+		ruleStore.push_back(p);
+		if(getConfig().dg.calculateDetailsVerbose.get()) {
+			IO::log() << "DG::RuleComp\tadded <"
+					<< r->getName() << ", {";
+			for(const lib::Graph::Single *g : p.boundGraphs)
+				IO::log() << " " << g->getName();
+			IO::log() << " }> onlyRight: " << std::boolalpha << r->isOnlySide(lib::Rules::Membership::Right) << std::endl;
 		}
+		return true;
+	}
+private:
+	// pre: the bound graphs are sorted by id
+	std::size_t getKey(const BoundRule &p) const {
+		std::size_t key = p.rule->getInvariantHash(labelType);
+		for(const lib::Graph::Single *g : p.boundGraphs) boost::hash_combine(key, g->getId());
+		return key;
 	}
 private:
 	const LabelType labelType;
 	const bool withStereo;
 	std::vector<BoundRule> &ruleStore;
-	const BoundRule &rule;
-	const lib::Graph::Single *graph;
+	std::unordered_map<std::size_t, std::vector<std::size_t> > index; // into ruleStore
 };
 
-void handleBoundRulePair(Context context, const BoundRule &brp) {
-	assert(brp.rule);
-	// use a smart pointer so the rule for sure is deallocated, even though we do a 'continue'
-	const lib::Rules::Real &r = *brp.rule;
-	const auto &rDPO = r.getDPORule();
-	assert(r.isOnlyRightSide()); // otherwise, it should have been deallocated. All max component results should be only right side
+// pre: the binding has no left side
+void handleBoundRulePair(Context context, Binding binding, const std::vector<const lib::Graph::Single*> &educts) {
 	mod::Derivation d;
 	d.r = context.r;
-	for(const lib::Graph::Single *g : brp.boundGraphs) d.left.push_back(g->getAPIReference());
+	for(const lib::Graph::Single *g : educts) d.left.push_back(g->getAPIReference());
 	{ // left predicate
 		bool result = context.executionEnv.checkLeftPredicate(d);
 		if(!result) {
 			if(getConfig().dg.calculatePredicatesVerbose.get())
-				IO::log() << indent << "Skipping " << r.getName() << " due to leftPredicate" << std::endl;
+				IO::log() << indent << "Skipping " << context.r->getName() << " due to leftPredicate" << std::endl;
 			return;
 		}
 	}
-	if(getConfig().dg.calculateDetailsVerbose.get())
-		IO::log() << "Splitting " << r.getName() << " into " << rDPO.numRightComponents << " graphs" << std::endl;
-	const std::vector<const lib::Graph::Single*> &educts = brp.boundGraphs;
-	if(rDPO.numRightComponents == 0) MOD_ABORT; // continue;
-	using Vertex = lib::Graph::Vertex;
-	using Edge = lib::Graph::Edge;
-	using SideVertex = boost::graph_traits<lib::Rules::DPOProjection>::vertex_descriptor;
-	using SideEdge = boost::graph_traits<lib::Rules::DPOProjection>::edge_descriptor;
-
-	struct GraphData {
-
-		GraphData() : gPtr(new lib::Graph::GraphType()), pStringPtr(new lib::Graph::PropString(*gPtr)) { }
-	public:
-		std::unique_ptr<lib::Graph::GraphType> gPtr;
-		std::unique_ptr<lib::Graph::PropString> pStringPtr;
-		std::unique_ptr<lib::Graph::PropStereo> pStereoPtr;
-		std::vector<SideVertex> vertexMap;
-	};
-	std::vector<GraphData> products(rDPO.numRightComponents);
-	const auto &compMap = rDPO.rightComponents;
-	const auto &gRight = get_right(rDPO);
-	auto rpString = get_string(get_labelled_right(rDPO));
-	assert(num_vertices(gRight) == num_vertices(get_graph(rDPO)));
-	std::vector<Vertex> vertexMap(num_vertices(gRight));
-	for(const auto vSide : asRange(vertices(gRight))) {
-		const auto comp = compMap[get(boost::vertex_index_t(), gRight, vSide)];
-		auto &p = products[comp];
-		const auto v = add_vertex(*p.gPtr);
-		vertexMap[get(boost::vertex_index_t(), gRight, vSide)] = v;
-		p.pStringPtr->addVertex(v, rpString[vSide]);
+	std::vector<ProductGraph> products;
+	if(binding.rule) {
+		const auto &rDPO = binding.rule->getDPORule();
+		if(getConfig().dg.calculateDetailsVerbose.get())
+			IO::log() << "Splitting " << context.r->getName() << " result into " << rDPO.numRightComponents << " graphs" << std::endl;
+		products = splitRightSide(rDPO, context.executionEnv.labelSettings.withStereo);
+	} else {
+		if(getConfig().dg.calculateDetailsVerbose.get())
+			IO::log() << "Rewrote " << context.r->getName() << " result into " << binding.products.size() << " graphs" << std::endl;
+		products = std::move(binding.products);
 	}
-	for(const auto eSide : asRange(edges(gRight))) {
-		const auto vSideSrc = source(eSide, gRight);
-		const auto vSideTar = target(eSide, gRight);
-		const auto comp = compMap[get(boost::vertex_index_t(), gRight, vSideSrc)];
-		assert(comp == compMap[get(boost::vertex_index_t(), gRight, vSideTar)]);
-		const auto vCompSrc = vertexMap[get(boost::vertex_index_t(), gRight, vSideSrc)];
-		const auto vCompTar = vertexMap[get(boost::vertex_index_t(), gRight, vSideTar)];
-		const auto epComp = add_edge(vCompSrc, vCompTar, *products[comp].gPtr);
-		assert(epComp.second);
-		products[comp].pStringPtr->addEdge(epComp.first, rpString[eSide]);
-	}
-	if(context.executionEnv.labelSettings.withStereo && has_stereo(rDPO)) {
-		// make the inverse vertex maps
-		for(auto &p : products)
-			p.vertexMap.resize(num_vertices(*p.gPtr));
-		for(const auto vSide : asRange(vertices(gRight))) {
-			const auto comp = compMap[get(boost::vertex_index_t(), gRight, vSide)];
-			auto &p = products[comp];
-			const auto v = vertexMap[get(boost::vertex_index_t(), gRight, vSide)];
-			p.vertexMap[get(boost::vertex_index_t(), *p.gPtr, v)] = vSide;
-		}
-
-		for(auto &p : products) {
-			const auto &lgRight = get_labelled_right(rDPO);
-			assert(has_stereo(lgRight));
-			const auto vertexMap = [&p](const auto &vProduct) {
-				return p.vertexMap[get(boost::vertex_index_t(), *p.gPtr, vProduct)];
-			};
-			const auto edgeMap = [&p, &lgRight](const auto &eProduct) {
-				const auto &g = *p.gPtr;
-				const auto &gSide = get_graph(lgRight);
-				const auto vSrc = source(eProduct, g);
-				const auto vTar = target(eProduct, g);
-				const auto vSrcSide = p.vertexMap[get(boost::vertex_index_t(), g, vSrc)];
-				const auto vTarSide = p.vertexMap[get(boost::vertex_index_t(), g, vTar)];
-				const auto epSide = edge(vSrcSide, vTarSide, gSide);
-				assert(epSide.second);
-				return epSide.first;
-			};
-			const auto inf = Stereo::makeCloner(lgRight, *p.gPtr, vertexMap, edgeMap);
-			p.pStereoPtr = std::make_unique<lib::Graph::PropStereo>(*p.gPtr, inf);
-		} // end foreach product
-	} // end of stereo prop
+	if(products.empty()) MOD_ABORT; // continue;
 	// wrap them
 	for(auto &g : products) {
 		// check against the database
-		auto gCand = std::make_unique<lib::Graph::Single>(std::move(g.gPtr), std::move(g.pStringPtr), std::move(g.pStereoPtr));
+		auto gCand = std::make_unique<lib::Graph::Single>(std::move(g.g), std::move(g.pString), std::move(g.pStereo));
 		std::shared_ptr<graph::Graph> gWrapped = context.executionEnv.checkIfNew(std::move(gCand));
 		// checkIfNew does not add the graph, so we must check against the previous products as well
 		for(auto gPrev : d.right) {
@@ -258,7 +220,7 @@ void handleBoundRulePair(Context context, const BoundRule &brp) {
 		bool result = context.executionEnv.checkRightPredicate(d);
 		if(!result) {
 			if(getConfig().dg.calculatePredicatesVerbose.get())
-				IO::log() << indent << "Skipping " << r.getName() << " due to rightPredicate" << std::endl;
+				IO::log() << indent << "Skipping " << context.r->getName() << " due to rightPredicate" << std::endl;
 			return;
 		}
 	}
@@ -289,73 +251,169 @@ void handleBoundRulePair(Context context, const BoundRule &brp) {
 	}
 }
 
-template<typename GraphRange>
-unsigned int bindGraphs(Context context, const GraphRange &graphRange, const std::vector<BoundRule> &rules, std::vector<BoundRule>& outputRules) {
+// The composition only reads the input rules, but some of their properties are computed lazily.
+// Force them here, so the rules can be shared between threads during composition.
+void prepareForComposition(const lib::Rules::Real &r, LabelSettings labelSettings) {
+	const auto &dpoRule = r.getDPORule();
+	r.getStringState();
+	get_left(dpoRule);
+	get_molecule(dpoRule);
+	if(labelSettings.withStereo) get_stereo(dpoRule);
+}
+
+// the number of threads to use for composing rules with graphs
+unsigned int getNumCompositionThreads(LabelSettings labelSettings) {
+	const auto &config = getConfig();
+	// the parsing of terms and the verbose printing during composition are not thread safe
+	if(labelSettings.type == LabelType::Term) return 1;
+	if(config.rc.verbose.get() || config.rc.printMatches.get() || config.componentSG.verbose.get()) return 1;
+	// the detailed log prints the intermediary rules, whose names depend on the order they are created in
+	if(config.dg.calculateDetailsVerbose.get()) return 1;
+	return std::max(1u, config.common.numThreads.get());
+}
+
+std::vector<Binding> composeBoundRule(const lib::Graph::Single *g, const BoundRule &p, LabelSettings labelSettings,
+		lib::RC::ComponentMorphismCache *morphismCache) {
+	assert(p.rule);
+	// the graph rules and the input rule persist between binding rounds, but an intermediary rule is new in each round,
+	// so morphisms from it would never be used again, and caching them would only evict the useful entries
+	const bool isPersistent = p.boundGraphs.empty();
+	return bindGraph(*g, *p.rule, labelSettings, isPersistent ? morphismCache : nullptr);
+}
+
+// store the intermediary rules in order, and handle the complete derivations
+unsigned int commitBoundRule(Context context, const lib::Graph::Single *g, const BoundRule &p,
+		std::vector<Binding> composed, BoundRuleStorage &ruleStore) {
 	unsigned int processedRules = 0;
+	std::vector<const lib::Graph::Single*> educts;
+	for(auto &b : composed) {
+		if(b.rule && !b.rule->isOnlyRightSide()) {
+			if(context.executionEnv.doExit()) continue;
+			if(ruleStore.add(b.rule.release(), p, g)) processedRules++;
+			continue;
+		}
+		// complete derivations are not stored, so handle them right away
+		processedRules++;
+		if(context.executionEnv.doExit()) continue;
+		if(educts.empty()) {
+			educts = p.boundGraphs;
+			educts.push_back(g);
+		}
+		if(context.staged) context.staged->push_back(StagedDerivation{std::move(b), educts});
+		else handleBoundRulePair(context, std::move(b), educts);
+	}
+	return processedRules;
+}
+
+// The label fingerprints of the left components of each rule.
+// A graph can only be bound to a rule if at least one of the components has a monomorphism into it.
+// With term labels the fingerprints can not be used, and an empty vector is returned.
+std::vector<std::vector<lib::GraphMorphism::LabelFingerprint> > getLeftFingerprints(const std::vector<BoundRule> &rules, LabelSettings labelSettings) {
+	std::vector<std::vector<lib::GraphMorphism::LabelFingerprint> > res;
+	if(labelSettings.type != LabelType::String) return res;
+	const auto &strings = lib::Term::getStrings();
+	res.reserve(rules.size());
+	for(const BoundRule &p : rules) {
+		const auto lgLeft = get_labelled_left(p.rule->getDPORule());
+		const auto str = get_string(lgLeft);
+		const auto vertexLabel = [&](const auto v) -> lib::GraphMorphism::LabelFingerprint::LabelId {
+			return strings.getIndex(str[v]);
+		};
+		const auto edgeLabel = [&](const auto e) -> lib::GraphMorphism::LabelFingerprint::LabelId {
+			return strings.getIndex(str[e]);
+		};
+		res.emplace_back();
+		for(std::size_t i = 0; i < get_num_connected_components(lgLeft); i++)
+			res.back().emplace_back(get_component_graph(i, lgLeft), vertexLabel, edgeLabel);
+	}
+	return res;
+}
+
+bool canBind(const std::vector<std::vector<lib::GraphMorphism::LabelFingerprint> > &leftFingerprints, std::size_t ruleIndex, const lib::Graph::Single *g) {
+	if(leftFingerprints.empty()) return true;
+	const auto &host = g->getLabelFingerprint();
+	for(const auto &pattern : leftFingerprints[ruleIndex])
+		if(isSubsetOf(pattern, host)) return true;
+	return false;
+}
 
+template<typename GraphRange>
+unsigned int bindGraphs(Context context, const GraphRange &graphRange, const std::vector<BoundRule> &rules, std::vector<BoundRule>& outputRules,
+		std::size_t &numRejected) {
+	unsigned int processedRules = 0;
+	const auto leftFingerprints = getLeftFingerprints(rules, context.executionEnv.labelSettings);
+	BoundRuleStorage ruleStore(context.executionEnv.labelSettings.type, context.executionEnv.labelSettings.withStereo, outputRules);
 	for(const lib::Graph::Single *g : graphRange) {
 		if(context.executionEnv.doExit()) break;
-		for(const BoundRule &p : rules) {
+		for(std::size_t pIndex = 0; pIndex < rules.size(); pIndex++) {
+			const BoundRule &p = rules[pIndex];
 			if(context.executionEnv.doExit()) break;
-			if(getConfig().dg.calculateDetailsVerbose.get()) IO::log() << "NonHyperRuleComp\ttrying " << p.rule->getName() << " . " << g->getName() << std::endl;
-			std::vector<BoundRule> resultRules;
-			BoundRuleStorage ruleStore(context.executionEnv.labelSettings.type, context.executionEnv.labelSettings.withStereo, resultRules, p, g);
-			auto reporter = [&ruleStore] (std::unique_ptr<lib::Rules::Real> r) {
-				ruleStore.add(r.release());
-			};
-			assert(p.rule);
-			const lib::Rules::Real &rFirst = g->getBindRule()->getRule();
-			const lib::Rules::Real &rSecond = *p.rule;
-			lib::RC::Super mm(true, true);
-			lib::RC::composeRuleRealByMatchMaker(rFirst, rSecond, mm, reporter, context.executionEnv.labelSettings);
-			for(const BoundRule &brp : resultRules) {
-				processedRules++;
-				if(context.executionEnv.doExit()) delete brp.rule;
-				else if(brp.rule->isOnlyRightSide()) {
-					handleBoundRulePair(context, brp);
-					delete brp.rule;
-				} else outputRules.push_back(brp);
+			if(!canBind(leftFingerprints, pIndex, g)) {
+				numRejected++;
+				continue;
 			}
+			if(getConfig().dg.calculateDetailsVerbose.get()) IO::log() << "NonHyperRuleComp\ttrying " << p.rule->getName() << " . " << g->getName() << std::endl;
+			auto composed = composeBoundRule(g, p, context.executionEnv.labelSettings, context.executionEnv.getComponentMorphismCache());
+			processedRules += commitBoundRule(context, g, p, std::move(composed), ruleStore);
 		}
 	}
 	return processedRules;
 }
 
-} // namespace 
-
-void Rule::executeImpl(std::ostream &s, const GraphState &input) {
-	if(getExecutionEnv().labelSettings.withStereo) {
-		// let's trigger deduction errors early
-		try {
-			get_stereo(rRaw->getDPORule());
-		} catch(StereoDeductionError &e) {
-			std::stringstream ss;
-			ss << "\nStereo deduction error in rule '" << rRaw->getName() << "'.";
-			e.append(ss.str());
-			throw;
+// Does the same as bindGraphs, but the compositions of each batch of (graph, rule) pairs are done concurrently.
+// The results are committed in the same order as bindGraphs would do it, so the DG is the same.
+// Not used with dg.calculateDetailsVerbose, see getNumCompositionThreads.
+template<typename GraphRange>
+unsigned int bindGraphsParallel(Context context, const GraphRange &graphRange, const std::vector<BoundRule> &rules, std::vector<BoundRule>& outputRules,
+		std::size_t &numRejected, unsigned int numThreads) {
+	const auto labelSettings = context.executionEnv.labelSettings;
+	const auto morphismCache = context.executionEnv.getComponentMorphismCache();
+	const auto leftFingerprints = getLeftFingerprints(rules, labelSettings);
+	std::vector<std::pair<const lib::Graph::Single*, const BoundRule*> > tasks;
+	for(const lib::Graph::Single *g : graphRange) {
+		prepareForComposition(g->getBindRule()->getRule(), labelSettings);
+		for(std::size_t pIndex = 0; pIndex < rules.size(); pIndex++) {
+			if(canBind(leftFingerprints, pIndex, g)) tasks.emplace_back(g, &rules[pIndex]);
+			else numRejected++;
 		}
 	}
-	if(getExecutionEnv().labelSettings.type == LabelType::Term) {
-		const auto &term = get_term(rRaw->getDPORule());
-		if(!isValid(term)) {
-			std::string msg = "Parsing failed for rule '" + rRaw->getName() + "'. " + term.getParsingError();
-			throw TermParsingError(std::move(msg));
+	for(const BoundRule &p : rules) prepareForComposition(*p.rule, labelSettings);
+	// limit the number of uncommitted results, and stop composing soon after an exit has been requested
+	const std::size_t batchSize = std::size_t(numThreads) * 16;
+	unsigned int processedRules = 0;
+	BoundRuleStorage ruleStore(labelSettings.type, labelSettings.withStereo, outputRules);
+	for(std::size_t batchBegin = 0; batchBegin < tasks.size(); batchBegin += batchSize) {
+		if(context.executionEnv.doExit()) break;
+		const std::size_t batchEnd = std::min(tasks.size(), batchBegin + batchSize);
+		std::vector<std::vector<Binding> > composed(batchEnd - batchBegin);
+		parallelFor(numThreads, composed.size(), [&](std::size_t i) {
+			const auto &task = tasks[batchBegin + i];
+			composed[i] = composeBoundRule(task.first, *task.second, labelSettings, morphismCache);
+		});
+		for(std::size_t i = 0; i < composed.size(); i++) {
+			if(context.executionEnv.doExit()) break;
+			const auto &task = tasks[batchBegin + i];
+			processedRules += commitBoundRule(context, task.first, *task.second, std::move(composed[i]), ruleStore);
 		}
 	}
+	return processedRules;
+}
+
+template<typename GraphRange>
+unsigned int bindGraphs(Context context, const GraphRange &graphRange, const std::vector<BoundRule> &rules, std::vector<BoundRule>& outputRules,
+		std::size_t &numRejected, unsigned int numThreads) {
+	if(numThreads > 1) return bindGraphsParallel(context, graphRange, rules, outputRules, numRejected, numThreads);
+	else return bindGraphs(context, graphRange, rules, outputRules, numRejected);
+}
+
+void bindAll(Context context, const lib::Rules::Real *rRaw, const GraphState &input, unsigned int numThreads) {
 	const bool Verbose = getConfig().dg.calculateVerbose.get();
-	output = new GraphState(input.getUniverse());
-	if(Verbose) s << indent << "Rule: " << r->getName() << std::endl;
-	if(getExecutionEnv().doExit()) {
-		if(Verbose) s << indent << "(skipping)" << std::endl;
-		return;
-	}
 	std::vector<std::vector<BoundRule> > intermediaryRules(rRaw->getDPORule().numLeftComponents + 1);
 	{
 		BoundRule p;
 		p.rule = rRaw;
 		intermediaryRules[0].push_back(p);
 	}
-	Context context{r, getExecutionEnv(), output, consumedGraphs};
 	const auto &subset = input.getSubset(0);
 	const auto &universe = input.getUniverse();
 	for(unsigned int i = 1; i <= rRaw->getDPORule().numLeftComponents; i++) {
@@ -373,26 +431,107 @@ void Rule::executeImpl(std::ostream &s, const GraphState &input) {
 		}
 
 		std::size_t processedRules = 0;
+		std::size_t numRejected = 0;
 		if(i == 1) {
 			if(!getConfig().dg.ignoreSubset.get()) {
-				processedRules = bindGraphs(context, subset, intermediaryRules[0], intermediaryRules[1]);
+				processedRules = bindGraphs(context, subset, intermediaryRules[0], intermediaryRules[1], numRejected, numThreads);
 			} else {
-				processedRules = bindGraphs(context, universe, intermediaryRules[0], intermediaryRules[1]);
+				processedRules = bindGraphs(context, universe, intermediaryRules[0], intermediaryRules[1], numRejected, numThreads);
 			}
 		} else {
-			processedRules = bindGraphs(context, universe, intermediaryRules[i - 1], intermediaryRules[i]);
+			processedRules = bindGraphs(context, universe, intermediaryRules[i - 1], intermediaryRules[i], numRejected, numThreads);
 			for(BoundRule &p : intermediaryRules[i - 1]) {
 				delete p.rule;
 				p.rule = nullptr;
 			}
 		}
-		if(Verbose)
+		if(Verbose) {
 			IO::log() << indent << "Processing of " << processedRules << " intermediary rules done" << std::endl;
+			IO::log() << indent << "Rejected " << numRejected << " (graph, rule) pairs by label fingerprints" << std::endl;
+		}
 		if(context.executionEnv.doExit()) break;
 	}
 	assert(intermediaryRules.back().empty());
 }
 
+} // namespace 
+
+struct Rule::Staged {
+	std::size_t inputGeneration;
+	std::vector<StagedDerivation> derivations;
+};
+
+Rule::~Rule() { }
+
+bool Rule::canStage(LabelSettings labelSettings) {
+	const auto &config = getConfig();
+	// the verbose printing during binding is not thread safe
+	if(config.dg.calculateVerbose.get() || config.dg.calculateDetailsVerbose.get()) return false;
+	return getNumCompositionThreads(labelSettings) > 1;
+}
+
+void Rule::prepareStaging(const GraphState &input) {
+	checkRule();
+	const auto labelSettings = getExecutionEnv().labelSettings;
+	prepareForComposition(*rRaw, labelSettings);
+	for(const lib::Graph::Single *g : input.getUniverse())
+		prepareForComposition(g->getBindRule()->getRule(), labelSettings);
+}
+
+void Rule::stage(const GraphState &input) {
+	auto res = std::make_unique<Staged>();
+	res->inputGeneration = input.getGeneration();
+	if(!getExecutionEnv().doExit()) {
+		Context context{r, getExecutionEnv(), nullptr, consumedGraphs, &res->derivations};
+		bindAll(context, rRaw, input, 1);
+	}
+	staged = std::move(res);
+}
+
+void Rule::checkRule() {
+	if(getExecutionEnv().labelSettings.withStereo) {
+		// let's trigger deduction errors early
+		try {
+			get_stereo(rRaw->getDPORule());
+		} catch(StereoDeductionError &e) {
+			std::stringstream ss;
+			ss << "\nStereo deduction error in rule '" << rRaw->getName() << "'.";
+			e.append(ss.str());
+			throw;
+		}
+	}
+	if(getExecutionEnv().labelSettings.type == LabelType::Term) {
+		const auto &term = get_term(rRaw->getDPORule());
+		if(!isValid(term)) {
+			std::string msg = "Parsing failed for rule '" + rRaw->getName() + "'. " + term.getParsingError();
+			throw TermParsingError(std::move(msg));
+		}
+	}
+}
+
+void Rule::executeImpl(std::ostream &s, const GraphState &input) {
+	checkRule();
+	// results staged for another input, or for the same one before it was modified, are stale
+	auto stagedResults = std::move(staged);
+	if(stagedResults && stagedResults->inputGeneration != input.getGeneration()) stagedResults.reset();
+	const bool Verbose = getConfig().dg.calculateVerbose.get();
+	output = new GraphState(input.getUniverse());
+	if(Verbose) s << indent << "Rule: " << r->getName() << std::endl;
+	if(getExecutionEnv().doExit()) {
+		if(Verbose) s << indent << "(skipping)" << std::endl;
+		return;
+	}
+	Context context{r, getExecutionEnv(), output, consumedGraphs, nullptr};
+	if(stagedResults) {
+		for(StagedDerivation &d : stagedResults->derivations) {
+			if(getExecutionEnv().doExit()) break;
+			handleBoundRulePair(context, std::move(d.binding), d.educts);
+		}
+	} else {
+		bindAll(context, rRaw, input, getNumCompositionThreads(getExecutionEnv().labelSettings));
+	}
+}
+
 } // namespace Strategies
 } // namespace DG
 } // namespace lib
@@ -3,6 +3,7 @@
 
 #include <mod/lib/DG/Strategies/Strategy.h>
 
+#include <memory>
 #include <unordered_set>
 
 namespace mod {
@@ -13,17 +14,29 @@ namespace Strategies {
 struct Rule : Strategy {
 	Rule(std::shared_ptr<rule::Rule> r);
 	Rule(const lib::Rules::Real *r);
+	~Rule();
 	Strategy *clone() const override;
 	void preAddGraphs(std::function<void(std::shared_ptr<graph::Graph>) > add) const;
 	void forEachRule(std::function<void(const lib::Rules::Real&)> f) const;
 	void printInfo(std::ostream &s) const override;
 	bool isConsumed(const lib::Graph::Single *g) const override;
+public:
+	// Finding the derivations does not change the derivation graph, only adding them does,
+	// so the first part can be staged ahead of execution, e.g., concurrently with other rule strategies.
+	// The staging must be prepared from the executing thread, and the next execute with the same, unmodified input
+	// adds the staged derivations, in the same order as an unstaged execution would.
+	static bool canStage(LabelSettings labelSettings);
+	void prepareStaging(const GraphState &input);
+	void stage(const GraphState &input);
 private:
+	void checkRule();
 	void executeImpl(std::ostream &s, const GraphState &input) override;
 private:
 	std::shared_ptr<rule::Rule> r;
 	const lib::Rules::Real *rRaw;
 	std::unordered_set<const lib::Graph::Single*> consumedGraphs; // all those from lhs of derivations
+	struct Staged;
+	std::unique_ptr<Staged> staged;
 };
 
 } // namespace Strategies
@@ -0,0 +1,279 @@
+#include "RuleBinding.h"
+
+#include <mod/Error.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/Graph/Single.h>
+#include <mod/lib/RC/ComposeRuleReal.h>
+#include <mod/lib/RC/ComposeRuleRealGeneric.h>
+#include <mod/lib/RC/MatchMaker/Super.h>
+#include <mod/lib/Stereo/CloneUtil.h>
+#include <mod/lib/Term/WAM.h>
+
+#include <boost/optional.hpp>
+
+#include <cassert>
+#include <numeric>
+
+namespace mod {
+namespace lib {
+namespace DG {
+namespace Strategies {
+namespace {
+
+using Membership = jla_boost::GraphDPO::Membership;
+using LabelId = lib::Graph::PropString::LabelId;
+
+template<typename VertexMap>
+bool isCompleteMatch(const lib::Rules::Real &rFirst, const lib::Rules::Real &rSecond, const VertexMap &m) {
+	const auto &gDom = get_graph(get_labelled_left(rSecond.getDPORule()));
+	const auto &gCodom = get_graph(get_labelled_right(rFirst.getDPORule()));
+	const auto vNullCodom = boost::graph_traits<lib::Rules::SideGraphType>::null_vertex();
+	for(const auto vDom : asRange(vertices(gDom)))
+		if(get(m, gDom, gCodom, vDom) == vNullCodom) return false;
+	return true;
+}
+
+std::size_t findRoot(std::vector<std::size_t> &parent, std::size_t v) {
+	while(parent[v] != v) {
+		parent[v] = parent[parent[v]];
+		v = parent[v];
+	}
+	return v;
+}
+
+// The pushout of gHost and rSecond for a match of the complete left side of rSecond into the bind rule rFirst of gHost.
+// The result is the right side of the composition of rFirst and rSecond, see RC::detail::CompositionHelper,
+// with the vertices and edges in the same order, and none is returned exactly when that composition fails, i.e.,
+// when a deleted vertex would leave a dangling edge, or when an edge would be created in parallel to an existing edge.
+// The vertices and edges of the core graph of rFirst have the same indices as those of gHost.
+
+boost::optional<std::vector<ProductGraph> > rewrite(const lib::Graph::Single &gHost, const lib::Rules::Real &rFirst,
+		const lib::Rules::Real &rSecond, const lib::RC::Super::VertexMapType &m) {
+	const auto &dpoFirst = rFirst.getDPORule();
+	const auto &dpoSecond = rSecond.getDPORule();
+	const auto &gFirst = get_graph(dpoFirst);
+	const auto &gSecond = get_graph(dpoSecond);
+	const auto &gDom = get_graph(get_labelled_left(dpoSecond));
+	const auto &gCodom = get_graph(get_labelled_right(dpoFirst));
+	const auto &g = gHost.getGraph();
+	const auto &pHost = gHost.getStringState();
+	const auto &pSecond = *dpoSecond.pString;
+	const auto &strings = lib::Term::getStrings();
+	const auto vNullDom = boost::graph_traits<lib::Rules::SideGraphType>::null_vertex();
+	const std::size_t NoVertex = -1;
+	assert(num_vertices(g) == num_vertices(gFirst));
+	assert(num_edges(g) == num_edges(gFirst));
+
+	// the vertices of the result, numbered in the order the composition creates them
+	std::vector<LabelId> vertexLabels;
+	vertexLabels.reserve(num_vertices(gFirst) + num_vertices(gSecond));
+	std::vector<std::size_t> firstToResult(num_vertices(gFirst), NoVertex), secondToResult(num_vertices(gSecond), NoVertex);
+	for(const auto vFirst : asRange(vertices(gFirst))) {
+		const auto vFirstId = get(boost::vertex_index_t(), gFirst, vFirst);
+		const auto vSecond = get_inverse(m, gDom, gCodom, vFirst);
+		if(vSecond == vNullDom) {
+			firstToResult[vFirstId] = vertexLabels.size();
+			vertexLabels.push_back(pHost.getId(vertex(vFirstId, g)));
+			continue;
+		}
+		// matched with a vertex only in the left side, so it is deleted
+		if(membership(dpoSecond, vSecond) == Membership::Left) continue;
+		firstToResult[vFirstId] = vertexLabels.size();
+		secondToResult[get(boost::vertex_index_t(), gSecond, vSecond)] = vertexLabels.size();
+		vertexLabels.push_back(static_cast<LabelId>(strings.getIndex(pSecond.getRight()[vSecond])));
+	}
+	for(const auto vSecond : asRange(vertices(gSecond))) {
+		// the complete left side is matched, so only the created vertices remain
+		if(membership(dpoSecond, vSecond) != Membership::Right) continue;
+		secondToResult[get(boost::vertex_index_t(), gSecond, vSecond)] = vertexLabels.size();
+		vertexLabels.push_back(static_cast<LabelId>(strings.getIndex(pSecond.getRight()[vSecond])));
+	}
+
+	struct ResultEdge {
+		std::size_t src, tar;
+		LabelId label;
+	};
+	std::vector<ResultEdge> resultEdges;
+	resultEdges.reserve(num_edges(gFirst) + num_edges(gSecond));
+	auto eHostIter = edges(g).first;
+	for(const auto eFirst : asRange(edges(gFirst))) {
+		const auto eHost = *eHostIter;
+		++eHostIter;
+		assert(get(boost::edge_index_t(), gFirst, eFirst) == get(boost::edge_index_t(), g, eHost));
+		const auto vSrcFirst = source(eFirst, gFirst);
+		const auto vTarFirst = target(eFirst, gFirst);
+		const auto vSrcSecond = get_inverse(m, gDom, gCodom, vSrcFirst);
+		const auto vTarSecond = get_inverse(m, gDom, gCodom, vTarFirst);
+		if(vSrcSecond != vNullDom && vTarSecond != vNullDom) {
+			const auto oeSecond = out_edges(vSrcSecond, gSecond);
+			const bool isEdgeMatched = std::any_of(oeSecond.first, oeSecond.second, [&](const auto eSecond) {
+				return target(eSecond, gSecond) == vTarSecond && membership(dpoSecond, eSecond) != Membership::Right;
+			});
+			// handled with the edges of rSecond
+			if(isEdgeMatched) continue;
+		}
+		const auto vSrcResult = firstToResult[get(boost::vertex_index_t(), gFirst, vSrcFirst)];
+		const auto vTarResult = firstToResult[get(boost::vertex_index_t(), gFirst, vTarFirst)];
+		// an unmatched edge would be dangling
+		if(vSrcResult == NoVertex || vTarResult == NoVertex) return boost::none;
+		resultEdges.push_back(ResultEdge{vSrcResult, vTarResult, pHost.getId(eHost)});
+	}
+	for(const auto eSecond : asRange(edges(gSecond))) {
+		const auto meSecond = membership(dpoSecond, eSecond);
+		// the edge is matched and deleted
+		if(meSecond == Membership::Left) continue;
+		const auto vSrcSecond = source(eSecond, gSecond);
+		const auto vTarSecond = target(eSecond, gSecond);
+		const bool isSrcMatched = membership(dpoSecond, vSrcSecond) != Membership::Right;
+		const bool isTarMatched = membership(dpoSecond, vTarSecond) != Membership::Right;
+		if(meSecond == Membership::Right && isSrcMatched && isTarMatched) {
+			const auto vSrcFirst = get(m, gDom, gCodom, vSrcSecond);
+			const auto vTarFirst = get(m, gDom, gCodom, vTarSecond);
+			// the created edge would be parallel to an existing one
+			if(edge(vSrcFirst, vTarFirst, gFirst).second) return boost::none;
+		}
+		const auto vSrcResult = secondToResult[get(boost::vertex_index_t(), gSecond, vSrcSecond)];
+		const auto vTarResult = secondToResult[get(boost::vertex_index_t(), gSecond, vTarSecond)];
+		if(vSrcResult == NoVertex || vTarResult == NoVertex) return boost::none;
+		resultEdges.push_back(ResultEdge{vSrcResult, vTarResult, static_cast<LabelId>(strings.getIndex(pSecond.getRight()[eSecond]))});
+	}
+
+	// split into connected components, numbered by their first vertex
+	std::vector<std::size_t> parent(vertexLabels.size());
+	std::iota(parent.begin(), parent.end(), 0);
+	for(const auto &e : resultEdges)
+		parent[findRoot(parent, e.src)] = findRoot(parent, e.tar);
+	std::vector<std::size_t> component(vertexLabels.size(), NoVertex), rootComponent(vertexLabels.size(), NoVertex);
+	std::size_t numComponents = 0;
+	for(std::size_t v = 0; v < vertexLabels.size(); ++v) {
+		auto &comp = rootComponent[findRoot(parent, v)];
+		if(comp == NoVertex) comp = numComponents++;
+		component[v] = comp;
+	}
+	std::vector<ProductGraph> products(numComponents);
+	std::vector<lib::Graph::Vertex> resultToProduct(vertexLabels.size());
+	for(std::size_t v = 0; v < vertexLabels.size(); ++v) {
+		auto &p = products[component[v]];
+		resultToProduct[v] = add_vertex(*p.g);
+		p.pString->addVertex(resultToProduct[v], vertexLabels[v]);
+	}
+	for(const auto &e : resultEdges) {
+		auto &p = products[component[e.src]];
+		const auto ep = add_edge(resultToProduct[e.src], resultToProduct[e.tar], *p.g);
+		assert(ep.second);
+		p.pString->addEdge(ep.first, e.label);
+	}
+	return std::move(products);
+}
+
+struct BindingCallback {
+
+	BindingCallback(const lib::Graph::Single &g, std::vector<Binding> &results) : g(g), results(results) { }
+
+	// string labels without stereo
+
+	bool operator()(const lib::Rules::Real &rFirst, const lib::Rules::Real &rSecond, lib::RC::Super::VertexMapType &&m) const {
+		if(!isCompleteMatch(rFirst, rSecond, m)) return compose(rFirst, rSecond, std::move(m));
+		auto products = rewrite(g, rFirst, rSecond, m);
+		if(products) results.push_back(Binding{nullptr, std::move(*products)});
+		return true;
+	}
+
+	template<typename VertexMap>
+	bool operator()(const lib::Rules::Real &rFirst, const lib::Rules::Real &rSecond, VertexMap &&m) const {
+		return compose(rFirst, rSecond, std::move(m));
+	}
+private:
+
+	template<typename VertexMap>
+	bool compose(const lib::Rules::Real &rFirst, const lib::Rules::Real &rSecond, VertexMap &&m) const {
+		auto &results = this->results;
+		const auto callback = lib::RC::detail::MatchMakerCallback([&results](std::unique_ptr<lib::Rules::Real> r) {
+			results.push_back(Binding{std::move(r),{}});
+		});
+		return callback(rFirst, rSecond, std::move(m));
+	}
+private:
+	const lib::Graph::Single &g;
+	std::vector<Binding> &results;
+};
+
+} // namespace
+
+std::vector<Binding> bindGraph(const lib::Graph::Single &g, const lib::Rules::Real &r, LabelSettings labelSettings,
+		lib::RC::ComponentMorphismCache *morphismCache) {
+	std::vector<Binding> results;
+	const lib::Rules::Real &rFirst = g.getBindRule()->getRule();
+	lib::RC::Super mm(true, true, morphismCache);
+	const auto &config = getConfig();
+	// the verbose composition also prints the compositions of complete matches
+	const bool rewriteDirectly = config.dg.rewriteDirectly.get()
+			&& labelSettings.type == LabelType::String && !labelSettings.withStereo
+			&& !config.rc.verbose.get() && !config.rc.printMatches.get();
+	if(rewriteDirectly) {
+		mm.makeMatches(rFirst, r, BindingCallback(g, results), labelSettings);
+	} else {
+		lib::RC::composeRuleRealByMatchMaker(rFirst, r, mm, [&results](std::unique_ptr<lib::Rules::Real> rNew) {
+			results.push_back(Binding{std::move(rNew),{}});
+		}, labelSettings);
+	}
+	return results;
+}
+
+std::vector<ProductGraph> splitRightSide(const lib::Rules::LabelledRule &rDPO, bool withStereo) {
+	using Vertex = lib::Graph::Vertex;
+	std::vector<ProductGraph> products(rDPO.numRightComponents);
+	std::vector<std::vector<lib::Rules::Vertex> > productToSide(rDPO.numRightComponents);
+	const auto &compMap = rDPO.rightComponents;
+	const auto &gRight = get_right(rDPO);
+	auto rpString = get_string(get_labelled_right(rDPO));
+	assert(num_vertices(gRight) == num_vertices(get_graph(rDPO)));
+	std::vector<Vertex> vertexMap(num_vertices(gRight));
+	for(const auto vSide : asRange(vertices(gRight))) {
+		const auto comp = compMap[get(boost::vertex_index_t(), gRight, vSide)];
+		auto &p = products[comp];
+		const auto v = add_vertex(*p.g);
+		vertexMap[get(boost::vertex_index_t(), gRight, vSide)] = v;
+		p.pString->addVertex(v, rpString[vSide]);
+		productToSide[comp].push_back(vSide);
+	}
+	for(const auto eSide : asRange(edges(gRight))) {
+		const auto vSideSrc = source(eSide, gRight);
+		const auto vSideTar = target(eSide, gRight);
+		const auto comp = compMap[get(boost::vertex_index_t(), gRight, vSideSrc)];
+		assert(comp == compMap[get(boost::vertex_index_t(), gRight, vSideTar)]);
+		const auto vCompSrc = vertexMap[get(boost::vertex_index_t(), gRight, vSideSrc)];
+		const auto vCompTar = vertexMap[get(boost::vertex_index_t(), gRight, vSideTar)];
+		const auto epComp = add_edge(vCompSrc, vCompTar, *products[comp].g);
+		assert(epComp.second);
+		products[comp].pString->addEdge(epComp.first, rpString[eSide]);
+	}
+	if(withStereo && has_stereo(rDPO)) {
+		const auto &lgRight = get_labelled_right(rDPO);
+		assert(has_stereo(lgRight));
+		for(std::size_t comp = 0; comp < products.size(); ++comp) {
+			auto &p = products[comp];
+			const auto &sideVertices = productToSide[comp];
+			const auto vertexMap = [&p, &sideVertices](const auto &vProduct) {
+				return sideVertices[get(boost::vertex_index_t(), *p.g, vProduct)];
+			};
+			const auto edgeMap = [&p, &sideVertices, &lgRight](const auto &eProduct) {
+				const auto &g = *p.g;
+				const auto &gSide = get_graph(lgRight);
+				const auto vSrcSide = sideVertices[get(boost::vertex_index_t(), g, source(eProduct, g))];
+				const auto vTarSide = sideVertices[get(boost::vertex_index_t(), g, target(eProduct, g))];
+				const auto epSide = edge(vSrcSide, vTarSide, gSide);
+				assert(epSide.second);
+				return epSide.first;
+			};
+			const auto inf = Stereo::makeCloner(lgRight, *p.g, vertexMap, edgeMap);
+			p.pStereo = std::make_unique<lib::Graph::PropStereo>(*p.g, inf);
+		}
+	}
+	return products;
+}
+
+} // namespace Strategies
+} // namespace DG
+} // namespace lib
+} // namespace mod
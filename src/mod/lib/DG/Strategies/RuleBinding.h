@@ -0,0 +1,60 @@
+#ifndef MOD_LIB_DG_STRATEGIES_RULEBINDING_H
+#define MOD_LIB_DG_STRATEGIES_RULEBINDING_H
+
+#include <mod/Config.h>
+#include <mod/lib/Graph/GraphDecl.h>
+#include <mod/lib/Graph/Properties/Stereo.h>
+#include <mod/lib/Graph/Properties/String.h>
+#include <mod/lib/Rules/Real.h>
+
+#include <memory>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace Graph {
+struct Single;
+} // namespace Graph
+namespace RC {
+struct ComponentMorphismCache;
+} // namespace RC
+namespace DG {
+namespace Strategies {
+
+// A graph created by a derivation, before it is wrapped and checked against the database.
+
+struct ProductGraph {
+
+	ProductGraph() : g(new lib::Graph::GraphType()), pString(new lib::Graph::PropString(*g)) { }
+public:
+	std::unique_ptr<lib::Graph::GraphType> g;
+	std::unique_ptr<lib::Graph::PropString> pString;
+	std::unique_ptr<lib::Graph::PropStereo> pStereo;
+};
+
+// The result of binding a graph to a rule with a single match.
+// Either rule is the composition of the bind rule of the graph and the rule,
+// which is an intermediary rule if it still has a left side,
+// or the complete left side was matched and rewritten directly, and the products are given.
+
+struct Binding {
+	std::unique_ptr<lib::Rules::Real> rule;
+	std::vector<ProductGraph> products;
+};
+
+// Binds g to r with each match of a non-empty subset of the left components of r into g.
+// With string labels and without stereo, the matches of the complete left side are rewritten directly,
+// i.e., the products are constructed from g and r without composing the bind rule of g and r.
+// The morphism cache is used for the component morphisms, if it is not null.
+std::vector<Binding> bindGraph(const lib::Graph::Single &g, const lib::Rules::Real &r, LabelSettings labelSettings,
+		lib::RC::ComponentMorphismCache *morphismCache);
+
+// Splits the right side of a rule without a left side into its connected components.
+std::vector<ProductGraph> splitRightSide(const lib::Rules::LabelledRule &rDPO, bool withStereo);
+
+} // namespace Strategies
+} // namespace DG
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_DG_STRATEGIES_RULEBINDING_H */
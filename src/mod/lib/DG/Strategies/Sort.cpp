@@ -44,16 +44,7 @@ void Sort::executeImpl(std::ostream &s, const GraphState &input) {
 	}
 
 	assert(!output);
-	dg::Strategy::GraphState gs(
-			[&input](std::vector<std::shared_ptr<graph::Graph> > &subset) {
-				for(const lib::Graph::Single *g : input.getSubset(0)) subset.push_back(g->getAPIReference());
-			},
-	[&input](std::vector<std::shared_ptr<graph::Graph> > &universe) {
-		for(const lib::Graph::Single *g : input.getUniverse()) universe.push_back(g->getAPIReference());
-	},
-	[this](std::vector<dg::DG::HyperEdge> &edges) {
-		getExecutionEnv().fillHyperEdges(edges);
-	});
+	const auto gs = makeAPIGraphState(input);
 	auto comp = [&gs, this](const lib::Graph::Single *g1, const lib::Graph::Single * g2) -> bool {
 		return (*less)(g1->getAPIReference(), g2->getAPIReference(), gs);
 	};
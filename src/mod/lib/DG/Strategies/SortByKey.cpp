@@ -0,0 +1,102 @@
+#include "SortByKey.h"
+
+#include <mod/Config.h>
+#include <mod/Function.h>
+#include <mod/lib/DG/Strategies/GraphState.h>
+#include <mod/lib/Graph/Single.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace DG {
+namespace Strategies {
+
+namespace {
+
+bool keyLess(const std::string &a, const std::string &b) {
+	return a < b;
+}
+
+// NaN is not ordered by <, which would break the sorting, so it is placed after all other keys
+bool keyLess(double a, double b) {
+	if(std::isnan(b)) return !std::isnan(a);
+	return a < b;
+}
+
+} // namespace
+
+template<typename Key>
+SortByKey<Key>::SortByKey(std::shared_ptr<KeyFunction> key, bool doUniverse)
+: Strategy(0), key(key), doUniverse(doUniverse) { }
+
+template<typename Key>
+Strategy *SortByKey<Key>::clone() const {
+	return new SortByKey(key->clone(), doUniverse);
+}
+
+template<typename Key>
+void SortByKey<Key>::preAddGraphs(std::function<void(std::shared_ptr<graph::Graph>) > add) const { }
+
+template<typename Key>
+void SortByKey<Key>::printInfo(std::ostream &s) const {
+	s << indent << "SortByKey";
+	if(doUniverse) s << " universe";
+	s << std::endl;
+	indentLevel++;
+	s << indent << "key function = ";
+	key->print(s);
+	s << std::endl;
+	printBaseInfo(s);
+	indentLevel--;
+}
+
+template<typename Key>
+bool SortByKey<Key>::isConsumed(const lib::Graph::Single *g) const {
+	return false;
+}
+
+template<typename Key>
+void SortByKey<Key>::executeImpl(std::ostream &s, const GraphState &input) {
+	if(getConfig().dg.calculateVerbose.get()) {
+		s << "SortByKey: ";
+		key->print(s);
+		s << std::endl;
+		indentLevel++;
+	}
+
+	assert(!output);
+	const auto gs = makeAPIGraphState(input);
+	// evaluate the key function once for each graph to be sorted, and sort the (key, graph) pairs
+	std::vector<std::pair<Key, const lib::Graph::Single*> > keyed;
+	const auto addKey = [&](const lib::Graph::Single *g) {
+		keyed.emplace_back((*key)(g->getAPIReference(), gs), g);
+	};
+	if(doUniverse) for(const lib::Graph::Single *g : input.getUniverse()) addKey(g);
+	else for(const lib::Graph::Single *g : input.getSubset(0)) addKey(g);
+	std::stable_sort(keyed.begin(), keyed.end(), [](const auto &a, const auto &b) {
+		return keyLess(a.first, b.first);
+	});
+	GraphState::GraphList order;
+	order.reserve(keyed.size());
+	for(const auto &p : keyed) order.push_back(p.second);
+
+	output = new GraphState(input);
+	assert(output->hasSubset(0));
+	assert(output->getSubsets().size() == 1);
+	if(doUniverse) output->setUniverseOrder(order);
+	else output->setSubsetOrder(0, order);
+	if(getConfig().dg.calculateVerbose.get()) indentLevel--;
+}
+
+template struct SortByKey<double>;
+template struct SortByKey<std::string>;
+
+} // namespace Strategies
+} // namespace DG
+} // namespace lib
+} // namespace mod
@@ -0,0 +1,38 @@
+#ifndef MOD_LIB_DG_STRATEGIES_SORTBYKEY_H
+#define MOD_LIB_DG_STRATEGIES_SORTBYKEY_H
+
+#include <mod/dg/Strategies.h>
+#include <mod/lib/DG/Strategies/Strategy.h>
+
+namespace mod {
+namespace lib {
+namespace DG {
+namespace Strategies {
+
+// Sorts by a key which is computed once for each graph, instead of calling a comparator for each comparison.
+// The sort is stable, and Key must be double or std::string. Keys which are NaN are placed last.
+
+template<typename Key>
+struct SortByKey : Strategy {
+	using KeyFunction = mod::Function<Key(std::shared_ptr<graph::Graph>, const dg::Strategy::GraphState&)>;
+public:
+	SortByKey(std::shared_ptr<KeyFunction> key, bool doUniverse);
+	Strategy *clone() const;
+	void preAddGraphs(std::function<void(std::shared_ptr<graph::Graph>) > add) const;
+
+	void forEachRule(std::function<void(const lib::Rules::Real&) > f) const { }
+	void printInfo(std::ostream &s) const;
+	bool isConsumed(const lib::Graph::Single *g) const;
+private:
+	void executeImpl(std::ostream &s, const GraphState &input);
+private:
+	std::shared_ptr<KeyFunction> key;
+	const bool doUniverse;
+};
+
+} // namespace Strategies
+} // namespace DG
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_DG_STRATEGIES_SORTBYKEY_H */
@@ -42,6 +42,19 @@ ExecutionEnv &Strategy::getExecutionEnv() {
 	return *env;
 }
 
+dg::Strategy::GraphState Strategy::makeAPIGraphState(const GraphState &state) {
+	return dg::Strategy::GraphState(
+			[&state](std::vector<std::shared_ptr<graph::Graph> > &subset) {
+				for(const lib::Graph::Single *g : state.getSubset(0)) subset.push_back(g->getAPIReference());
+			},
+	[&state](std::vector<std::shared_ptr<graph::Graph> > &universe) {
+		for(const lib::Graph::Single *g : state.getUniverse()) universe.push_back(g->getAPIReference());
+	},
+	[this]() -> const std::vector<dg::DG::HyperEdge>& {
+		return getExecutionEnv().getHyperEdges();
+	});
+}
+
 void Strategy::printBaseInfo(std::ostream &s) const {
 	s << indent << "input:" << std::endl;
 	indentLevel++;
@@ -4,11 +4,17 @@
 #include <mod/dg/Strategies.h>
 #include <mod/lib/DG/NonHyper.h>
 
+#include <boost/optional/optional.hpp>
+
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace mod {
 namespace lib {
+namespace RC {
+struct ComponentMorphismCache;
+} // namespace RC
 namespace DG {
 namespace Strategies {
 class GraphState;
@@ -36,7 +42,21 @@ struct ExecutionEnv {
 	virtual void popLeftPredicate() = 0;
 	virtual void popRightPredicate() = 0;
 public:
-	virtual void fillHyperEdges(std::vector<dg::DG::HyperEdge> &edges) const = 0;
+	// all edges in the derivation graph so far, the list is only valid until the graph changes
+	virtual const std::vector<dg::DG::HyperEdge> &getHyperEdges() const = 0;
+	// may return null, in which case no caching should be done
+	virtual lib::RC::ComponentMorphismCache *getComponentMorphismCache() = 0;
+public:
+	// Repeat strategies which are not nested in other Repeat strategies are numbered in the order they are executed,
+	// and their state may be checkpointed after each iteration.
+	// returns the number of the Repeat strategy starting execution, or none if it is nested
+	virtual boost::optional<std::size_t> enterRepeat() = 0;
+	// must be called once for each call to enterRepeat, also for nested Repeat strategies
+	virtual void leaveRepeat() = 0;
+	// returns the state to continue the given Repeat from, or null if it should start from the beginning
+	virtual std::unique_ptr<GraphState> resumeRepeat(std::size_t repeatId, std::size_t &numIterations, bool &finished) = 0;
+	// state is the input for the next iteration, or the output if finished
+	virtual void checkpointRepeat(std::size_t repeatId, std::size_t numIterations, bool finished, const GraphState &state) = 0;
 public:
 	const LabelSettings labelSettings;
 };
@@ -58,6 +78,8 @@ struct Strategy {
 protected:
 	ExecutionEnv &getExecutionEnv();
 	void printBaseInfo(std::ostream &s) const;
+	// the state given to user functions, with the subset 0 and universe of the given state
+	dg::Strategy::GraphState makeAPIGraphState(const GraphState &state);
 private:
 	virtual void setExecutionEnvImpl();
 	virtual void executeImpl(std::ostream &s, const GraphState &input) = 0;
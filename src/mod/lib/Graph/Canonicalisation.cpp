@@ -1,7 +1,11 @@
 #include "Canonicalisation.h"
 
 #include <mod/lib/Graph/Properties/Molecule.h>
+#include <mod/lib/Graph/Properties/Stereo.h>
 #include <mod/lib/Graph/Properties/String.h>
+#include <mod/lib/Graph/Properties/Term.h>
+#include <mod/lib/GraphMorphism/StereoVertexMap.h>
+#include <mod/lib/Term/WAM.h>
 
 #include <graph_canon/aut/implicit_size_2.hpp>
 #include <graph_canon/aut/pruner_basic.hpp>
@@ -22,6 +26,7 @@
 #include <perm_group/permutation/built_in.hpp>
 
 #include <jla_boost/graph/PairToRangeAdaptor.hpp>
+#include <jla_boost/graph/morphism/models/Vector.hpp>
 
 #include <boost/graph/graph_utility.hpp> // for boost::print_graph
 
@@ -32,6 +37,33 @@ namespace lib {
 namespace Graph {
 namespace {
 
+void appendTermKey(const lib::Term::Wam &machine, lib::Term::Address addr, std::vector<std::size_t> &key) {
+	addr = machine.deref(addr);
+	const auto &cell = machine.getCell(addr);
+	switch(cell.getTag()) {
+	case lib::Term::CellTag::REF:
+		MOD_ABORT; // only ground terms are keyed
+	case lib::Term::CellTag::Structure:
+		key.push_back(cell.getArity());
+		key.push_back(cell.getName());
+		for(std::size_t i = 1; i <= cell.getArity(); ++i)
+			appendTermKey(machine, addr + i, key);
+		break;
+	case lib::Term::CellTag::STR:
+		MOD_ABORT; // should have been dereferenced
+	}
+}
+
+} // namespace
+
+std::vector<std::size_t> getTermKey(const lib::Term::Wam &machine, std::size_t addr) {
+	std::vector<std::size_t> key;
+	appendTermKey(machine, lib::Term::Address{lib::Term::AddressType::Heap, addr}, key);
+	return key;
+}
+
+namespace {
+
 void printGraph(std::ostream &s, const auto &lg, const auto &g, const auto &idx) {
 	for(const auto v : asRange(vertices(g))) {
 		s << idx[v] << "(" << get(boost::vertex_index_t(), get_graph(lg), v) << ")("
@@ -498,6 +530,31 @@ private:
 	const LabelledGraph &lg;
 };
 
+// The vertex colours used in addition to the string labels.
+// For terms it is the term keys, and for stereo the local properties of the configurations are appended.
+std::vector<std::vector<std::size_t> > getVertexKeys(const Single &g, LabelType labelType, bool withStereo) {
+	const auto &lg = g.getLabelledGraph();
+	const auto &graph = get_graph(lg);
+	std::vector<std::vector<std::size_t> > keys(num_vertices(graph));
+	if(labelType == LabelType::Term) {
+		const auto &term = get_term(lg);
+		const auto &machine = getMachine(term);
+		for(const auto v : asRange(vertices(graph)))
+			keys[get(boost::vertex_index_t(), graph, v)] = getTermKey(machine, term[v]);
+	}
+	if(withStereo) {
+		const auto &stereo = get_stereo(lg);
+		for(const auto v : asRange(vertices(graph))) {
+			const auto &conf = *stereo[v];
+			auto &key = keys[get(boost::vertex_index_t(), graph, v)];
+			key.push_back(conf.getGeometryVertex());
+			key.push_back(conf.getNumLonePairs());
+			key.push_back(conf.getHasRadical());
+		}
+	}
+	return keys;
+}
+
 template<typename EdgeHandler>
 auto getCanonForm(const Single &g, EdgeHandler eHandler, LabelType labelType, bool withStereo) {
 	auto can = graph_canon::canonicalizer<int, EdgeHandler, false, false>(eHandler);
@@ -517,8 +574,11 @@ auto getCanonForm(const Single &g, EdgeHandler eHandler, LabelType labelType, bo
 			, graph_canon::stats_visitor()
 			);
 	const auto &str = get_string(g.getLabelledGraph());
-	const auto vLess = [&str](Vertex a, Vertex b) {
-		return str[a] < str[b];
+	const auto keys = getVertexKeys(g, labelType, withStereo);
+	const auto vLess = [&str, &keys, &idx, labelType](Vertex a, Vertex b) {
+		if(labelType == LabelType::String && str[a] != str[b])
+			return str[a] < str[b];
+		return keys[idx[a]] < keys[idx[b]];
 	};
 
 	auto res = can(graph, idx, vLess, vis);
@@ -551,10 +611,16 @@ auto getCanonForm(const Single &g, EdgeHandler eHandler, LabelType labelType, bo
 
 std::tuple<std::vector<int>, std::unique_ptr<Single::CanonForm>, std::unique_ptr<Single::AutGroup> >
 getCanonForm(const Single &g, LabelType labelType, bool withStereo) {
-	if(labelType != LabelType::String)
-		throw LogicError("Can only canonicalise with label type string.");
-	if(withStereo)
-		throw LogicError("Can not canonicalise stereo.");
+	if(labelType == LabelType::Term) {
+		const auto &term = get_term(g.getLabelledGraph());
+		if(!isValid(term)) {
+			std::string msg = "Parsing failed for graph '" + g.getName() + "' in canonicalisation. " + term.getParsingError();
+			throw TermParsingError(std::move(msg));
+		}
+	}
+	// Only molecules are canonicalised, and their labels are constants, so term labels are always ground here.
+	// Variables, which are shared between the labels of a graph, would need an edge handler for arbitrary labels,
+	// and a numbering of the variables along the canonical order.
 	if(get_molecule(g.getLabelledGraph()).getIsMolecule()) {
 		return getCanonForm(g, edge_handler_bond(g), labelType, withStereo);
 	} else {
@@ -623,27 +689,100 @@ PrintVisitor<LGraph, Graph, Idx> makePrintVisitor(const LGraph &lg1, const LGrap
 
 } // namespace
 
+namespace {
+
+// Checks if the vertex bijection given by the canonical orders also maps the stereo embeddings.
+bool stereoEmbeddingsEqual(const Single &g1, const Single &g2, LabelType labelType) {
+	const auto &ord1 = g1.getCanonForm(labelType, true);
+	const auto &ord2 = g2.getCanonForm(labelType, true);
+	const auto &lg1 = g1.getLabelledGraph();
+	const auto &lg2 = g2.getLabelledGraph();
+	const auto &graph1 = get_graph(lg1);
+	const auto &graph2 = get_graph(lg2);
+	std::vector<Vertex> canonToVertex2(num_vertices(graph2));
+	for(const auto v : asRange(vertices(graph2)))
+		canonToVertex2[get(ord2.get_index_map(), v)] = v;
+	jla_boost::GraphMorphism::VectorVertexMap<GraphType, GraphType> m(graph1, graph2);
+	for(const auto v : asRange(vertices(graph1)))
+		put(m, graph1, graph2, v, canonToVertex2[get(ord1.get_index_map(), v)]);
+
+	const auto &stereo1 = get_stereo(lg1);
+	const auto &stereo2 = get_stereo(lg2);
+	for(const auto e1 : asRange(edges(graph1))) {
+		const auto v1 = get(m, graph1, graph2, source(e1, graph1));
+		const auto u1 = get(m, graph1, graph2, target(e1, graph1));
+		const auto e2 = edge(v1, u1, graph2);
+		assert(e2.second);
+		if(stereo1[e1] != stereo2[e2.first]) return false;
+	}
+	for(const auto v1 : asRange(vertices(graph1))) {
+		const auto v2 = get(m, graph1, graph2, v1);
+		const auto &c1 = stereo1[v1];
+		const auto &c2 = stereo2[v2];
+		// the geometry, lone pairs, and radicals are part of the canonical form
+		if(!c1->localPredIso(*c2)) return false;
+		if(c1->morphismStaticOk()) continue;
+		if(c2->morphismStaticOk()) continue;
+		if(c1->morphismDynamicOk()) continue;
+		if(c2->morphismDynamicOk()) continue;
+		auto perm = lib::GraphMorphism::Stereo::makePermutation(v1, v2, m, graph1, graph2, c1, c2, lg1, lg2);
+		if(!c1->morphismIso(*c2, perm)) return false;
+	}
+	return true;
+}
+
+bool isTrivial(const Single::AutGroup &group) {
+	for(const auto &p : generators(group)) {
+		for(std::size_t i = 0; i < degree(group); ++i)
+			if(static_cast<std::size_t> (perm_group::get(p, i)) != i) return false;
+	}
+	return true;
+}
+
+} // namespace
+
 bool canonicalCompare(const Single &g1, const Single &g2, LabelType labelType, bool withStereo) {
 	const auto &ord1 = g1.getCanonForm(labelType, withStereo);
 	const auto &ord2 = g2.getCanonForm(labelType, withStereo);
-	if(withStereo) throw LogicError("Can not currently compare canonical forms with stereo information.");
 	const auto &gl1 = g1.getLabelledGraph();
 	const auto &gl2 = g2.getLabelledGraph();
 	const auto visitor = graph_canon::graph_compare_null_visitor();
 	//	const auto visitor = makePrintVisitor(g1.getLabelledGraph(), g2.getLabelledGraph(), ord1, ord2, ord1.get_index_map(), ord2.get_index_map());
+	bool equal = false;
 	switch(labelType) {
 	case LabelType::String:
-		return graph_canon::ordered_graph_equal(ord1, ord2,
+		equal = graph_canon::ordered_graph_equal(ord1, ord2,
 				[&gl1, &gl2](Vertex v1, Vertex v2) -> bool {
 					return get_string(gl1)[v1] == get_string(gl2)[v2];
 				},
 		[&gl1, &gl2](Edge e1, Edge e2) -> bool {
 			return get_string(gl1)[e1] == get_string(gl2)[e2];
 		}, visitor);
+		break;
 	case LabelType::Term:
-		throw LogicError("Can not currently compare canonical forms with term labels.");
+	{
+		const auto &term1 = get_term(gl1);
+		const auto &term2 = get_term(gl2);
+		// canonicalisation is only done for molecules, whose labels are ground terms,
+		// so the comparison does not need to take variables shared between labels into account
+		equal = graph_canon::ordered_graph_equal(ord1, ord2,
+				[&term1, &term2](Vertex v1, Vertex v2) -> bool {
+					return getTermKey(getMachine(term1), term1[v1]) == getTermKey(getMachine(term2), term2[v2]);
+				},
+		[&term1, &term2](Edge e1, Edge e2) -> bool {
+			return getTermKey(getMachine(term1), term1[e1]) == getTermKey(getMachine(term2), term2[e2]);
+		}, visitor);
+	}
+		break;
 	}
-	MOD_ABORT;
+	if(!equal || !withStereo) return equal;
+	// The canonical form only contains the local stereo properties, so the embeddings must be checked as well.
+	// This check depends on the canonical orders, which may differ by an automorphism that is broken by the embeddings.
+	// If there are no such automorphisms, then the result is definitive, otherwise fall back to a full search.
+	if(stereoEmbeddingsEqual(g1, g2, labelType)) return true;
+	if(isTrivial(g1.getAutGroup(labelType, withStereo))) return false;
+	const auto labelSettings = LabelSettings(labelType, LabelRelation::Isomorphism, LabelRelation::Isomorphism);
+	return Single::isomorphismVF2(g1, g2, 1, labelSettings) == 1;
 }
 
 } // namespace Graph
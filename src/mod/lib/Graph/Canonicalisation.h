@@ -3,10 +3,19 @@
 
 #include <mod/lib/Graph/Single.h>
 
+#include <vector>
+
 namespace mod {
 namespace lib {
+namespace Term {
+struct Wam;
+} // namespace Term
 namespace Graph {
 
+// A representation of the ground term at the given heap address, used as vertex colour in canonicalisation.
+// Only molecules are canonicalised, whose labels are always ground, so the term must not contain variables.
+std::vector<std::size_t> getTermKey(const lib::Term::Wam &machine, std::size_t addr);
+
 std::tuple<std::vector<int>, std::unique_ptr<Single::CanonForm>, std::unique_ptr<Single::AutGroup> >
 getCanonForm(const Single &g, LabelType labelType, bool withStereo);
 
@@ -1,49 +1,130 @@
 #ifndef MOD_LIB_GRAPH_MULTISET_H
 #define MOD_LIB_GRAPH_MULTISET_H
 
+#include <boost/functional/hash.hpp>
+
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace mod {
 namespace lib {
 namespace Graph {
 
+// A sorted multiset of graphs, with a precomputed hash value.
+// Up to InlineSize graphs are stored inline, larger multisets in a heap array.
+
 template<typename GraphType>
 struct Multiset {
+	static constexpr std::size_t InlineSize = 3;
+public:
 	Multiset() = default;
 
-	explicit Multiset(GraphType *g) : graphs(1, g) { }
+	explicit Multiset(GraphType *g) : count(1) {
+		inlineGraphs[0] = g;
+		computeHash();
+	}
+
+	explicit Multiset(std::vector<GraphType*> graphs) : count(graphs.size()) {
+		std::sort(graphs.begin(), graphs.end(), typename std::remove_cv<GraphType>::type::IdLess());
+		if(count > InlineSize) heapGraphs.reset(new GraphType*[count]);
+		std::copy(graphs.begin(), graphs.end(), data());
+		computeHash();
+	}
+
+	Multiset(const Multiset &other) : count(other.count), hash(other.hash) {
+		if(count > InlineSize) heapGraphs.reset(new GraphType*[count]);
+		std::copy(other.begin(), other.end(), data());
+	}
+
+	Multiset(Multiset &&other)
+	: inlineGraphs(other.inlineGraphs), heapGraphs(std::move(other.heapGraphs)), count(other.count), hash(other.hash) {
+		other.count = 0;
+		other.hash = 0;
+	}
 
-	explicit Multiset(std::vector<GraphType*> graphs) : graphs(std::move(graphs)) {
-		this->graphs.shrink_to_fit();
-		std::sort(this->graphs.begin(), this->graphs.end(), typename std::remove_cv<GraphType>::type::IdLess());
+	Multiset &operator=(const Multiset &other) {
+		if(this == &other) return *this;
+		if(other.count > InlineSize) heapGraphs.reset(new GraphType*[other.count]);
+		else heapGraphs.reset();
+		count = other.count;
+		hash = other.hash;
+		std::copy(other.begin(), other.end(), data());
+		return *this;
 	}
 
-	auto begin() const {
-		return graphs.begin();
+	Multiset &operator=(Multiset &&other) {
+		if(this == &other) return *this;
+		inlineGraphs = other.inlineGraphs;
+		heapGraphs = std::move(other.heapGraphs);
+		count = other.count;
+		hash = other.hash;
+		other.count = 0;
+		other.hash = 0;
+		return *this;
 	}
 
-	auto end() const {
-		return graphs.end();
+	GraphType * const *begin() const {
+		return data();
+	}
+
+	GraphType * const *end() const {
+		return data() + count;
 	}
 
 	bool empty() const {
-		return graphs.empty();
+		return count == 0;
 	}
 
 	std::size_t size() const {
-		return graphs.size();
+		return count;
+	}
+
+	std::size_t getHash() const {
+		return hash;
 	}
 
 	friend bool operator==(const Multiset &l, const Multiset &r) {
-		return l.graphs == r.graphs;
+		return l.hash == r.hash && l.count == r.count && std::equal(l.begin(), l.end(), r.begin());
 	}
 
 	friend bool operator<(const Multiset &l, const Multiset &r) {
-		return l.graphs < r.graphs;
+		return std::lexicographical_compare(l.begin(), l.end(), r.begin(), r.end());
+	}
+
+	friend std::size_t hash_value(const Multiset &ms) {
+		return ms.hash;
 	}
 private:
-	std::vector<GraphType*> graphs;
+
+	GraphType **data() {
+		return count > InlineSize ? heapGraphs.get() : inlineGraphs.data();
+	}
+
+	GraphType * const *data() const {
+		return count > InlineSize ? heapGraphs.get() : inlineGraphs.data();
+	}
+
+	// The ids of the graphs are hashed, rather than their addresses, so the hash is reproducible,
+	// and the result is finalised with the SplitMix64 mixer, so the low bits are usable directly as a table index.
+	void computeHash() {
+		std::uint64_t h = count;
+		for(const auto *g : *this)
+			boost::hash_combine(h, g->getId());
+		h ^= h >> 30;
+		h *= 0xbf58476d1ce4e5b9ull;
+		h ^= h >> 27;
+		h *= 0x94d049bb133111ebull;
+		h ^= h >> 31;
+		hash = h;
+	}
+private:
+	std::array<GraphType*, InlineSize> inlineGraphs = {};
+	std::unique_ptr<GraphType*[]> heapGraphs; // only used when count > InlineSize
+	std::uint32_t count = 0;
+	std::size_t hash = 0;
 };
 
 } // namespace Graph
@@ -51,4 +132,3 @@ private:
 } // namespace mod
 
 #endif /* MOD_LIB_GRAPH_MULTISET_H */
-
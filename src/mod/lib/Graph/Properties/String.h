@@ -1,14 +1,23 @@
 #ifndef MOD_LIB_GRAPH_PROP_LABEL_H
 #define MOD_LIB_GRAPH_PROP_LABEL_H
 
+#include <mod/lib/StringStore.h>
 #include <mod/lib/Graph/Properties/Property.h>
+#include <mod/lib/Term/WAM.h>
+
+#include <cstdint>
+#include <limits>
 
 namespace mod {
 namespace lib {
 namespace Graph {
 
-struct PropString : Prop<PropString, std::string, std::string> {
-	using Base = Prop<PropString, std::string, std::string>;
+// The labels are interned in the global string store, lib::Term::getStrings(),
+// and stored as their indices, so equal labels can be compared by their ids.
+
+struct PropString : Prop<PropString, std::uint32_t, std::uint32_t> {
+	using Base = Prop<PropString, std::uint32_t, std::uint32_t>;
+	using LabelId = std::uint32_t;
 public:
 
 	explicit PropString(const GraphType &g) : Base(g) {
@@ -18,8 +27,71 @@ public:
 	PropString(const PropString &other, const GraphType &g) : Base(other, g) {
 		Base::verify(&g);
 	}
+
+	void addVertex(Vertex v, const std::string &label) {
+		Base::addVertex(v, intern(label));
+	}
+
+	void addEdge(Edge e, const std::string &label) {
+		Base::addEdge(e, intern(label));
+	}
+
+	void addVertex(Vertex v, LabelId id) {
+		Base::addVertex(v, id);
+	}
+
+	void addEdge(Edge e, LabelId id) {
+		Base::addEdge(e, id);
+	}
+
+	const std::string &operator[](Vertex v) const {
+		return lib::Term::getStrings().getString(getId(v));
+	}
+
+	const std::string &operator[](Edge e) const {
+		return lib::Term::getStrings().getString(getId(e));
+	}
+
+	LabelId getId(Vertex v) const {
+		return Base::operator[](v);
+	}
+
+	LabelId getId(Edge e) const {
+		return Base::operator[](e);
+	}
+private:
+
+	static LabelId intern(const std::string &label) {
+		const auto id = lib::Term::getStrings().getIndex(label);
+		assert(id <= std::numeric_limits<LabelId>::max());
+		return id;
+	}
+public:
+
+	// A view of the label ids, as a property.
+
+	struct Ids {
+
+		explicit Ids(const PropString &p) : p(p) { }
+
+		template<typename VertexOrEdge>
+		friend LabelId get(const Ids &ids, VertexOrEdge ve) {
+			return ids.p.getId(ve);
+		}
+	private:
+		const PropString &p;
+	};
+
+	friend Ids get_label_ids(const PropString &p) {
+		return Ids(p);
+	}
 };
 
+template<typename VertexOrEdge>
+const std::string &get(const PropString &p, VertexOrEdge ve) {
+	return p[ve];
+}
+
 } // namespace Graph
 } // namespace lib
 } // namespace mod
@@ -8,6 +8,8 @@
 
 #include <jla_boost/graph/PairToRangeAdaptor.hpp>
 
+#include <algorithm>
+
 namespace mod {
 namespace lib {
 namespace Graph {
@@ -31,6 +33,12 @@ PropTerm::PropTerm(const GraphType &g, const PropString &pString, const StringSt
 		}
 		lib::Term::Address addr = lib::Term::append(machine, *rawTerm, varToAddr);
 		labelToAddress[label] = addr.addr;
+		// ground terms are always appended, so their addresses are increasing
+		const auto groundTermId = lib::Term::getGroundTerms().getId(machine, addr);
+		if(groundTermId != lib::Term::GroundTermStore::NotGround) {
+			assert(groundTermIds.empty() || groundTermIds.back().first < addr.addr);
+			groundTermIds.emplace_back(addr.addr, groundTermId);
+		}
 		return addr.addr;
 	};
 	this->vertexState.resize(num_vertices(g));
@@ -46,6 +54,8 @@ PropTerm::PropTerm(const GraphType &g, const PropString &pString, const StringSt
 		assert(get(boost::edge_index_t(), g, e) == this->edgeState.size());
 		this->edgeState.push_back(handleLabel(pString[e]));
 	}
+	// the machine is copied for each unification, so let the copies share the parsed terms
+	machine.share();
 	verify(&this->g);
 }
 
@@ -62,6 +72,15 @@ const lib::Term::Wam &getMachine(const PropTerm &p) {
 	return p.machine;
 }
 
+lib::Term::GroundTermStore::Id getGroundTermId(const PropTerm &p, std::size_t addr) {
+	const auto iter = std::lower_bound(p.groundTermIds.begin(), p.groundTermIds.end(), addr,
+			[](const auto &pair, std::size_t addr) {
+				return pair.first < addr;
+			});
+	if(iter == p.groundTermIds.end() || iter->first != addr) return lib::Term::GroundTermStore::NotGround;
+	return iter->second;
+}
+
 } // namespace Graph
 } // namespace lib
 } // namespace mod
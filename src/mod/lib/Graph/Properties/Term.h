@@ -2,6 +2,7 @@
 #define	MOD_LIB_GRAPH_PROP_TERM_H
 
 #include <mod/lib/Graph/Properties/Property.h>
+#include <mod/lib/Term/GroundTermStore.h>
 #include <mod/lib/Term/WAM.h>
 
 #include <boost/optional.hpp>
@@ -20,9 +21,13 @@ public:
 	const std::string &getParsingError() const; // requires !isValid
 	friend bool isValid(const PropTerm &p);
 	friend const lib::Term::Wam &getMachine(const PropTerm &p);
+	// returns the id in lib::Term::getGroundTerms() of the label term at the given address,
+	// or NotGround if it is not ground
+	friend lib::Term::GroundTermStore::Id getGroundTermId(const PropTerm &p, std::size_t addr);
 private:
 	boost::optional<std::string> parsingError;
 	lib::Term::Wam machine;
+	std::vector<std::pair<std::size_t, lib::Term::GroundTermStore::Id> > groundTermIds; // sorted by address
 };
 
 } // namespace Graph
@@ -21,10 +21,12 @@
 #include <mod/lib/Random.h>
 #include <mod/lib/Rules/GraphToRule.h>
 #include <mod/lib/Rules/Real.h>
+#include <mod/lib/StringStore.h>
 #include <mod/lib/Term/WAM.h>
 
 #include <jla_boost/graph/morphism/callbacks/Limit.hpp>
 
+#include <boost/functional/hash.hpp>
 #include <boost/graph/connected_components.hpp>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/lexical_cast.hpp>
@@ -96,6 +98,19 @@ const LabelledGraph &Single::getLabelledGraph() const {
 	return g;
 }
 
+const GraphMorphism::LabelFingerprint &Single::getLabelFingerprint() const {
+	// not computed in the constructor, as it is not used with term labels
+	std::call_once(*labelFingerprintFlag, [this]() {
+		const auto &str = getStringState();
+		labelFingerprint = GraphMorphism::LabelFingerprint(getGraph(), [&str](Vertex v) {
+			return str.getId(v);
+		}, [&str](Edge e) {
+			return str.getId(e);
+		});
+	});
+	return labelFingerprint;
+}
+
 std::size_t Single::getId() const {
 	return id;
 }
@@ -130,8 +145,8 @@ const std::string &Single::getSmiles() const {
 			if(getConfig().graph.useWrongSmilesCanonAlg.get()) {
 				smiles.reset(Chem::getSmiles(getGraph(), getMoleculeState(), nullptr, false));
 			} else {
-				getCanonForm(LabelType::String, false); // TODO: make the withStereo a parameter
-				smiles.reset(Chem::getSmiles(getGraph(), getMoleculeState(), &canon_perm_string, false));
+				const auto &perm = getCanonData(LabelType::String, false).perm; // TODO: make the withStereo a parameter
+				smiles.reset(Chem::getSmiles(getGraph(), getMoleculeState(), &perm, false));
 			}
 		}
 		return *smiles;
@@ -149,8 +164,8 @@ const std::string &Single::getSmilesWithIds() const {
 			if(getConfig().graph.useWrongSmilesCanonAlg.get()) {
 				smilesWithIds.reset(Chem::getSmiles(getGraph(), getMoleculeState(), nullptr, true));
 			} else {
-				getCanonForm(LabelType::String, false); // TODO: make the withStereo a parameter
-				smilesWithIds.reset(Chem::getSmiles(getGraph(), getMoleculeState(), &canon_perm_string, true));
+				const auto &perm = getCanonData(LabelType::String, false).perm; // TODO: make the withStereo a parameter
+				smilesWithIds.reset(Chem::getSmiles(getGraph(), getMoleculeState(), &perm, true));
 			}
 		}
 		return *smilesWithIds;
@@ -178,21 +193,23 @@ std::shared_ptr<rule::Rule> Single::getUnbindRule() const {
 }
 
 unsigned int Single::getVertexLabelCount(const std::string &label) const {
+	const auto &strings = lib::Term::getStrings();
+	if(!strings.hasString(label)) return 0;
+	const auto id = strings.getIndex(label);
 	unsigned int count = 0;
-
 	for(Vertex v : asRange(vertices(getGraph()))) {
-		const std::string &vLabel = getStringState()[v];
-		if(vLabel == label) count++;
+		if(getStringState().getId(v) == id) count++;
 	}
 	return count;
 }
 
 unsigned int Single::getEdgeLabelCount(const std::string &label) const {
+	const auto &strings = lib::Term::getStrings();
+	if(!strings.hasString(label)) return 0;
+	const auto id = strings.getIndex(label);
 	unsigned int count = 0;
-
 	for(Edge e : asRange(edges(getGraph()))) {
-		const std::string &eLabel = getStringState()[e];
-		if(eLabel == label) count++;
+		if(getStringState().getId(e) == id) count++;
 	}
 	return count;
 }
@@ -223,24 +240,64 @@ const PropMolecule &Single::getMoleculeState() const {
 }
 
 const Single::CanonForm &Single::getCanonForm(LabelType labelType, bool withStereo) const {
-	if(labelType != LabelType::String)
-		throw LogicError("Can only canonicalise with label type string.");
-	// TODO: when Terms are supported, remember to check if the state is valid, else throw TermParsingError
-	if(withStereo)
-		throw LogicError("Can not canonicalise stereo.");
-	if(!canon_form_string) {
-		assert(!aut_group_string);
-		std::tie(canon_perm_string, canon_form_string, aut_group_string) = lib::Graph::getCanonForm(*this, labelType, withStereo);
-	}
-	assert(canon_form_string);
-	assert(aut_group_string);
-	return *canon_form_string;
+	return *getCanonData(labelType, withStereo).form;
 }
 
 const Single::AutGroup &Single::getAutGroup(LabelType labelType, bool withStereo) const {
-	getCanonForm(labelType, withStereo);
-	assert(aut_group_string);
-	return *aut_group_string;
+	return *getCanonData(labelType, withStereo).autGroup;
+}
+
+const Single::CanonData &Single::getCanonData(LabelType labelType, bool withStereo) const {
+	auto &data = canonData[2 * static_cast<int> (labelType) + (withStereo ? 1 : 0)];
+	if(!data.form) {
+		assert(!data.autGroup);
+		std::tie(data.perm, data.form, data.autGroup) = lib::Graph::getCanonForm(*this, labelType, withStereo);
+	}
+	assert(data.form);
+	assert(data.autGroup);
+	return data;
+}
+
+std::size_t Single::getInvariantHash(LabelType labelType) const {
+	const int idx = labelType == LabelType::String ? 0 : 1;
+	std::call_once((*invariantHashFlags)[idx], [this, labelType, idx]() {
+		invariantHash[idx] = computeInvariantHash(labelType);
+	});
+	return invariantHash[idx];
+}
+
+std::size_t Single::computeInvariantHash(LabelType labelType) const {
+	const auto &graph = getGraph();
+	const auto &str = getStringState();
+	std::size_t res = 0;
+	boost::hash_combine(res, num_vertices(graph));
+	boost::hash_combine(res, num_edges(graph));
+	// terms are only isomorphic up to renaming of variables, so use only the structure for them
+	const bool withLabels = labelType == LabelType::String;
+	std::vector<std::size_t> vData, eData;
+	vData.reserve(num_vertices(graph));
+	eData.reserve(num_edges(graph));
+	for(Vertex v : asRange(vertices(graph))) {
+		std::size_t vHash = 0;
+		boost::hash_combine(vHash, out_degree(v, graph));
+		if(withLabels) boost::hash_combine(vHash, str[v]);
+		vData.push_back(vHash);
+	}
+	for(Edge e : asRange(edges(graph))) {
+		std::size_t vSrc = vData[get(boost::vertex_index_t(), graph, source(e, graph))];
+		std::size_t vTar = vData[get(boost::vertex_index_t(), graph, target(e, graph))];
+		if(vSrc > vTar) std::swap(vSrc, vTar);
+		std::size_t eHash = 0;
+		boost::hash_combine(eHash, vSrc);
+		boost::hash_combine(eHash, vTar);
+		if(withLabels) boost::hash_combine(eHash, str[e]);
+		eData.push_back(eHash);
+	}
+	std::sort(begin(vData), end(vData));
+	std::sort(begin(eData), end(eData));
+	boost::hash_range(res, begin(vData), end(vData));
+	boost::hash_range(res, begin(eData), end(eData));
+	return res;
 }
 
 //------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 #include <mod/rule/ForwardDecl.h>
 #include <mod/lib/Graph/GraphDecl.h>
 #include <mod/lib/Graph/LabelledGraph.h>
+#include <mod/lib/GraphMorphism/LabelFingerprint.h>
 
 #include <graph_canon/ordered_graph.hpp>
 
@@ -14,7 +15,10 @@
 
 #include <boost/optional/optional.hpp>
 
+#include <array>
 #include <iosfwd>
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace mod {
@@ -36,6 +40,9 @@ public:
 	Single(Single &&) = default;
 	~Single();
 	const LabelledGraph &getLabelledGraph() const;
+	// the string labels summarised for rejecting impossible monomorphisms into this graph,
+	// computed on first use, which may happen concurrently from several threads
+	const GraphMorphism::LabelFingerprint &getLabelFingerprint() const;
 	std::size_t getId() const;
 	std::shared_ptr<graph::Graph> getAPIReference() const;
 	void setAPIReference(std::shared_ptr<graph::Graph> g);
@@ -56,10 +63,28 @@ public: // deprecated interface
 	const PropString &getStringState() const;
 	const PropMolecule &getMoleculeState() const;
 public:
+	// with stereo, the canonical form and automorphism group only take the local stereo properties into account,
+	// i.e., the geometry, lone pairs, and radicals, but not the embeddings
 	const CanonForm &getCanonForm(LabelType labelType, bool withStereo) const;
 	const AutGroup &getAutGroup(LabelType labelType, bool withStereo) const;
+	// a hash value which is invariant under isomorphism with the given label type,
+	// i.e., isomorphic graphs have the same value, but the reverse may not be true
+	// it only depends on the degrees and labels, not on the configured isomorphism algorithm,
+	// so hashes computed at different times in the same build can always be compared,
+	// but it is based on boost::hash_combine, so it must not be stored for use by other builds
+	std::size_t getInvariantHash(LabelType labelType) const;
+private:
+	struct CanonData {
+		std::vector<int> perm;
+		std::unique_ptr<const CanonForm> form;
+		std::unique_ptr<const AutGroup> autGroup;
+	};
+	const CanonData &getCanonData(LabelType labelType, bool withStereo) const;
+	std::size_t computeInvariantHash(LabelType labelType) const;
 private:
 	LabelledGraph g;
+	mutable std::unique_ptr<std::once_flag> labelFingerprintFlag = std::make_unique<std::once_flag>(); // in a pointer to keep Single movable
+	mutable GraphMorphism::LabelFingerprint labelFingerprint;
 	const std::size_t id;
 	std::weak_ptr<graph::Graph> apiReference;
 	std::string name;
@@ -68,9 +93,9 @@ private:
 	mutable boost::optional<std::string> smiles, smilesWithIds;
 	mutable std::shared_ptr<rule::Rule> bindRule, idRule, unbindRule;
 	mutable std::unique_ptr<std::vector<Vertex> > vertexOrder;
-	mutable std::vector<int> canon_perm_string;
-	mutable std::unique_ptr<const CanonForm> canon_form_string;
-	mutable std::unique_ptr<const AutGroup> aut_group_string;
+	mutable std::array<CanonData, 4> canonData; // indexed by 2 * label type + with stereo
+	mutable std::unique_ptr<std::array<std::once_flag, 2> > invariantHashFlags = std::make_unique<std::array<std::once_flag, 2> >(); // indexed by label type
+	mutable std::array<std::size_t, 2> invariantHash;
 	mutable std::unique_ptr<DepictionData> depictionData;
 public:
 	static std::size_t isomorphismVF2(const Single &gDom, const Single &gCodom, std::size_t maxNumMatches, LabelSettings labelSettings);
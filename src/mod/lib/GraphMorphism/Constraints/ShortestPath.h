@@ -5,9 +5,11 @@
 #include <mod/lib/LabelledGraph.h>
 #include <mod/lib/GraphMorphism/Constraints/Constraint.h>
 
+#include <jla_boost/graph/BFSDistances.hpp>
 #include <jla_boost/graph/morphism/VertexMap.hpp>
 
-#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace mod {
 namespace lib {
@@ -66,18 +68,25 @@ public:
 		if(vSrcCodom == vRightNull || vTarCodom == vRightNull) {
 			return check(std::numeric_limits<int>::max());
 		}
-		using VertexCodom = typename boost::graph_traits<GraphCodom>::vertex_descriptor;
-		using EdgeCodom = typename boost::graph_traits<GraphCodom>::edge_descriptor;
-		std::vector<int> distance(num_vertices(gCodom));
-		std::vector<VertexCodom> predesc(num_vertices(gCodom));
-		auto distanceMap = boost::make_iterator_property_map(distance.begin(), get(boost::vertex_index_t(), gCodom));
-		auto predescMap = boost::make_iterator_property_map(predesc.begin(), get(boost::vertex_index_t(), gCodom));
-
-		boost::dijkstra_shortest_paths(gCodom, vSrcCodom, distance_map(distanceMap).predecessor_map(predescMap)
-				.weight_map(boost::make_constant_property<EdgeCodom>(1)));
-		const auto length = distance[get(boost::vertex_index_t(), gCodom, vTarCodom)];
+		// all operators can be decided by the exact distance up to this->length, or knowing that it is longer
+		const auto length = getDistance(lgCodom, vSrcCodom, vTarCodom, std::max(0, this->length), 0);
 		return check(length);
 	}
+private:
+
+	// if the codomain caches its distances, e.g., a rule side, then use those
+	template<typename LabelledGraphCodom, typename VertexCodom>
+	static auto getDistance(const LabelledGraphCodom &lgCodom, VertexCodom vSrc, VertexCodom vTar, int maxDistance, int)
+	-> decltype(get_shortest_path_distances(lgCodom, vSrc), int()) {
+		const auto &distances = get_shortest_path_distances(lgCodom, vSrc);
+		return distances[get(boost::vertex_index_t(), get_graph(lgCodom), vTar)];
+	}
+
+	// otherwise search, but not further than needed
+	template<typename LabelledGraphCodom, typename VertexCodom>
+	static int getDistance(const LabelledGraphCodom &lgCodom, VertexCodom vSrc, VertexCodom vTar, int maxDistance, ... /* worse than everything */) {
+		return jla_boost::bfs_distance(get_graph(lgCodom), vSrc, vTar, maxDistance);
+	}
 public:
 	Vertex vSrc, vTar;
 	Operator op;
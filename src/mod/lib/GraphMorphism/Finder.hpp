@@ -3,6 +3,8 @@
 
 #include <jla_boost/graph/morphism/VertexOrderByMult.hpp>
 
+#include <type_traits>
+
 namespace mod {
 namespace lib {
 namespace GraphMorphism {
@@ -16,6 +18,13 @@ struct DefaultFinderArgsProvider {
 	}
 };
 
+// whether the finder calls the vf2_try_push and vf2_pop hooks of the vertex predicate,
+// see jla_boost::GraphMorphism::vf2_try_push, i.e., whether search extensions are notified of the partial morphisms
+
+template<typename Finder>
+struct CallsSearchHooks : std::false_type {
+};
+
 } // namespace GraphMorphism
 } // namespace lib
 } // namespace mod
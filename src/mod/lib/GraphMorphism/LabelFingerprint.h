@@ -0,0 +1,85 @@
+#ifndef MOD_LIB_GRAPHMORPHISM_LABELFINGERPRINT_H
+#define MOD_LIB_GRAPHMORPHISM_LABELFINGERPRINT_H
+
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <boost/graph/graph_traits.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace GraphMorphism {
+
+// A summary of the string labels of a graph, for rejecting impossible monomorphisms without searching.
+// A pattern graph can only have a label preserving monomorphism into a host graph if
+// isSubsetOf(fingerprint(pattern), fingerprint(host)), i.e., if
+// - each vertex label occurs at least as often in the host, with at least as large degrees
+//   (compared after sorting the degrees of the vertices with that label decreasingly), and
+// - each (edge label, end point labels) triple occurs at least as often in the host.
+// The labels are given as interned ids, see lib::Term::getStrings().
+
+struct LabelFingerprint {
+	using LabelId = std::uint32_t;
+public:
+	LabelFingerprint() = default;
+
+	template<typename Graph, typename VertexLabel, typename EdgeLabel>
+	LabelFingerprint(const Graph &g, VertexLabel vertexLabel, EdgeLabel edgeLabel) {
+		for(const auto v : asRange(vertices(g))) {
+			const LabelId label = vertexLabel(v);
+			vertexMask |= getBit(label);
+			vertexDegrees.emplace_back(label, out_degree(v, g));
+		}
+		for(const auto e : asRange(edges(g))) {
+			LabelId src = vertexLabel(source(e, g)), tar = vertexLabel(target(e, g));
+			if(src > tar) std::swap(src, tar);
+			const LabelId label = edgeLabel(e);
+			edgeMask |= getBit(label);
+			edgeTriples.emplace_back(label, src, tar);
+		}
+		// by label, and then by decreasing degree
+		std::sort(vertexDegrees.begin(), vertexDegrees.end(), [](const auto &a, const auto &b) {
+			return a.first != b.first ? a.first < b.first : a.second > b.second;
+		});
+		std::sort(edgeTriples.begin(), edgeTriples.end());
+	}
+
+	friend bool isSubsetOf(const LabelFingerprint &pattern, const LabelFingerprint &host) {
+		// first the constant time checks
+		if(pattern.vertexDegrees.size() > host.vertexDegrees.size()) return false;
+		if(pattern.edgeTriples.size() > host.edgeTriples.size()) return false;
+		if((pattern.vertexMask & ~host.vertexMask) != 0) return false;
+		if((pattern.edgeMask & ~host.edgeMask) != 0) return false;
+		// then the linear merges
+		auto hostIter = host.vertexDegrees.begin();
+		const auto hostEnd = host.vertexDegrees.end();
+		for(auto patternIter = pattern.vertexDegrees.begin(); patternIter != pattern.vertexDegrees.end(); ++patternIter) {
+			// skip host vertices with smaller labels, they can not be used
+			while(hostIter != hostEnd && hostIter->first < patternIter->first) ++hostIter;
+			if(hostIter == hostEnd || hostIter->first != patternIter->first) return false;
+			if(hostIter->second < patternIter->second) return false;
+			++hostIter;
+		}
+		return std::includes(host.edgeTriples.begin(), host.edgeTriples.end(),
+				pattern.edgeTriples.begin(), pattern.edgeTriples.end());
+	}
+private:
+
+	static std::uint64_t getBit(LabelId label) {
+		return std::uint64_t(1) << (label % 64);
+	}
+private:
+	std::uint64_t vertexMask = 0, edgeMask = 0;
+	std::vector<std::pair<LabelId, std::size_t> > vertexDegrees;
+	std::vector<std::tuple<LabelId, LabelId, LabelId> > edgeTriples;
+};
+
+} // namespace GraphMorphism
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_GRAPHMORPHISM_LABELFINGERPRINT_H */
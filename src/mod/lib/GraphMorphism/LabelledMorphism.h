@@ -80,38 +80,130 @@ ArgsProvider<OuterGraph> makeArgsProvider(const OuterGraph &gOuter) {
 
 namespace GM = jla_boost::GraphMorphism;
 
-template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper>
-bool morphismFinallyDoIt(const LabGraphDom &gDom, const LabGraphCodom &gCodom, Finder finder, MR mr, PredWrapper predWrapper, MRWrapper mrWrapper) {
-	auto predOuter = predWrapper(gDom, gCodom, jla_boost::AlwaysTrue());
-	auto pred = [&predOuter, &gDom, &gCodom](const auto &l, const auto &r) {
+// for finders which support it, the extension is notified when vertex pairs are added to and removed from the partial morphism,
+// and it can reject pairs, see jla_boost::GraphMorphism::vf2_try_push
+
+struct NoSearchExtension {
+
+	template<typename VertexDom, typename VertexCodom>
+	bool tryPush(const VertexDom&, const VertexCodom&) {
+		return true;
+	}
+
+	template<typename VertexDom, typename VertexCodom>
+	void pop(const VertexDom&, const VertexCodom&) { }
+};
+
+// a pair is accepted if both extensions accept it
+
+template<typename First, typename Second>
+struct SearchExtensionPair {
+
+	SearchExtensionPair(First &first, Second &second) : first(first), second(second) { }
+
+	template<typename VertexDom, typename VertexCodom>
+	bool tryPush(const VertexDom &vDom, const VertexCodom &vCodom) {
+		if(!first.tryPush(vDom, vCodom)) return false;
+		if(second.tryPush(vDom, vCodom)) return true;
+		first.pop(vDom, vCodom);
+		return false;
+	}
+
+	template<typename VertexDom, typename VertexCodom>
+	void pop(const VertexDom &vDom, const VertexCodom &vCodom) {
+		second.pop(vDom, vCodom);
+		first.pop(vDom, vCodom);
+	}
+private:
+	First &first;
+	Second &second;
+};
+
+template<typename PredOuter, typename LabGraphDom, typename LabGraphCodom, typename Extension>
+struct FinderPred {
+
+	FinderPred(const PredOuter &predOuter, const LabGraphDom &gDom, const LabGraphCodom &gCodom, Extension &ext)
+	: predOuter(predOuter), gDom(gDom), gCodom(gCodom), ext(ext) { }
+
+	template<typename L, typename R>
+	bool operator()(const L &l, const R &r) const {
 		return predOuter(l, r, gDom, gCodom);
-	};
+	}
+
+	template<typename VertexDom, typename VertexCodom>
+	friend bool vf2_try_push(FinderPred &pred, const VertexDom &vDom, const VertexCodom &vCodom) {
+		return pred.ext.tryPush(vDom, vCodom);
+	}
+
+	template<typename VertexDom, typename VertexCodom>
+	friend void vf2_pop(FinderPred &pred, const VertexDom &vDom, const VertexCodom &vCodom) {
+		pred.ext.pop(vDom, vCodom);
+	}
+private:
+	const PredOuter &predOuter;
+	const LabGraphDom &gDom;
+	const LabGraphCodom &gCodom;
+	Extension &ext;
+};
+
+template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper, typename Extension>
+bool morphismFinallyDoIt(const LabGraphDom &gDom, const LabGraphCodom &gCodom, Finder finder, MR mr, PredWrapper predWrapper, MRWrapper mrWrapper,
+		Extension &ext) {
+	const auto predOuter = predWrapper(gDom, gCodom, jla_boost::AlwaysTrue());
+	const auto pred = FinderPred<decltype(predOuter), LabGraphDom, LabGraphCodom, Extension>(predOuter, gDom, gCodom, ext);
 	auto mrWrapped = mrWrapper(gDom, gCodom, mr);
 	return finder(get_graph(gDom), get_graph(gCodom), mrWrapped, pred, pred,
 			makeArgsProvider(gDom), makeArgsProvider(gCodom));
 }
 
+template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper>
+bool morphismFinallyDoIt(const LabGraphDom &gDom, const LabGraphCodom &gCodom, Finder finder, MR mr, PredWrapper predWrapper, MRWrapper mrWrapper) {
+	NoSearchExtension ext;
+	return morphismFinallyDoIt(gDom, gCodom, finder, mr, predWrapper, mrWrapper, ext);
+}
+
 //------------------------------------------------------------------------------
 
-template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper, typename TermFilter>
+template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper, typename TermFilter,
+typename Extension>
+bool morphismCreateTermRelation(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, Finder finder,
+		MR mr, PredWrapper predWrapper, MRWrapper mrWrapper, TermFilter termFilter, Extension &ext, std::true_type /*callsSearchHooks*/) {
+	// unify while searching, so partial morphisms without a unifier are pruned early
+	IncrementalTermUnifier<LabGraphDom, LabGraphCodom> unifier(gDomain, gCodomain);
+	auto mrFinal = makeToTermVertexMap(gDomain, gCodomain, &unifier, GM::makeFilter(termFilter, mr));
+	SearchExtensionPair<Extension, decltype(unifier)> extPair(ext, unifier);
+	return morphismFinallyDoIt(gDomain, gCodomain, finder, mrFinal, predWrapper, mrWrapper, extPair);
+}
+
+template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper, typename TermFilter,
+typename Extension>
 bool morphismCreateTermRelation(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, Finder finder,
-		MR mr, PredWrapper predWrapper, MRWrapper mrWrapper, TermFilter termFilter) {
-	auto mrFinal = makeToTermVertexMap(gDomain, gCodomain, GM::makeFilter(termFilter, mr));
-	return morphismFinallyDoIt(gDomain, gCodomain, finder, mrFinal, predWrapper, mrWrapper);
+		MR mr, PredWrapper predWrapper, MRWrapper mrWrapper, TermFilter termFilter, Extension &ext, std::false_type /*callsSearchHooks*/) {
+	// the unifier would never see a vertex pair, so unify each found morphism from scratch
+	const IncrementalTermUnifier<LabGraphDom, LabGraphCodom> *noUnifier = nullptr;
+	auto mrFinal = makeToTermVertexMap(gDomain, gCodomain, noUnifier, GM::makeFilter(termFilter, mr));
+	return morphismFinallyDoIt(gDomain, gCodomain, finder, mrFinal, predWrapper, mrWrapper, ext);
+}
+
+template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper, typename TermFilter,
+typename Extension>
+bool morphismCreateTermRelation(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, Finder finder,
+		MR mr, PredWrapper predWrapper, MRWrapper mrWrapper, TermFilter termFilter, Extension &ext) {
+	return morphismCreateTermRelation(gDomain, gCodomain, finder, mr, predWrapper, mrWrapper, termFilter, ext, CallsSearchHooks<Finder>());
 }
 
 //------------------------------------------------------------------------------
 
-template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper>
+template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper, typename Extension>
 bool morphismSelectTermRelation(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, LabelRelation labelRelation, Finder finder,
-		MR mr, PredWrapper predWrapper, MRWrapper mrWrapper) {
+		MR mr, PredWrapper predWrapper, MRWrapper mrWrapper, Extension &ext) {
 	switch(labelRelation) {
 	case LabelRelation::Isomorphism:
-		return morphismCreateTermRelation(gDomain, gCodomain, finder, mr, predWrapper, mrWrapper, TermFilterRenaming());
+		return morphismCreateTermRelation(gDomain, gCodomain, finder, mr, predWrapper, mrWrapper, TermFilterRenaming(), ext);
 	case LabelRelation::Specialisation:
-		return morphismCreateTermRelation(gDomain, gCodomain, finder, mr, predWrapper, mrWrapper, TermFilterSpecialisation());
+		return morphismCreateTermRelation(gDomain, gCodomain, finder, mr, predWrapper, mrWrapper, TermFilterSpecialisation(), ext);
 	case LabelRelation::Unification:
-		return morphismCreateTermRelation(gDomain, gCodomain, finder, mr, predWrapper, mrWrapper, jla_boost::AlwaysTrue());
+		return morphismCreateTermRelation(gDomain, gCodomain, finder, mr, predWrapper, mrWrapper, jla_boost::AlwaysTrue(), ext);
 	}
 	MOD_ABORT;
 }
@@ -127,7 +219,20 @@ public:
 
 	template<typename LabGraphDom, typename LabGraphCodom, typename Pred>
 	auto operator()(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, Pred pred) const {
-		return predWrapper(gDomain, gCodomain, GM::makePropertyPredicateEq(get_string(gDomain), get_string(gCodomain), pred));
+		return predWrapper(gDomain, gCodomain, makeStringPredicate(get_string(gDomain), get_string(gCodomain), pred, int()));
+	}
+private:
+
+	// if both properties have interned labels, then compare the ids instead of the strings
+	template<typename PropDom, typename PropCodom, typename Pred>
+	static auto makeStringPredicate(const PropDom &pDom, const PropCodom &pCodom, Pred pred, int)
+	-> decltype(GM::makePropertyPredicateEq(get_label_ids(pDom), get_label_ids(pCodom), pred)) {
+		return GM::makePropertyPredicateEq(get_label_ids(pDom), get_label_ids(pCodom), pred);
+	}
+
+	template<typename PropDom, typename PropCodom, typename Pred>
+	static auto makeStringPredicate(const PropDom &pDom, const PropCodom &pCodom, Pred pred, ... /* worse than everything */) {
+		return GM::makePropertyPredicateEq(pDom, pCodom, pred);
 	}
 };
 
@@ -148,20 +253,20 @@ public:
 	}
 };
 
-template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper>
+template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper, typename Extension>
 bool morphismSelectStringOrTerm(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, LabelType labelType, LabelRelation labelRelation,
-		Finder finder, MR mr, PredWrapper predWrapper, MRWrapper mrWrapper) {
+		Finder finder, MR mr, PredWrapper predWrapper, MRWrapper mrWrapper, Extension &ext) {
 	switch(labelType) {
 	case LabelType::String:
 		switch(labelRelation) {
 		case LabelRelation::Isomorphism:
 		case LabelRelation::Specialisation:
 		case LabelRelation::Unification:
-			return detail::morphismFinallyDoIt(gDomain, gCodomain, finder, mr, StringLabelPredWrapper<PredWrapper>(predWrapper), mrWrapper);
+			return detail::morphismFinallyDoIt(gDomain, gCodomain, finder, mr, StringLabelPredWrapper<PredWrapper>(predWrapper), mrWrapper, ext);
 		}
 		MOD_ABORT;
 	case LabelType::Term:
-		return detail::morphismSelectTermRelation(gDomain, gCodomain, labelRelation, finder, mr, TermLabelPredWrapper<PredWrapper>(predWrapper), mrWrapper);
+		return detail::morphismSelectTermRelation(gDomain, gCodomain, labelRelation, finder, mr, TermLabelPredWrapper<PredWrapper>(predWrapper), mrWrapper, ext);
 	}
 	MOD_ABORT;
 }
@@ -196,20 +301,27 @@ public:
 
 template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper>
 bool morphismSelectStereo(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, LabelType labelType, LabelRelation labelRelation, LabelRelation stereoRelation,
-		Finder finder, MR mr, PredWrapper predWrapper, MRWrapper mrWrapper) {
+		bool incrementalStereo, Finder finder, MR mr, PredWrapper predWrapper, MRWrapper mrWrapper) {
+	// check configurations while searching, so partial morphisms with incompatible embeddings are pruned early
 	switch(stereoRelation) {
 	case LabelRelation::Isomorphism:
+	{
+		Stereo::IncrementalChecker<Stereo::MorphismIso, LabGraphDom, LabGraphCodom> checker(gDomain, gCodomain, incrementalStereo);
 		return detail::morphismSelectStringOrTerm(gDomain, gCodomain, labelType, labelRelation, finder,
-				Stereo::makeToVertexMapIso(gDomain, gCodomain, mr),
+				Stereo::makeToVertexMapIso(gDomain, gCodomain, &checker, mr),
 				StereoPredWrapperIso<PredWrapper>(predWrapper),
-				mrWrapper
+				mrWrapper, checker
 				);
+	}
 	case LabelRelation::Specialisation:
+	{
+		Stereo::IncrementalChecker<Stereo::MorphismSpec, LabGraphDom, LabGraphCodom> checker(gDomain, gCodomain, incrementalStereo);
 		return detail::morphismSelectStringOrTerm(gDomain, gCodomain, labelType, labelRelation, finder,
-				Stereo::makeToVertexMapSpec(gDomain, gCodomain, mr),
+				Stereo::makeToVertexMapSpec(gDomain, gCodomain, &checker, mr),
 				StereoPredWrapperSpec<PredWrapper>(predWrapper),
-				mrWrapper
+				mrWrapper, checker
 				);
+	}
 	case LabelRelation::Unification:
 		MOD_ABORT; // not yet implemented
 	}
@@ -233,9 +345,11 @@ template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Fin
 bool morphismSelectByLabelSettings(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, LabelSettings labelSettings,
 		Finder finder, MR mr, PredWrapper predWrapper = IdentityWrapper(), MRWrapper mrWrapper = IdentityWrapper()) {
 	if(labelSettings.withStereo) {
-		return detail::morphismSelectStereo(gDomain, gCodomain, labelSettings.type, labelSettings.relation, labelSettings.stereoRelation, finder, mr, predWrapper, mrWrapper);
+		return detail::morphismSelectStereo(gDomain, gCodomain, labelSettings.type, labelSettings.relation, labelSettings.stereoRelation,
+				labelSettings.incrementalStereo, finder, mr, predWrapper, mrWrapper);
 	} else {
-		return detail::morphismSelectStringOrTerm(gDomain, gCodomain, labelSettings.type, labelSettings.relation, finder, mr, predWrapper, mrWrapper);
+		detail::NoSearchExtension ext;
+		return detail::morphismSelectStringOrTerm(gDomain, gCodomain, labelSettings.type, labelSettings.relation, finder, mr, predWrapper, mrWrapper, ext);
 	}
 }
 
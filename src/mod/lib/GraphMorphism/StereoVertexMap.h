@@ -2,19 +2,26 @@
 #define MOD_LIB_GRAPHMORPHISM_STEREOVERTEXMAP_H
 
 #include <mod/Error.h>
+#include <mod/lib/LabelledGraph.h>
 #include <mod/lib/Stereo/Configuration/Configuration.h>
 #include <mod/lib/Stereo/EdgeCategory.h>
 
 #include <jla_boost/graph/morphism/VertexMap.hpp>
+#include <jla_boost/graph/morphism/models/Vector.hpp>
 #include <jla_boost/graph/morphism/models/PropertyVertexMap.hpp>
 
+#include <iterator>
+
 // LocalIso
 // LocalSpec
+// MorphismIso
+// MorphismSpec
 // PredIso
 // PredSpec
 // ToVertexMap
 // - Iso
 // - Spec
+// IncrementalChecker
 
 namespace mod {
 namespace lib {
@@ -73,6 +80,22 @@ struct LocalSpec {
 	}
 };
 
+// the relation between the configurations of mapped vertices, given the permutation of their embeddings
+
+struct MorphismIso {
+
+	bool operator()(const ConfPtr &cDom, const ConfPtr &cCodom, std::vector<std::size_t> &perm) const {
+		return cDom->morphismIso(*cCodom, perm);
+	}
+};
+
+struct MorphismSpec {
+
+	bool operator()(const ConfPtr &cDom, const ConfPtr &cCodom, std::vector<std::size_t> &perm) const {
+		return cDom->morphismSpec(*cCodom, perm);
+	}
+};
+
 // PredIso
 //------------------------------------------------------------------------------
 
@@ -130,6 +153,9 @@ auto makePredSpec(Next next = jla_boost::AlwaysTrue()) {
 
 namespace GM = jla_boost::GraphMorphism;
 
+template<typename Morphism, typename LabGraphDom, typename LabGraphCodom>
+struct IncrementalChecker;
+
 struct StereoDataIso {
 };
 
@@ -149,13 +175,15 @@ struct StereoDataSpec {
 	}
 };
 
-template<typename Derived, typename LabGraphDom, typename LabGraphCodom, typename Next>
+template<typename Derived, typename Morphism, typename LabGraphDom, typename LabGraphCodom, typename Next>
 struct ToVertexMapBase {
 	using Handler = typename LabGraphDom::PropStereoType::Handler;
+	using Checker = IncrementalChecker<Morphism, LabGraphDom, LabGraphCodom>;
 public:
 
-	ToVertexMapBase(const LabGraphDom &lgDom, const LabGraphCodom &lgCodom, Next next)
-	: lgDom(lgDom), lgCodom(lgCodom), next(next) { }
+	// if checker is not null, and it has seen the complete morphism, then the configurations are not checked again
+	ToVertexMapBase(const LabGraphDom &lgDom, const LabGraphCodom &lgCodom, const Checker *checker, Next next)
+	: lgDom(lgDom), lgCodom(lgCodom), checker(checker), next(next) { }
 
 	template<typename VertexMap, typename GraphMorDom, typename GraphMorCodom>
 	bool operator()(VertexMap &&m, const GraphMorDom &gMorDom, const GraphMorCodom &gMorCodom) const {
@@ -187,8 +215,8 @@ public:
 			const bool ok = getDerived().unifyGeometries(vDom, vCodom, pDom, pCodom);
 			if(!ok) return true;
 		}
-		// Map neighbourhoods and check configurations
-		for(const auto vDom : asRange(vertices(gMorDom))) {
+		// Map neighbourhoods and check configurations, unless the checker has done so for the complete morphism
+		if(!(checker && checker->isComplete())) for(const auto vDom : asRange(vertices(gMorDom))) {
 			const auto vCodom = get(m, gMorDom, gMorCodom, vDom);
 			if(vCodom == boost::graph_traits<GraphMorCodom>::null_vertex()) continue;
 			const bool ok = getDerived().mapNeighbourhoods(vDom, vCodom, pDom, pCodom, m, gMorDom, gMorCodom);
@@ -203,33 +231,9 @@ private:
 		return static_cast<const Derived&> (*this);
 	}
 protected:
-
-	template<typename F, typename F2>
-	struct VertexMapper {
-
-		VertexMapper(F f, F2 f2) : f(f), f2(f2) { }
-
-		template<typename ...Args>
-		decltype(auto) operator()(Args&&... args) const {
-			return f(std::forward<Args>(args)...);
-		}
-
-		template<typename ...Args>
-		decltype(auto) operator()(bool a, bool b, Args&&... args) const {
-			return f2(a, b, std::forward<Args>(args)...);
-		}
-	private:
-		F f;
-		F2 f2;
-	};
-
-	template<typename F, typename F2>
-	static auto makeVertexMapper(F f, F2 f2) {
-		return VertexMapper<F, F2>(f, f2);
-	}
-protected:
 	const LabGraphDom &lgDom;
 	const LabGraphCodom &lgCodom;
+	const Checker *checker;
 	Next next;
 };
 
@@ -290,9 +294,60 @@ std::vector<std::size_t> makePermutation(const auto &vDom, const auto &vCodom, c
 	return perm;
 }
 
+namespace detail {
+
+template<typename F, typename F2>
+struct VertexMapper {
+
+	VertexMapper(F f, F2 f2) : f(f), f2(f2) { }
+
+	template<typename ...Args>
+	decltype(auto) operator()(Args&&... args) const {
+		return f(std::forward<Args>(args)...);
+	}
+
+	template<typename ...Args>
+	decltype(auto) operator()(bool a, bool b, Args&&... args) const {
+		return f2(a, b, std::forward<Args>(args)...);
+	}
+private:
+	F f;
+	F2 f2;
+};
+
+template<typename F, typename F2>
+auto makeVertexMapper(F f, F2 f2) {
+	return VertexMapper<F, F2>(f, f2);
+}
+
+} // namespace detail
+
+// Checks the configuration of vDom against that of vCodom, with the embedding permutation given by m.
+// All neighbours of vDom must be mapped.
+
+template<typename Morphism, typename VertexDom, typename VertexCodom, typename LabGraphDom, typename LabGraphCodom,
+typename VertexMap, typename GraphMorDom, typename GraphMorCodom>
+bool mapNeighbourhood(Morphism morphism, const VertexDom &vDom, const VertexCodom &vCodom, const LabGraphDom &lgDom, const LabGraphCodom &lgCodom,
+		const VertexMap &m, const GraphMorDom &gMorDom, const GraphMorCodom &gMorCodom) {
+	using Handler = typename LabGraphDom::PropStereoType::Handler;
+	const auto mapper = [&](const ConfPtr &cDom, const ConfPtr &cCodom, const auto &gLabDom, const auto &gLabCodom) {
+		if(cDom->morphismStaticOk()) return true;
+		if(cCodom->morphismStaticOk()) return true;
+		if(cDom->morphismDynamicOk()) return true;
+		if(cCodom->morphismDynamicOk()) return true;
+		auto perm = makePermutation(vDom, vCodom, m, gMorDom, gMorCodom, cDom, cCodom, gLabDom, gLabCodom);
+		return morphism(cDom, cCodom, perm);
+	};
+	const auto vMapper = detail::makeVertexMapper(mapper, jla_boost::AlwaysTrue());
+	const auto &pDom = get_stereo(lgDom);
+	const auto &pCodom = get_stereo(lgCodom);
+	return Handler::reduce(std::logical_and<>(), Handler::fmap2(get(pDom, vDom), get(pCodom, vCodom), lgDom, lgCodom, vMapper));
+}
+
 template<typename LabGraphDom, typename LabGraphCodom, typename Next>
-struct ToVertexMapIso : ToVertexMapBase<ToVertexMapIso<LabGraphDom, LabGraphCodom, Next>, LabGraphDom, LabGraphCodom, Next> {
-	using Base = ToVertexMapBase<ToVertexMapIso<LabGraphDom, LabGraphCodom, Next>, LabGraphDom, LabGraphCodom, Next>;
+struct ToVertexMapIso : ToVertexMapBase<ToVertexMapIso<LabGraphDom, LabGraphCodom, Next>, MorphismIso, LabGraphDom, LabGraphCodom, Next> {
+	using Morphism = MorphismIso;
+	using Base = ToVertexMapBase<ToVertexMapIso<LabGraphDom, LabGraphCodom, Next>, Morphism, LabGraphDom, LabGraphCodom, Next>;
 	friend Base;
 	using typename Base::Handler;
 public:
@@ -313,16 +368,7 @@ private:
 	template<typename VertexDom, typename VertexCodom, typename PropDom, typename PropCodom, typename VertexMap, typename GraphMorDom, typename GraphMorCodom>
 	bool mapNeighbourhoods(const VertexDom &vDom, const VertexCodom &vCodom, const PropDom &pDom, const PropCodom &pCodom,
 			const VertexMap &m, const GraphMorDom &gMorDom, const GraphMorCodom &gMorCodom) const {
-		const auto mapper = [&vDom, &gMorDom, &vCodom, &gMorCodom, &m](const ConfPtr &cDom, const ConfPtr &cCodom, const auto &gLabDom, const auto &gLabCodom) {
-			if(cDom->morphismStaticOk()) return true;
-			if(cCodom->morphismStaticOk()) return true;
-			if(cDom->morphismDynamicOk()) return true;
-			if(cCodom->morphismDynamicOk()) return true;
-			auto perm = makePermutation(vDom, vCodom, m, gMorDom, gMorCodom, cDom, cCodom, gLabDom, gLabCodom);
-			return cDom->morphismIso(*cCodom, perm);
-		};
-		const auto vMapper = Base::makeVertexMapper(mapper, jla_boost::AlwaysTrue());
-		return Handler::reduce(std::logical_and<>(), Handler::fmap2(get(pDom, vDom), get(pCodom, vCodom), this->lgDom, this->lgCodom, vMapper));
+		return mapNeighbourhood(Morphism(), vDom, vCodom, this->lgDom, this->lgCodom, m, gMorDom, gMorCodom);
 	}
 
 	template<typename VertexMap, typename PropDom, typename PropCodom, typename GraphMorDom, typename GraphMorCodom>
@@ -333,14 +379,21 @@ private:
 	}
 };
 
+template<typename LabGraphDom, typename LabGraphCodom, typename Next>
+auto makeToVertexMapIso(const LabGraphDom &gDom, const LabGraphCodom &gCodom,
+		const IncrementalChecker<MorphismIso, LabGraphDom, LabGraphCodom> *checker, Next next) {
+	return ToVertexMapIso<LabGraphDom, LabGraphCodom, Next>(gDom, gCodom, checker, next);
+}
+
 template<typename LabGraphDom, typename LabGraphCodom, typename Next>
 auto makeToVertexMapIso(const LabGraphDom &gDom, const LabGraphCodom &gCodom, Next next) {
-	return ToVertexMapIso<LabGraphDom, LabGraphCodom, Next>(gDom, gCodom, next);
+	return ToVertexMapIso<LabGraphDom, LabGraphCodom, Next>(gDom, gCodom, nullptr, next);
 }
 
 template<typename LabGraphDom, typename LabGraphCodom, typename Next>
-struct ToVertexMapSpec : ToVertexMapBase<ToVertexMapSpec<LabGraphDom, LabGraphCodom, Next>, LabGraphDom, LabGraphCodom, Next> {
-	using Base = ToVertexMapBase<ToVertexMapSpec<LabGraphDom, LabGraphCodom, Next>, LabGraphDom, LabGraphCodom, Next>;
+struct ToVertexMapSpec : ToVertexMapBase<ToVertexMapSpec<LabGraphDom, LabGraphCodom, Next>, MorphismSpec, LabGraphDom, LabGraphCodom, Next> {
+	using Morphism = MorphismSpec;
+	using Base = ToVertexMapBase<ToVertexMapSpec<LabGraphDom, LabGraphCodom, Next>, Morphism, LabGraphDom, LabGraphCodom, Next>;
 	friend Base;
 	using typename Base::Handler;
 public:
@@ -363,16 +416,7 @@ private:
 	template<typename VertexDom, typename VertexCodom, typename PropDom, typename PropCodom, typename VertexMap, typename GraphMorDom, typename GraphMorCodom>
 	bool mapNeighbourhoods(const VertexDom &vDom, const VertexCodom &vCodom, const PropDom &pDom, const PropCodom &pCodom,
 			const VertexMap &m, const GraphMorDom &gMorDom, const GraphMorCodom &gMorCodom) const {
-		const auto mapper = [&vDom, &gMorDom, &vCodom, &gMorCodom, &m](const ConfPtr &cDom, const ConfPtr &cCodom, const auto &gLabDom, const auto &gLabCodom) {
-			if(cDom->morphismStaticOk()) return true;
-			if(cCodom->morphismStaticOk()) return true;
-			if(cDom->morphismDynamicOk()) return true;
-			if(cCodom->morphismDynamicOk()) return true;
-			auto perm = makePermutation(vDom, vCodom, m, gMorDom, gMorCodom, cDom, cCodom, gLabDom, gLabCodom);
-			return cDom->morphismSpec(*cCodom, perm);
-		};
-		const auto vMapper = Base::makeVertexMapper(mapper, jla_boost::AlwaysTrue());
-		return Handler::reduce(std::logical_and<>(), Handler::fmap2(get(pDom, vDom), get(pCodom, vCodom), this->lgDom, this->lgCodom, vMapper));
+		return mapNeighbourhood(Morphism(), vDom, vCodom, this->lgDom, this->lgCodom, m, gMorDom, gMorCodom);
 	}
 
 	template<typename VertexMap, typename PropDom, typename PropCodom, typename GraphMorDom, typename GraphMorCodom>
@@ -381,11 +425,97 @@ private:
 	}
 };
 
+template<typename LabGraphDom, typename LabGraphCodom, typename Next>
+auto makeToVertexMapSpec(const LabGraphDom &lgDom, const LabGraphCodom &lgCodom,
+		const IncrementalChecker<MorphismSpec, LabGraphDom, LabGraphCodom> *checker, Next next) {
+	return ToVertexMapSpec<LabGraphDom, LabGraphCodom, Next>(lgDom, lgCodom, checker, next);
+}
+
 template<typename LabGraphDom, typename LabGraphCodom, typename Next>
 auto makeToVertexMapSpec(const LabGraphDom &lgDom, const LabGraphCodom &lgCodom, Next next) {
-	return ToVertexMapSpec<LabGraphDom, LabGraphCodom, Next>(lgDom, lgCodom, next);
+	return ToVertexMapSpec<LabGraphDom, LabGraphCodom, Next>(lgDom, lgCodom, nullptr, next);
 }
 
+// IncrementalChecker
+//------------------------------------------------------------------------------
+
+// Checks the configuration of each domain vertex as soon as it and all its neighbours are mapped by a finder,
+// so partial morphisms with incompatible embeddings are pruned right away, instead of after the complete morphism is found.
+// The vertex descriptors are those of get_graph(lgDom) and get_graph(lgCodom),
+// which the finder searches in.
+
+template<typename Morphism, typename LabGraphDom, typename LabGraphCodom>
+struct IncrementalChecker {
+	using GraphDom = typename LabelledGraphTraits<LabGraphDom>::GraphType;
+	using GraphCodom = typename LabelledGraphTraits<LabGraphCodom>::GraphType;
+	using VertexDom = typename boost::graph_traits<GraphDom>::vertex_descriptor;
+	using VertexCodom = typename boost::graph_traits<GraphCodom>::vertex_descriptor;
+public:
+
+	// if not enabled, then all pairs are accepted without checking anything
+	IncrementalChecker(const LabGraphDom &lgDom, const LabGraphCodom &lgCodom, bool enabled)
+	: lgDom(lgDom), lgCodom(lgCodom), enabled(enabled), m(get_graph(lgDom), get_graph(lgCodom)),
+	numMappedAdjacent(num_vertices(get_graph(lgDom)), 0) {
+		// num_vertices is the size of the underlying graph for filtered graphs, so count the vertices actually present
+		const auto vs = vertices(get_graph(lgDom));
+		numVertices = std::distance(vs.first, vs.second);
+	}
+
+	bool tryPush(VertexDom vDom, VertexCodom vCodom) {
+		if(!enabled) return true;
+		const auto &gDom = get_graph(lgDom);
+		push(vDom, vCodom);
+		// vDom and the mapped neighbours may now have all their neighbours mapped
+		bool ok = checkIfSaturated(vDom);
+		for(auto oes = out_edges(vDom, gDom); ok && oes.first != oes.second; ++oes.first) {
+			const auto vDomAdj = target(*oes.first, gDom);
+			if(get(m, gDom, get_graph(lgCodom), vDomAdj) == boost::graph_traits<GraphCodom>::null_vertex()) continue;
+			ok = checkIfSaturated(vDomAdj);
+		}
+		if(!ok) pop(vDom, vCodom);
+		return ok;
+	}
+
+	void pop(VertexDom vDom, VertexCodom vCodom) {
+		if(!enabled) return;
+		const auto &gDom = get_graph(lgDom);
+		assert(numMapped > 0);
+		--numMapped;
+		put(m, gDom, get_graph(lgCodom), vDom, boost::graph_traits<GraphCodom>::null_vertex());
+		for(const auto eDom : asRange(out_edges(vDom, gDom)))
+			--numMappedAdjacent[get(boost::vertex_index_t(), gDom, target(eDom, gDom))];
+	}
+
+	// whether all domain vertices are mapped, i.e., whether all configurations have been checked
+	bool isComplete() const {
+		return enabled && numMapped == numVertices;
+	}
+private:
+
+	void push(VertexDom vDom, VertexCodom vCodom) {
+		const auto &gDom = get_graph(lgDom);
+		++numMapped;
+		put(m, gDom, get_graph(lgCodom), vDom, vCodom);
+		for(const auto eDom : asRange(out_edges(vDom, gDom)))
+			++numMappedAdjacent[get(boost::vertex_index_t(), gDom, target(eDom, gDom))];
+	}
+
+	bool checkIfSaturated(VertexDom vDom) const {
+		const auto &gDom = get_graph(lgDom);
+		const auto &gCodom = get_graph(lgCodom);
+		if(numMappedAdjacent[get(boost::vertex_index_t(), gDom, vDom)] != out_degree(vDom, gDom)) return true;
+		return mapNeighbourhood(Morphism(), vDom, get(m, gDom, gCodom, vDom), lgDom, lgCodom, m, gDom, gCodom);
+	}
+private:
+	const LabGraphDom &lgDom;
+	const LabGraphCodom &lgCodom;
+	const bool enabled;
+	GM::VectorVertexMap<GraphDom, GraphCodom> m;
+	std::vector<std::size_t> numMappedAdjacent; // indexed by the domain vertex index
+	std::size_t numVertices; // in the domain graph
+	std::size_t numMapped = 0;
+};
+
 } // namespace Stereo
 } // namespace GraphMorphism
 } // namespace lib
@@ -3,6 +3,8 @@
 
 #include <mod/Config.h>
 #include <mod/Error.h>
+#include <mod/lib/LabelledGraph.h>
+#include <mod/lib/Term/GroundTermStore.h>
 #include <mod/lib/Term/WAM.h>
 
 #include <jla_boost/graph/morphism/VertexMap.hpp>
@@ -38,12 +40,27 @@ struct TermPredConstants {
 		const bool res = Handler::reduce(std::logical_and<>(),
 				Handler::fmap2(aDom, aCodom, gDom, gCodom,
 				[this, &pDom, &pCodom](std::size_t l, std::size_t r, auto&&...) {
+					// hash-consed ground terms are equal if and only if their ids are
+					const auto idDom = getGroundTermIdOrNotGround(pDom, l, 0);
+					const auto idCodom = getGroundTermIdOrNotGround(pCodom, r, 0);
+					if(idDom != lib::Term::GroundTermStore::NotGround && idCodom != lib::Term::GroundTermStore::NotGround)
+						return idDom == idCodom;
 					return this->compare(l, r, getMachine(pDom), getMachine(pCodom));
 				}));
 		return res && next(veDom, veCodom, gDom, gCodom);
 	}
 private:
 
+	template<typename PropTerm>
+	static auto getGroundTermIdOrNotGround(const PropTerm &p, std::size_t addr, int) -> decltype(getGroundTermId(p, addr)) {
+		return getGroundTermId(p, addr);
+	}
+
+	template<typename PropTerm>
+	static lib::Term::GroundTermStore::Id getGroundTermIdOrNotGround(const PropTerm&, std::size_t, ...) {
+		return lib::Term::GroundTermStore::NotGround;
+	}
+
 	bool compare(std::size_t addrLeft, std::size_t addrRight, const lib::Term::Wam &machineLeft, const lib::Term::Wam &machineRight) const {
 		assert(stack.empty());
 		constexpr bool DEBUG = false;
@@ -69,24 +86,24 @@ private:
 			Cell lhs = machineLeft.getCell(addrLhs);
 			Cell rhs = machineRight.getCell(addrRhs);
 			// if at least one is a variable we can't decide
-			if(lhs.tag == CellTag::REF || rhs.tag == CellTag::REF) {
+			if(lhs.getTag() == CellTag::REF || rhs.getTag() == CellTag::REF) {
 				if(DEBUG) s << "maybe, refs involved\n";
 				continue;
 			}
 			// they should be dereferenced
-			assert(lhs.tag == CellTag::Structure);
-			assert(rhs.tag == CellTag::Structure);
-			if(lhs.Structure.arity != rhs.Structure.arity) {
+			assert(lhs.getTag() == CellTag::Structure);
+			assert(rhs.getTag() == CellTag::Structure);
+			if(lhs.getArity() != rhs.getArity()) {
 				if(DEBUG) s << "FALSE, arity\n";
 				stack.clear();
 				return false;
 			}
-			if(lhs.Structure.name != rhs.Structure.name) {
+			if(lhs.getName() != rhs.getName()) {
 				if(DEBUG) s << "FALSE, name\n";
 				stack.clear();
 				return false;
 			}
-			for(std::size_t i = lhs.Structure.arity; i > 0; --i) {
+			for(std::size_t i = lhs.getArity(); i > 0; --i) {
 				stack.emplace_back(addrLhs.addr + i, addrRhs.addr + i);
 			}
 		}
@@ -129,11 +146,91 @@ struct TermAssociationHandlerUnify {
 	}
 };
 
+// IncrementalTermUnifier
+//------------------------------------------------------------------------------
+
+// Unifies the terms of vertex pairs as they are added to a partial morphism by a finder,
+// i.e., those of the vertices and of the edges to the already mapped vertices,
+// so a partial morphism with no unifier is pruned right away.
+// The unifications are reverted when a pair is removed again, using the trail in the MGU.
+// The vertex descriptors are those of get_graph(lgDom) and get_graph(lgCodom),
+// which the finder searches in.
+
+template<typename LabGraphDom, typename LabGraphCodom>
+struct IncrementalTermUnifier {
+	using GraphDom = typename LabelledGraphTraits<LabGraphDom>::GraphType;
+	using GraphCodom = typename LabelledGraphTraits<LabGraphCodom>::GraphType;
+	using VertexDom = typename boost::graph_traits<GraphDom>::vertex_descriptor;
+	using VertexCodom = typename boost::graph_traits<GraphCodom>::vertex_descriptor;
+public:
+
+	IncrementalTermUnifier(const LabGraphDom &lgDom, const LabGraphCodom &lgCodom)
+	: lgDom(lgDom), lgCodom(lgCodom), machine(getMachine(get_term(lgCodom))), mgu(machine.getHeap().size()),
+	codomOfDom(num_vertices(get_graph(lgDom)), boost::graph_traits<GraphCodom>::null_vertex()) {
+		machine.setTemp(getMachine(get_term(lgDom)));
+	}
+
+	bool tryPush(VertexDom vDom, VertexCodom vCodom) {
+		const auto &gDom = get_graph(lgDom);
+		const auto &gCodom = get_graph(lgCodom);
+		const auto &pDom = get_term(lgDom);
+		const auto &pCodom = get_term(lgCodom);
+		using Handler = typename LabGraphDom::PropTermType::Handler;
+		const auto mark = machine.getMark(mgu);
+		const auto unify = [&](const auto &veDom, const auto &veCodom) {
+			return Handler::reduce(std::logical_and<>(),
+					Handler::fmap2(get(pDom, veDom), get(pCodom, veCodom), lgDom, lgCodom,
+					TermAssociationHandlerUnify(), machine, mgu));
+		};
+		bool ok = unify(vDom, vCodom);
+		for(auto oes = out_edges(vDom, gDom); ok && oes.first != oes.second; ++oes.first) {
+			const auto eDom = *oes.first;
+			const auto vCodomAdj = codomOfDom[get(boost::vertex_index_t(), gDom, target(eDom, gDom))];
+			if(vCodomAdj == boost::graph_traits<GraphCodom>::null_vertex()) continue;
+			// the finder has checked that the edge exists
+			for(const auto eCodom : asRange(out_edges(vCodom, gCodom))) {
+				if(target(eCodom, gCodom) != vCodomAdj) continue;
+				ok = unify(eDom, eCodom);
+				break;
+			}
+		}
+		if(!ok) {
+			machine.revert(mgu, mark);
+			return false;
+		}
+		codomOfDom[get(boost::vertex_index_t(), gDom, vDom)] = vCodom;
+		marks.push_back(mark);
+		return true;
+	}
+
+	void pop(VertexDom vDom, VertexCodom vCodom) {
+		assert(!marks.empty());
+		machine.revert(mgu, marks.back());
+		marks.pop_back();
+		codomOfDom[get(boost::vertex_index_t(), get_graph(lgDom), vDom)] = boost::graph_traits<GraphCodom>::null_vertex();
+	}
+
+	// whether all domain vertices are mapped, i.e., whether the unifier is that of a complete morphism
+	bool isComplete() const {
+		return marks.size() == codomOfDom.size();
+	}
+private:
+	const LabGraphDom &lgDom;
+	const LabGraphCodom &lgCodom;
+public:
+	lib::Term::Wam machine;
+	lib::Term::MGU mgu;
+private:
+	std::vector<VertexCodom> codomOfDom; // indexed by the domain vertex index
+	std::vector<lib::Term::MGU::Mark> marks; // one for each mapped vertex, in order
+};
+
 template<typename LabGraphDom, typename LabGraphCodom, typename Next>
 struct ToTermVertexMap {
 
-	ToTermVertexMap(const LabGraphDom &gDom, const LabGraphCodom &gCodom, Next next)
-	: lgDom(gDom), lgCodom(gCodom), next(next) {
+	// if unifier is not null, and it has seen the complete morphism, then its result is used instead of unifying again
+	ToTermVertexMap(const LabGraphDom &gDom, const LabGraphCodom &gCodom, const IncrementalTermUnifier<LabGraphDom, LabGraphCodom> *unifier, Next next)
+	: lgDom(gDom), lgCodom(gCodom), unifier(unifier), next(next) {
 		if(!isValid(get_term(gDom))) MOD_ABORT;
 		if(!isValid(get_term(gCodom))) MOD_ABORT;
 	}
@@ -141,6 +238,10 @@ struct ToTermVertexMap {
 	template<typename VertexMap, typename GraphDom, typename GraphCodom>
 	bool operator()(VertexMap &&m, const GraphDom &gDom, const GraphCodom &gCodom) const {
 		BOOST_CONCEPT_ASSERT((GM::VertexMapConcept<VertexMap>));
+		if(unifier && unifier->isComplete()) {
+			TermData data{unifier->machine, unifier->mgu};
+			return next(GM::addProp(std::move(m), TermDataT(), std::move(data)), gDom, gCodom);
+		}
 		// Note: GraphMorDom is not necessarily the same as LabGraphDom::GraphType
 		//       as LabGraphDom can be a reindexed labelled filtered graph,
 		//       and GraphMorDom is the plain filtered graph without reindexing.
@@ -184,12 +285,14 @@ struct ToTermVertexMap {
 private:
 	const LabGraphDom &lgDom;
 	const LabGraphCodom &lgCodom;
+	const IncrementalTermUnifier<LabGraphDom, LabGraphCodom> *unifier;
 	Next next;
 };
 
 template<typename LabGraphDom, typename LabGraphCodom, typename Next>
-auto makeToTermVertexMap(const LabGraphDom &gDom, const LabGraphCodom &gCodom, Next next) {
-	return ToTermVertexMap<LabGraphDom, LabGraphCodom, Next>(gDom, gCodom, next);
+auto makeToTermVertexMap(const LabGraphDom &gDom, const LabGraphCodom &gCodom,
+		const IncrementalTermUnifier<LabGraphDom, LabGraphCodom> *unifier, Next next) {
+	return ToTermVertexMap<LabGraphDom, LabGraphCodom, Next>(gDom, gCodom, unifier, next);
 }
 
 // Filters for isRenaming and isSpecialisation
@@ -54,6 +54,44 @@ struct VF2Monomorphism {
 	}
 };
 
+// A VF2Monomorphism which records in the given resume point where the search was stopped by the callback,
+// and which continues a stopped search after the last morphism it reported.
+// The graphs, predicates and vertex order must be the same as when the search was stopped.
+
+struct VF2MonomorphismResumable {
+
+	explicit VF2MonomorphismResumable(jla_boost::GraphMorphism::vf2_resume_point &resume) : resume(&resume) { }
+
+	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate,
+	typename ArgsProviderDomain, typename ArgsProviderCodomain>
+	bool operator()(const GraphDomain &gDomain, const GraphCodomain &gCodomain, MR mr, EdgePredicate edgePred, VertexPredicate vertexPred,
+			ArgsProviderDomain argsDomain, ArgsProviderCodomain argsCodomain) {
+		auto &&vOrderDomain = get_vertex_order(argsDomain, gDomain);
+		return jla_boost::GraphMorphism::vf2_subgraph_mono(gDomain, gCodomain, mr,
+				get(boost::vertex_index_t(), gDomain), get(boost::vertex_index_t(), gCodomain),
+				vOrderDomain, edgePred, vertexPred, *resume);
+	}
+
+	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate>
+	bool operator()(const GraphDomain &gDomain, const GraphCodomain &gCodomain, MR mr, EdgePredicate edgePred, VertexPredicate vertexPred) {
+		return (*this)(gDomain, gCodomain, mr, edgePred, vertexPred, DefaultFinderArgsProvider(), DefaultFinderArgsProvider());
+	}
+private:
+	jla_boost::GraphMorphism::vf2_resume_point *resume;
+};
+
+template<>
+struct CallsSearchHooks<VF2Isomorphism> : std::true_type {
+};
+
+template<>
+struct CallsSearchHooks<VF2Monomorphism> : std::true_type {
+};
+
+template<>
+struct CallsSearchHooks<VF2MonomorphismResumable> : std::true_type {
+};
+
 } // namespace GraphMorphism
 } // namespace lib
 } // namespace mod
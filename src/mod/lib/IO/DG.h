@@ -15,18 +15,23 @@ namespace lib {
 namespace DG {
 class Hyper;
 class NonHyper;
+namespace Dump {
+struct Checkpoint;
+} // namespace Dump
 } // namespace DG
 namespace IO {
 namespace DG {
 namespace Read {
 lib::DG::NonHyper *dump(const std::vector<std::shared_ptr<graph::Graph> > &graphs, const std::vector<std::shared_ptr<rule::Rule> > &rules, const std::string &file, std::ostream &err);
 lib::DG::NonHyper *abstract(const std::string &s, std::ostream &err);
+std::unique_ptr<lib::DG::Dump::Checkpoint> checkpoint(const std::string &file, std::ostream &err);
 } // namespace Read
 namespace Write {
 using Vertex = lib::DG::HyperVertex;
 using Edge = lib::DG::HyperEdge;
 
 std::string dump(const lib::DG::NonHyper &dg);
+std::string dumpBinary(const lib::DG::NonHyper &dg);
 
 std::string dotNonHyper(const lib::DG::NonHyper &nonHyper);
 std::string pdfNonHyper(const lib::DG::NonHyper &nonHyper);
@@ -1,5 +1,6 @@
 #include "DG.h"
 
+#include <mod/Config.h>
 #include <mod/graph/Graph.h>
 #include <mod/rule/Rule.h>
 #include <mod/lib/DG/Dump.h>
@@ -25,8 +26,11 @@
 #include <boost/spirit/home/x3/operator/plus.hpp>
 #include <boost/spirit/home/x3/string/literal_string.hpp>
 
+#include <fstream>
+#include <iterator>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace mod {
 namespace lib {
@@ -162,7 +166,23 @@ lib::DG::NonHyper *dump(const std::vector<std::shared_ptr<graph::Graph> > &graph
 		err << "DG file not found, '" << file << "'" << std::endl;
 		return nullptr;
 	}
-	return lib::DG::Dump::load(graphs, rules, fileInStream, err);
+	if(!lib::DG::Dump::isBinary(fileInStream))
+		return lib::DG::Dump::load(graphs, rules, fileInStream, err);
+	// read it all at once, the binary loader parses from a buffer
+	fileInStream.close();
+	fileInStream.open(file.c_str(), std::ios::binary);
+	const std::vector<char> data{std::istreambuf_iterator<char>(fileInStream), std::istreambuf_iterator<char>()};
+	return lib::DG::Dump::loadBinary(graphs, rules, data.data(), data.size(), err, getConfig().dg.validateBinaryDump.get());
+}
+
+std::unique_ptr<lib::DG::Dump::Checkpoint> checkpoint(const std::string &file, std::ostream &err) {
+	std::ifstream fileInStream(file.c_str(), std::ios::binary);
+	if(!fileInStream.is_open()) {
+		err << "DG checkpoint file not found, '" << file << "'" << std::endl;
+		return nullptr;
+	}
+	const std::vector<char> data{std::istreambuf_iterator<char>(fileInStream), std::istreambuf_iterator<char>()};
+	return lib::DG::Dump::loadCheckpoint(data.data(), data.size(), err);
 }
 
 lib::DG::NonHyper *abstract(const std::string &s, std::ostream &err) {
@@ -117,12 +117,12 @@ namespace {
 
 std::ostream &rawVarFromCell(std::ostream &s, lib::Term::Cell cell) {
 	using namespace lib::Term;
-	assert(cell.tag == CellTag::REF);
-	switch(cell.REF.addr.type) {
+	assert(cell.getTag() == CellTag::REF);
+	switch(cell.getAddr().type) {
 	case AddressType::Heap:
-		return s << "_H" << cell.REF.addr.addr;
+		return s << "_H" << cell.getAddr().addr;
 	case AddressType::Temp:
-		return s << "_T" << cell.REF.addr.addr;
+		return s << "_T" << cell.getAddr().addr;
 	}
 	MOD_ABORT;
 }
@@ -161,16 +161,16 @@ std::ostream &rawTerm(const lib::Term::RawTerm &term, const StringStore &strings
 
 std::ostream &element(lib::Term::Cell cell, const StringStore &strings, std::ostream &s) {
 	using namespace lib::Term;
-	switch(cell.tag) {
+	switch(cell.getTag()) {
 	case CellTag::STR:
-		return s << "STR " << cell.STR.addr;
+		return s << "STR " << cell.getAddr();
 	case CellTag::Structure:
-		s << strings.getString(cell.Structure.name);
-		if(cell.Structure.arity > 0)
-			s << "/" << cell.Structure.arity;
+		s << strings.getString(cell.getName());
+		if(cell.getArity() > 0)
+			s << "/" << cell.getArity();
 		return s;
 	case CellTag::REF:
-		return s << "REF " << cell.REF.addr;
+		return s << "REF " << cell.getAddr();
 	}
 	MOD_ABORT;
 }
@@ -213,25 +213,25 @@ std::ostream &term(const lib::Term::Wam &machine, lib::Term::Address addr, const
 
 		void operator()(Address addr) {
 			Cell cell = machine.getCell(addr);
-			switch(cell.tag) {
+			switch(cell.getTag()) {
 			case CellTag::REF:
-				if(cell.REF.addr == addr
-						|| occurred.find(cell.REF.addr) != end(occurred)
+				if(cell.getAddr() == addr
+						|| occurred.find(cell.getAddr()) != end(occurred)
 						) {
 					rawVarFromCell(s, cell);
-				} else (*this)(cell.REF.addr);
+				} else (*this)(cell.getAddr());
 				break;
 			case CellTag::STR:
-				(*this)(cell.STR.addr);
+				(*this)(cell.getAddr());
 				break;
 			case CellTag::Structure:
 				assert(occurred.find(addr) == end(occurred));
 				occurred.insert(addr);
-				s << strings.getString(cell.Structure.name);
-				if(cell.Structure.arity > 0) {
+				s << strings.getString(cell.getName());
+				if(cell.getArity() > 0) {
 					s << "(";
 					(*this)(addr + 1);
-					for(std::size_t i = 2; i <= cell.Structure.arity; i++) {
+					for(std::size_t i = 2; i <= cell.getArity(); i++) {
 						s << ", ";
 						(*this)(addr + i);
 					}
@@ -267,9 +267,7 @@ std::ostream &mgu(const lib::Term::Wam &machine, const lib::Term::MGU &mgu, cons
 		if(binding.type == AddressType::Heap && binding.addr >= mgu.preHeapSize) continue;
 		if(!first) s << ", ";
 		first = false;
-		Cell cell;
-		cell.tag = CellTag::REF;
-		cell.REF.addr = binding;
+		const auto cell = Cell::makeREF(binding);
 		rawVarFromCell(s, cell) << " = ";
 		term(machine, binding, strings, s);
 	}
@@ -0,0 +1,60 @@
+#ifndef MOD_LIB_PARALLELFOR_H
+#define	MOD_LIB_PARALLELFOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mod {
+namespace lib {
+
+// Calls f(i) for each i in [0; n[ using at most numThreads threads, including the calling thread.
+// The indices are handed out one at a time from a shared counter, so threads that finish
+// their tasks early continue with the remaining ones, i.e., uneven task sizes are balanced.
+// The calls may happen in any order, so f must not depend on it.
+// If calls throw exceptions, then the remaining indices are skipped, and after all threads
+// have stopped the exception from the lowest index is rethrown.
+
+template<typename F>
+void parallelFor(unsigned int numThreads, std::size_t n, F f) {
+	numThreads = std::max(1u, std::min<unsigned int>(numThreads, n));
+	if(numThreads == 1) {
+		for(std::size_t i = 0; i < n; i++) f(i);
+		return;
+	}
+	std::atomic<std::size_t> next(0);
+	std::atomic<bool> failed(false);
+	std::mutex errorMutex;
+	std::size_t errorIndex = n;
+	std::exception_ptr error;
+	const auto worker = [&]() {
+		while(!failed.load(std::memory_order_relaxed)) {
+			const std::size_t i = next++;
+			if(i >= n) break;
+			try {
+				f(i);
+			} catch(...) {
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if(i < errorIndex) {
+					errorIndex = i;
+					error = std::current_exception();
+				}
+				failed = true;
+			}
+		}
+	};
+	std::vector<std::thread> threads;
+	threads.reserve(numThreads - 1);
+	for(unsigned int t = 1; t < numThreads; t++) threads.emplace_back(worker);
+	worker();
+	for(auto &t : threads) t.join();
+	if(error) std::rethrow_exception(error);
+}
+
+} // namespace lib
+} // namespace mod
+
+#endif	/* MOD_LIB_PARALLELFOR_H */
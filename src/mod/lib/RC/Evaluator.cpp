@@ -139,6 +139,8 @@ Evaluator::Evaluator(std::unordered_set<std::shared_ptr<rule::Rule> > database,
 			}
 		}
 	}
+	for(const auto &r : database)
+		databaseIndex[r->getRule().getInvariantHash(labelSettings.type)].push_back(r);
 }
 
 const std::unordered_set<std::shared_ptr<rule::Rule> > &Evaluator::getRuleDatabase() const {
@@ -225,7 +227,9 @@ const Evaluator::GraphType &Evaluator::getGraph() const {
 }
 
 bool Evaluator::addRule(std::shared_ptr<rule::Rule> r) {
-	return database.insert(r).second;
+	const bool inserted = database.insert(r).second;
+	if(inserted) databaseIndex[r->getRule().getInvariantHash(labelSettings.type)].push_back(r);
+	return inserted;
 }
 
 void Evaluator::giveProductStatus(std::shared_ptr<rule::Rule> r) {
@@ -233,10 +237,13 @@ void Evaluator::giveProductStatus(std::shared_ptr<rule::Rule> r) {
 }
 
 std::shared_ptr<rule::Rule> Evaluator::checkIfNew(lib::Rules::Real *rCand) const {
-	for(auto rOther : database) {
-		if(lib::Rules::makeIsomorphismPredicate(labelSettings.type, labelSettings.withStereo)(&rOther->getRule(), rCand)) {
-			delete rCand;
-			return rOther;
+	const auto iter = databaseIndex.find(rCand->getInvariantHash(labelSettings.type));
+	if(iter != end(databaseIndex)) {
+		for(auto rOther : iter->second) {
+			if(lib::Rules::makeIsomorphismPredicate(labelSettings.type, labelSettings.withStereo)(&rOther->getRule(), rCand)) {
+				delete rCand;
+				return rOther;
+			}
 		}
 	}
 	return rule::Rule::makeRule(std::unique_ptr<lib::Rules::Real>(rCand));
@@ -9,6 +9,7 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace mod {
 namespace lib {
@@ -62,6 +63,8 @@ public:
 	const LabelSettings labelSettings;
 private:
 	std::unordered_set<std::shared_ptr<rule::Rule> > database, products;
+	// the database bucketed by the invariant hash of the rules
+	std::unordered_map<std::size_t, std::vector<std::shared_ptr<rule::Rule> > > databaseIndex;
 private:
 	GraphType rcg;
 	std::unordered_map<const lib::Rules::Real*, Vertex> ruleToVertex;
@@ -0,0 +1,158 @@
+#ifndef MOD_LIB_RC_MATCH_MAKER_COMPONENTMORPHISMCACHE_H
+#define MOD_LIB_RC_MATCH_MAKER_COMPONENTMORPHISMCACHE_H
+
+#include <mod/Config.h>
+#include <mod/lib/RC/MatchMaker/LazyComponentMorphisms.h>
+#include <mod/lib/Rules/LabelledRule.h>
+
+#include <jla_boost/graph/morphism/models/Vector.hpp>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace RC {
+
+// A cache of the monomorphisms from a connected component of a side of one rule
+// into a connected component of a side of another rule.
+// Rules are identified by their id, so the morphisms are valid for as long as the ids are not reused.
+// Only use it for rules which are composed many times, e.g., not for temporary intermediary rules,
+// as their entries are never hit and only push out the useful ones.
+// The entries are lazy ranges, so the morphisms are only found as far as the users of an entry iterate it.
+// The number of stored morphisms is bounded, and the least recently used entries are evicted first.
+// The size of an entry is the number of morphisms fetched when it was last looked up,
+// so the bound is only approximate, as entries grow while they are in use.
+// All operations are thread safe.
+
+struct ComponentMorphismCache {
+	using Morphism = jla_boost::GraphMorphism::VectorVertexMap<lib::Rules::SideGraphType, lib::Rules::SideGraphType>;
+	using Morphisms = LazyComponentMorphisms<Morphism>;
+
+	struct Key {
+		std::size_t ruleDom, componentDom;
+		std::size_t ruleCodom, componentCodom;
+		bool enforceConstraints;
+		LabelSettings labelSettings;
+	public:
+
+		friend bool operator==(const Key &a, const Key &b) {
+			return a.ruleDom == b.ruleDom && a.componentDom == b.componentDom
+					&& a.ruleCodom == b.ruleCodom && a.componentCodom == b.componentCodom
+					&& a.enforceConstraints == b.enforceConstraints
+					&& a.labelSettings.type == b.labelSettings.type
+					&& a.labelSettings.relation == b.labelSettings.relation
+					&& a.labelSettings.withStereo == b.labelSettings.withStereo
+					&& a.labelSettings.stereoRelation == b.labelSettings.stereoRelation;
+		}
+	};
+private:
+
+	struct KeyHash {
+
+		std::size_t operator()(const Key &k) const {
+			std::size_t res = 0;
+			boost::hash_combine(res, k.ruleDom);
+			boost::hash_combine(res, k.componentDom);
+			boost::hash_combine(res, k.ruleCodom);
+			boost::hash_combine(res, k.componentCodom);
+			boost::hash_combine(res, k.enforceConstraints);
+			boost::hash_combine(res, static_cast<int> (k.labelSettings.type));
+			boost::hash_combine(res, static_cast<int> (k.labelSettings.relation));
+			boost::hash_combine(res, k.labelSettings.withStereo);
+			boost::hash_combine(res, static_cast<int> (k.labelSettings.stereoRelation));
+			return res;
+		}
+	};
+
+	struct Entry {
+		Key key;
+		Morphisms morphisms;
+		std::size_t size;
+	};
+public:
+
+	// maxSize is the maximum number of stored morphisms, where an entry without any fetched morphisms counts as a single morphism
+	explicit ComponentMorphismCache(std::size_t maxSize) : maxSize(maxSize) { }
+
+	// Returns the cached range for the key, or makes it with f() and stores it.
+	// The range is shared with the cache, so morphisms fetched through it are available to later lookups.
+	template<typename F>
+	Morphisms get(const Key &key, F f) {
+		std::lock_guard<std::mutex> lock(mutex);
+		const auto iter = index.find(key);
+		if(iter != end(index)) {
+			++numHits;
+			const auto entry = iter->second;
+			entries.splice(entries.begin(), entries, entry);
+			Morphisms morphisms = entry->morphisms;
+			const std::size_t size = getSize(morphisms);
+			currentSize = currentSize - entry->size + size;
+			entry->size = size;
+			if(size > maxSize) {
+				currentSize -= size;
+				index.erase(iter);
+				entries.erase(entry);
+				++numEvictions;
+			}
+			evict();
+			return morphisms;
+		}
+		++numMisses;
+		// nothing is fetched yet, so it is cheap to make the range while holding the lock
+		Morphisms morphisms = f();
+		const std::size_t size = getSize(morphisms);
+		entries.push_front(Entry{key, morphisms, size});
+		index.emplace(key, entries.begin());
+		currentSize += size;
+		evict();
+		return morphisms;
+	}
+
+	void printStats(std::ostream &s) const {
+		std::lock_guard<std::mutex> lock(mutex);
+		s << "Component morphism cache: hits = " << numHits
+				<< ", misses = " << numMisses
+				<< ", evictions = " << numEvictions
+				<< ", entries = " << entries.size()
+				<< ", morphisms = " << currentSize << " (max " << maxSize << ")" << std::endl;
+	}
+private:
+
+	static std::size_t getSize(const Morphisms &morphisms) {
+		return std::max<std::size_t>(1, morphisms.getNumFetched());
+	}
+
+	// the most recently used entry fits on its own, so it is never evicted
+	void evict() {
+		while(currentSize > maxSize) {
+			assert(!entries.empty());
+			const auto &last = entries.back();
+			currentSize -= last.size;
+			index.erase(last.key);
+			entries.pop_back();
+			++numEvictions;
+		}
+	}
+private:
+	const std::size_t maxSize;
+	mutable std::mutex mutex;
+	std::list<Entry> entries; // most recently used first
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+	std::size_t currentSize = 0;
+	std::size_t numHits = 0, numMisses = 0, numEvictions = 0;
+};
+
+} // namespace RC
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_RC_MATCH_MAKER_COMPONENTMORPHISMCACHE_H */
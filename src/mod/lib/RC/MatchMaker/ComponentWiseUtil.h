@@ -1,20 +1,25 @@
 #ifndef MOD_LIB_RC_MATCH_MAKER_COMPONENTWISE_UTIL_H
 #define MOD_LIB_RC_MATCH_MAKER_COMPONENTWISE_UTIL_H
 
+#include <mod/Config.h>
 #include <mod/Error.h>
 #include <mod/lib/GraphMorphism/LabelledMorphism.h>
 #include <mod/lib/GraphMorphism/VF2Finder.hpp>
 #include <mod/lib/GraphMorphism/Constraints/CheckVisitor.h>
+#include <mod/lib/RC/MatchMaker/LazyComponentMorphisms.h>
 #include <mod/lib/Rules/Real.h>
 
 #include <jla_boost/graph/FilteredWrapper.hpp>
 #include <jla_boost/graph/morphism/Predicates.hpp>
 #include <jla_boost/graph/morphism/callbacks/SliceProps.hpp>
-#include <jla_boost/graph/morphism/callbacks/Store.hpp>
 #include <jla_boost/graph/morphism/callbacks/Transform.hpp>
 #include <jla_boost/graph/morphism/callbacks/Unwrapper.hpp>
 #include <jla_boost/graph/morphism/models/Vector.hpp>
 
+#include <cassert>
+#include <limits>
+#include <vector>
+
 namespace mod {
 namespace lib {
 namespace RC {
@@ -41,8 +46,12 @@ struct WrappedComponentGraph {
 	using PropStereoType = typename Rule::PropStereoType;
 public:
 
-	WrappedComponentGraph(const ComponentGraph &g, std::size_t i, const Rule &r)
-	: g(jla_boost::makeFilteredWrapper(g)), i(i), r(r) { }
+	using VertexOrder = std::vector<typename boost::graph_traits<GraphType>::vertex_descriptor>;
+public:
+
+	// if vertexOrder is null, then the default vertex order of the component is used
+	WrappedComponentGraph(const ComponentGraph &g, std::size_t i, const Rule &r, const VertexOrder *vertexOrder)
+	: g(jla_boost::makeFilteredWrapper(g)), i(i), r(r), vertexOrder(vertexOrder) { }
 
 	friend const GraphType &get_graph(const WrappedComponentGraph<Rule> &g) {
 		return g.g;
@@ -64,19 +73,21 @@ public:
 		return get_stereo(g.r);
 	}
 
-	friend const std::vector<typename boost::graph_traits<GraphType>::vertex_descriptor>&
-	get_vertex_order(const WrappedComponentGraph<Rule> &g) {
-		return get_vertex_order_component(g.i, g.r);
+	friend const VertexOrder &get_vertex_order(const WrappedComponentGraph<Rule> &g) {
+		if(g.vertexOrder) return *g.vertexOrder;
+		else return get_vertex_order_component(g.i, g.r);
 	}
 private:
 	GraphType g;
 	std::size_t i;
 	const Rule &r;
+	const VertexOrder *vertexOrder;
 };
 
 template<typename Rule>
-WrappedComponentGraph<Rule> makeWrappedComponentGraph(const typename Rule::ComponentGraph &g, std::size_t i, const Rule &r) {
-	return WrappedComponentGraph<Rule>(g, i, r);
+WrappedComponentGraph<Rule> makeWrappedComponentGraph(const typename Rule::ComponentGraph &g, std::size_t i, const Rule &r,
+		const typename WrappedComponentGraph<Rule>::VertexOrder *vertexOrder = nullptr) {
+	return WrappedComponentGraph<Rule>(g, i, r, vertexOrder);
 }
 
 template<typename RuleSideDom, typename RuleSideCodom>
@@ -84,15 +95,45 @@ struct RuleRuleComponentMonomorphism {
 	using Morphism = GM::VectorVertexMap<typename RuleSideDom::GraphType, typename RuleSideCodom::GraphType>;
 public:
 
+	// the rule sides are copied, as they are only views of the rules
 	RuleRuleComponentMonomorphism(const RuleSideDom &rsDom, const RuleSideCodom &rsCodom, bool enforceConstraints, LabelSettings labelSettings)
-	: rsDom(rsDom), rsCodom(rsCodom), enforceConstraints(enforceConstraints), labelSettings(labelSettings) { }
+	: rsDom(rsDom), rsCodom(rsCodom), enforceConstraints(enforceConstraints), labelSettings(labelSettings),
+	orderByFrequency(getConfig().rc.vertexOrderByLabelFrequency.get() && labelSettings.type == LabelType::String) { }
 
+	// all morphisms from component idDom into component idCodom
 	std::vector<Morphism> operator()(const std::size_t idDom, const std::size_t idCodom) const {
+		return find(idDom, idCodom, GM_MOD::VF2Monomorphism(), std::numeric_limits<std::size_t>::max());
+	}
+
+	// the next at most limit morphisms, in the order the finder produces them,
+	// the finder is stopped as soon as they have been found, and resume is where it continues the next time
+	std::vector<Morphism> operator()(const std::size_t idDom, const std::size_t idCodom,
+			jla_boost::GraphMorphism::vf2_resume_point &resume, std::size_t limit) const {
+		return find(idDom, idCodom, GM_MOD::VF2MonomorphismResumable(resume), limit);
+	}
+private:
+
+	template<typename Finder>
+	std::vector<Morphism> find(const std::size_t idDom, const std::size_t idCodom, Finder finder, std::size_t limit) const {
+		assert(limit > 0);
 		std::vector<Morphism> morphisms;
-		auto mrStore = GM::makeStore(std::back_inserter(morphisms));
+		auto mrStore = [&](auto &&m, const auto&, const auto&) -> bool {
+			morphisms.push_back(std::forward<decltype(m)>(m));
+			return morphisms.size() != limit;
+		};
 		const auto &gDom = get_component_graph(idDom, rsDom);
 		const auto &gCodom = get_component_graph(idCodom, rsCodom);
-		auto wgDom = makeWrappedComponentGraph(gDom, idDom, rsDom);
+		// the order is looked up once here, as the lookup locks the cache of the rule
+		const typename WrappedComponentGraph<RuleSideDom>::VertexOrder *vertexOrder = nullptr;
+		if(orderByFrequency) {
+			const auto idsCodom = get_label_ids(get_string(rsCodom));
+			std::vector<Rules::PropStringCore::LabelId> hostIds;
+			hostIds.reserve(num_vertices(gCodom));
+			for(const auto v : asRange(vertices(gCodom)))
+				hostIds.push_back(get(idsCodom, v));
+			vertexOrder = &get_vertex_order_component(idDom, rsDom, Rules::makeLabelFrequencies(std::move(hostIds)));
+		}
+		auto wgDom = makeWrappedComponentGraph(gDom, idDom, rsDom, vertexOrder);
 		auto wgCodom = makeWrappedComponentGraph(gCodom, idCodom, rsCodom);
 
 		auto makeCheckConstraints = [&](auto &&mrNext) {
@@ -128,14 +169,17 @@ public:
 		auto predWrapper = lib::GraphMorphism::IdentityWrapper();
 
 		//				auto mrPrinter = GraphMorphism::Callback::makePrint(IO::log(), patternWrapped, targetWrapped, mrCheckConstraints);
-		lib::GraphMorphism::morphismSelectByLabelSettings(wgDom, wgCodom, labelSettings, GM_MOD::VF2Monomorphism(), mr, predWrapper, mrWrapper);
+		lib::GraphMorphism::morphismSelectByLabelSettings(wgDom, wgCodom, labelSettings, finder, mr, predWrapper, mrWrapper);
 		return morphisms;
 	}
 private:
-	const RuleSideDom &rsDom;
-	const RuleSideCodom &rsCodom;
+	const RuleSideDom rsDom;
+	const RuleSideCodom rsCodom;
 	const bool enforceConstraints;
 	const LabelSettings labelSettings;
+	// with string labels the domain vertices can be ordered by how rare their labels are in the codomain component,
+	// fixed at construction, as a resumed search must use the same order
+	const bool orderByFrequency;
 };
 
 template<typename RuleSideDom, typename RuleSideCodom>
@@ -143,6 +187,34 @@ auto makeRuleRuleComponentMonomorphism(const RuleSideDom &rsDom, const RuleSideC
 	return RuleRuleComponentMonomorphism<RuleSideDom, RuleSideCodom>(rsDom, rsCodom, enforceConstraints, labelSettings);
 }
 
+template<typename ComponentMonomorphism>
+LazyComponentMorphisms<typename ComponentMonomorphism::Morphism>
+makeLazyComponentMorphisms(ComponentMonomorphism mp, std::size_t idDom, std::size_t idCodom) {
+	// the finder is copied, as the range may outlive the caller, e.g., when it is cached
+	return LazyComponentMorphisms<typename ComponentMonomorphism::Morphism>(
+			[mp, idDom, idCodom, resume = jla_boost::GraphMorphism::vf2_resume_point()](std::size_t limit) mutable {
+				return mp(idDom, idCodom, resume, limit);
+			});
+}
+
+// Checks whether two morphisms from different pattern components into the same host map to disjoint sets of vertices,
+// i.e., whether they can both be part of an injective combined match.
+
+template<typename LabelledPatterns, typename GraphHost, typename Morphism>
+bool haveDisjointImages(const LabelledPatterns &lgPatterns, const GraphHost &gHost,
+		std::size_t idA, const Morphism &mA, std::size_t idB, const Morphism &mB) {
+	const auto &gPatterns = get_graph(lgPatterns);
+	const auto &gA = get_component_graph(idA, lgPatterns);
+	const auto &gB = get_component_graph(idB, lgPatterns);
+	for(const auto vA : asRange(vertices(gA))) {
+		const auto vHostA = get(mA, gPatterns, gHost, vA);
+		for(const auto vB : asRange(vertices(gB))) {
+			if(get(mB, gPatterns, gHost, vB) == vHostA) return false;
+		}
+	}
+	return true;
+}
+
 } // namespace RC
 } // namespace lib
 } // namespace mod
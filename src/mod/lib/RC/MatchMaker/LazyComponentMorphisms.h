@@ -0,0 +1,113 @@
+#ifndef MOD_LIB_RC_MATCH_MAKER_LAZYCOMPONENTMORPHISMS_H
+#define MOD_LIB_RC_MATCH_MAKER_LAZYCOMPONENTMORPHISMS_H
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace RC {
+
+// A range of the morphisms for a pair of components, for use in a MultiDimSelector.
+// The morphisms are fetched from a resumable finder in chunks as the range is iterated,
+// where each chunk continues the search where the previous one stopped.
+// The chunk sizes double, such that the finder is entered a logarithmic number of times.
+// Fetched morphisms are kept, as the selector restarts the ranges of the inner patterns.
+// Copies of a range share the finder and the fetched morphisms, so a range can be stored in a ComponentMorphismCache,
+// and be iterated from several threads, as fetching is serialised.
+
+template<typename Morphism>
+struct LazyComponentMorphisms {
+	// fetch(limit) returns the next morphisms from the finder, at most limit of them,
+	// and less than limit only when there are no more
+	using Fetch = std::function<std::vector<Morphism>(std::size_t limit)>;
+public:
+
+	struct const_iterator {
+		const_iterator() = default;
+
+		const_iterator(const LazyComponentMorphisms *owner, std::size_t i) : owner(owner), i(i), m(owner->fetchUntil(i)) { }
+
+		const Morphism &operator*() const {
+			assert(m);
+			return *m;
+		}
+
+		const_iterator &operator++() {
+			assert(m);
+			m = owner->fetchUntil(++i);
+			return *this;
+		}
+
+		// all iterators past the last morphism are equal
+		friend bool operator==(const const_iterator &a, const const_iterator &b) {
+			if(!a.m || !b.m) return !a.m && !b.m;
+			return a.owner == b.owner && a.i == b.i;
+		}
+
+		friend bool operator!=(const const_iterator &a, const const_iterator &b) {
+			return !(a == b);
+		}
+	private:
+		const LazyComponentMorphisms *owner = nullptr;
+		std::size_t i = 0;
+		const Morphism *m = nullptr; // null at the end
+	};
+public:
+
+	explicit LazyComponentMorphisms(Fetch fetch) : state(std::make_shared<State>(std::move(fetch))) { }
+
+	const_iterator begin() const {
+		return const_iterator(this, 0);
+	}
+
+	const_iterator end() const {
+		return const_iterator();
+	}
+
+	// the number of morphisms fetched so far
+	std::size_t getNumFetched() const {
+		std::lock_guard<std::mutex> lock(state->mutex);
+		return state->fetched.size();
+	}
+private:
+
+	// morphism number i, fetching it if needed, or null if it does not exist
+	const Morphism *fetchUntil(std::size_t i) const {
+		auto &s = *state;
+		std::lock_guard<std::mutex> lock(s.mutex);
+		const std::size_t minChunkSize = 8;
+		while(i >= s.fetched.size() && !s.exhausted) {
+			const std::size_t limit = std::max<std::size_t>(minChunkSize, s.fetched.size());
+			auto chunk = s.fetch(limit);
+			s.exhausted = chunk.size() < limit;
+			std::move(chunk.begin(), chunk.end(), std::back_inserter(s.fetched));
+		}
+		if(i < s.fetched.size()) return &s.fetched[i];
+		else return nullptr;
+	}
+private:
+
+	struct State {
+
+		explicit State(Fetch fetch) : fetch(std::move(fetch)) { }
+	public:
+		Fetch fetch;
+		std::mutex mutex;
+		std::deque<Morphism> fetched; // stable references, as iterators hold on to them while more are fetched
+		bool exhausted = false;
+	};
+	std::shared_ptr<State> state;
+};
+
+} // namespace RC
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_RC_MATCH_MAKER_LAZYCOMPONENTMORPHISMS_H */
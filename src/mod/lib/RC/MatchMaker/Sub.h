@@ -43,10 +43,16 @@ private:
 		initByLabelSettings(rFirst, rSecond, labelSettings);
 		const auto &lgCodomPatterns = get_labelled_right(rFirst.getDPORule());
 		const auto &lgDomHosts = get_labelled_left(rSecond.getDPORule());
-		auto mp = makeRuleRuleComponentMonomorphism(lgCodomPatterns, lgDomHosts, false, labelSettings);
+		auto mpCompute = makeRuleRuleComponentMonomorphism(lgCodomPatterns, lgDomHosts, false, labelSettings);
+		auto mp = [&](const std::size_t idDom, const std::size_t idCodom) {
+			return makeLazyComponentMorphisms(mpCompute, idDom, idCodom);
+		};
+		auto compatible = [&](std::size_t idA, const auto &mA, std::size_t idB, const auto &mB) {
+			return haveDisjointImages(lgCodomPatterns, get_graph(lgDomHosts), idA, mA, idB, mB);
+		};
 		auto mm = makeMultiDimSelector<AllowPartial>(
 				get_num_connected_components(lgCodomPatterns),
-				get_num_connected_components(lgDomHosts), mp);
+				get_num_connected_components(lgDomHosts), mp, compatible);
 		for(const auto &position : mm) {
 			auto maybeMap = matchFromPosition(rFirst, rSecond, position);
 			if(!maybeMap) continue;
@@ -7,6 +7,7 @@
 #include <mod/lib/Graph/Single.h>
 #include <mod/lib/IO/IO.h>
 #include <mod/lib/IO/Rule.h>
+#include <mod/lib/RC/MatchMaker/ComponentMorphismCache.h>
 #include <mod/lib/RC/MatchMaker/ComponentWiseUtil.h>
 #include <mod/lib/RC/MatchMaker/LabelledMatch.h>
 #include <mod/lib/Rules/Properties/Term.h>
@@ -26,7 +27,11 @@ struct Super {
 	using VertexMapType = jla_boost::GraphMorphism::InvertibleVectorVertexMap<GraphDom, GraphCodom>;
 public:
 
-	Super(bool allowPartial, bool enforceConstraints) : allowPartial(allowPartial), enforceConstraints(enforceConstraints) { }
+	Super(bool allowPartial, bool enforceConstraints) : Super(allowPartial, enforceConstraints, nullptr) { }
+
+	// the component morphisms are taken from the cache, if it is not null
+	Super(bool allowPartial, bool enforceConstraints, ComponentMorphismCache *morphismCache)
+	: allowPartial(allowPartial), enforceConstraints(enforceConstraints), morphismCache(morphismCache) { }
 
 	void makeMatches(const auto &rFirst, const auto &rSecond, auto &&mr, LabelSettings labelSettings) const {
 		if(allowPartial)
@@ -66,10 +71,20 @@ private:
 		//			IO::log() << "\n";
 		//		}
 		//		IO::log() << std::endl;
-		auto mp = makeRuleRuleComponentMonomorphism(lgDomPatterns, lgCodomHosts, enforceConstraints, labelSettings);
+		auto mpCompute = makeRuleRuleComponentMonomorphism(lgDomPatterns, lgCodomHosts, enforceConstraints, labelSettings);
+		auto mp = [&](const std::size_t idDom, const std::size_t idCodom) {
+			if(!morphismCache) return makeLazyComponentMorphisms(mpCompute, idDom, idCodom);
+			const auto key = ComponentMorphismCache::Key{rSecond.getId(), idDom, rFirst.getId(), idCodom, enforceConstraints, labelSettings};
+			return morphismCache->get(key, [&]() {
+				return makeLazyComponentMorphisms(mpCompute, idDom, idCodom);
+			});
+		};
+		auto compatible = [&](std::size_t idA, const auto &mA, std::size_t idB, const auto &mB) {
+			return haveDisjointImages(lgDomPatterns, get_graph(lgCodomHosts), idA, mA, idB, mB);
+		};
 		auto mm = makeMultiDimSelector<AllowPartial>(
 				get_num_connected_components(lgDomPatterns),
-				get_num_connected_components(lgCodomHosts), mp);
+				get_num_connected_components(lgCodomHosts), mp, compatible);
 		for(const auto &position : mm) {
 			auto maybeMap = matchFromPosition(rFirst, rSecond, position);
 			if(!maybeMap) continue;
@@ -84,6 +99,7 @@ public:
 private:
 	bool allowPartial;
 	bool enforceConstraints;
+	ComponentMorphismCache *morphismCache;
 };
 
 template<typename Position>
@@ -5,16 +5,75 @@
 #include <mod/lib/Stereo/CloneUtil.h>
 #include <mod/lib/Stereo/Inference.h>
 
+#include <jla_boost/graph/BFSDistances.hpp>
+#include <jla_boost/graph/morphism/VertexOrderByRarity.hpp>
+
 #include <boost/graph/connected_components.hpp>
 
+#include <algorithm>
+
 namespace mod {
 namespace lib {
 namespace Rules {
+namespace {
+
+template<typename LabelledSide>
+const std::vector<boost::graph_traits<GraphType>::vertex_descriptor>&
+getVertexOrderComponent(std::size_t i, const LabelledSide &g, const LabelFrequencies &hostFrequencies) {
+	assert(i < get_num_connected_components(g));
+	const auto gComponent = get_component_graph(i, g);
+	const auto ids = get_label_ids(get_string(g));
+	const auto idx = get(boost::vertex_index_t(), gComponent);
+	std::vector<unsigned char> rarity(num_vertices(gComponent), 0);
+	std::vector<unsigned char> buckets;
+	for(const auto v : asRange(vertices(gComponent))) {
+		const auto id = get(ids, v);
+		const auto iter = std::lower_bound(hostFrequencies.begin(), hostFrequencies.end(), id, [](const auto &p, const auto id) {
+			return p.first < id;
+		});
+		std::size_t count = iter == hostFrequencies.end() || iter->first != id ? 0 : iter->second;
+		unsigned char bucket = 0;
+		for(; count != 0; count /= 2) ++bucket;
+		rarity[get(idx, v)] = bucket;
+		buckets.push_back(bucket);
+	}
+	auto &cache = *g.r.vertexOrderCache;
+	std::lock_guard<std::mutex> lock(cache.mutex);
+	auto key = std::make_tuple(g.m, i, std::move(buckets));
+	const auto iter = cache.orders.find(key);
+	if(iter != end(cache.orders)) return iter->second;
+	auto order = jla_boost::GraphMorphism::vertex_order_by_rarity(gComponent, [&](const auto v) {
+		return rarity[get(idx, v)];
+	});
+	return cache.orders.emplace(std::move(key), std::move(order)).first->second;
+}
+
+template<typename LabelledSide>
+const std::vector<int> &getShortestPathDistances(const LabelledSide &g, boost::graph_traits<GraphType>::vertex_descriptor v) {
+	auto &cache = *g.r.distanceCache;
+	std::lock_guard<std::mutex> lock(cache.mutex);
+	const auto key = std::make_pair(g.m, v);
+	const auto iter = cache.distances.find(key);
+	if(iter != end(cache.distances)) return iter->second;
+	return cache.distances.emplace(key, jla_boost::bfs_distances(get_graph(g), v)).first->second;
+}
+
+} // namespace
+
+LabelFrequencies makeLabelFrequencies(std::vector<PropStringCore::LabelId> ids) {
+	std::sort(ids.begin(), ids.end());
+	LabelFrequencies frequencies;
+	for(const auto id : ids) {
+		if(frequencies.empty() || frequencies.back().first != id) frequencies.emplace_back(id, 0);
+		++frequencies.back().second;
+	}
+	return frequencies;
+}
 
 // LabelledRule
 //------------------------------------------------------------------------------
 
-LabelledRule::LabelledRule() : g(new GraphType()) { }
+LabelledRule::LabelledRule() : g(new GraphType()), vertexOrderCache(new VertexOrderCache()), distanceCache(new DistanceCache()) { }
 
 LabelledRule::LabelledRule(const LabelledRule &other, bool withConstraints) : LabelledRule() {
 	auto &g = *this->g;
@@ -103,6 +162,8 @@ void LabelledRule::invert() {
 	swap(this->leftMatchConstraints, this->rightMatchConstraints);
 	// clear cached stuff
 	this->projs.reset();
+	this->vertexOrderCache->orders.clear();
+	this->distanceCache->distances.clear();
 }
 
 GraphType &get_graph(LabelledRule &r) {
@@ -292,6 +353,15 @@ get_vertex_order_component(std::size_t i, const LabelledLeftGraph &g) {
 	return g.vertex_orders[i];
 }
 
+const std::vector<boost::graph_traits<GraphType>::vertex_descriptor>&
+get_vertex_order_component(std::size_t i, const LabelledLeftGraph &g, const LabelFrequencies &hostFrequencies) {
+	return getVertexOrderComponent(i, g, hostFrequencies);
+}
+
+const std::vector<int> &get_shortest_path_distances(const LabelledLeftGraph &g, boost::graph_traits<GraphType>::vertex_descriptor v) {
+	return getShortestPathDistances(g, v);
+}
+
 // LabelledRightGraph
 //------------------------------------------------------------------------------
 
@@ -349,6 +419,15 @@ get_vertex_order_component(std::size_t i, const LabelledRightGraph &g) {
 	return g.vertex_orders[i];
 }
 
+const std::vector<boost::graph_traits<GraphType>::vertex_descriptor>&
+get_vertex_order_component(std::size_t i, const LabelledRightGraph &g, const LabelFrequencies &hostFrequencies) {
+	return getVertexOrderComponent(i, g, hostFrequencies);
+}
+
+const std::vector<int> &get_shortest_path_distances(const LabelledRightGraph &g, boost::graph_traits<GraphType>::vertex_descriptor v) {
+	return getShortestPathDistances(g, v);
+}
+
 } // namespace Rules
 } // namespace lib
 } // namespace mod
\ No newline at end of file
@@ -9,6 +9,10 @@
 #include <mod/lib/Rules/Properties/String.h>
 #include <mod/lib/Rules/Properties/Term.h>
 
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace mod {
@@ -84,8 +88,28 @@ private:
 public:
 	std::size_t numLeftComponents = -1, numRightComponents = -1;
 	std::vector<std::size_t> leftComponents, rightComponents;
+public:
+
+	// the component vertex orders selected by host label frequencies, see get_vertex_order_component
+	struct VertexOrderCache {
+		std::mutex mutex;
+		std::map<std::tuple<jla_boost::GraphDPO::Membership, std::size_t, std::vector<unsigned char> >, std::vector<Vertex> > orders;
+	};
+	std::unique_ptr<VertexOrderCache> vertexOrderCache;
+
+	// the shortest path distances in each side graph, by source vertex, see get_shortest_path_distances
+	struct DistanceCache {
+		std::mutex mutex;
+		std::map<std::pair<jla_boost::GraphDPO::Membership, Vertex>, std::vector<int> > distances;
+	};
+	std::unique_ptr<DistanceCache> distanceCache;
 };
 
+// the number of occurrences of each interned label in a host graph, as (label id, count) sorted by label id
+using LabelFrequencies = std::vector<std::pair<PropStringCore::LabelId, std::size_t> >;
+// counts the given label ids
+LabelFrequencies makeLabelFrequencies(std::vector<PropStringCore::LabelId> ids);
+
 namespace detail {
 
 struct LabelledSideGraph {
@@ -129,6 +153,14 @@ public:
 public:
 	friend const std::vector<boost::graph_traits<GraphType>::vertex_descriptor>&
 	get_vertex_order_component(std::size_t i, const LabelledLeftGraph &g);
+	// the vertex order of component i for matching into a host with the given label frequencies,
+	// the orders are cached in the rule by the logarithmically bucketed frequencies of the component labels
+	friend const std::vector<boost::graph_traits<GraphType>::vertex_descriptor>&
+	get_vertex_order_component(std::size_t i, const LabelledLeftGraph &g, const LabelFrequencies &hostFrequencies);
+	// the number of edges on a shortest path from v to each vertex, indexed by vertex index,
+	// with std::numeric_limits<int>::max() for unreachable vertices,
+	// the distances are computed on first use and cached in the rule
+	friend const std::vector<int> &get_shortest_path_distances(const LabelledLeftGraph &g, boost::graph_traits<GraphType>::vertex_descriptor v);
 };
 
 struct LabelledRightGraph : detail::LabelledSideGraph {
@@ -156,6 +188,14 @@ public:
 public:
 	friend const std::vector<boost::graph_traits<GraphType>::vertex_descriptor>&
 	get_vertex_order_component(std::size_t i, const LabelledRightGraph &g);
+	// the vertex order of component i for matching into a host with the given label frequencies,
+	// the orders are cached in the rule by the logarithmically bucketed frequencies of the component labels
+	friend const std::vector<boost::graph_traits<GraphType>::vertex_descriptor>&
+	get_vertex_order_component(std::size_t i, const LabelledRightGraph &g, const LabelFrequencies &hostFrequencies);
+	// the number of edges on a shortest path from v to each vertex, indexed by vertex index,
+	// with std::numeric_limits<int>::max() for unreachable vertices,
+	// the distances are computed on first use and cached in the rule
+	friend const std::vector<int> &get_shortest_path_distances(const LabelledRightGraph &g, boost::graph_traits<GraphType>::vertex_descriptor v);
 };
 
 } // namespace Rules
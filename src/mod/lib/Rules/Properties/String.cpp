@@ -4,6 +4,10 @@
 #include <mod/lib//IO/Term.h>
 #include <mod/lib/Rules/Properties/Term.h>
 #include <mod/lib/StringStore.h>
+#include <mod/lib/Term/WAM.h>
+
+#include <cassert>
+#include <limits>
 
 namespace mod {
 namespace lib {
@@ -54,6 +58,12 @@ PropStringCore::PropStringCore(const GraphType &g,
 			break;
 		}
 	}
+	vertexIds.reserve(vertexState.size());
+	for(const auto &vs : vertexState)
+		vertexIds.emplace_back(intern(vs.left), intern(vs.right));
+	edgeIds.reserve(edgeState.size());
+	for(const auto &es : edgeState)
+		edgeIds.emplace_back(intern(es.left), intern(es.right));
 
 	using HandlerType = decltype(termToString);
 
@@ -83,6 +93,69 @@ PropStringCore::PropStringCore(const GraphType &g,
 	handleConstraints(rightMatchConstraints);
 }
 
+void PropStringCore::invert() {
+	Base::invert();
+	using std::swap;
+	for(auto &ids : vertexIds) swap(ids.first, ids.second);
+	for(auto &ids : edgeIds) swap(ids.first, ids.second);
+}
+
+void PropStringCore::add(Vertex v, const std::string &valueLeft, const std::string &valueRight) {
+	Base::add(v, valueLeft, valueRight);
+	vertexIds.emplace_back(intern(valueLeft), intern(valueRight));
+}
+
+void PropStringCore::add(Edge e, const std::string &valueLeft, const std::string &valueRight) {
+	Base::add(e, valueLeft, valueRight);
+	edgeIds.emplace_back(intern(valueLeft), intern(valueRight));
+}
+
+void PropStringCore::setLeft(Vertex v, const std::string &value) {
+	Base::setLeft(v, value);
+	vertexIds[get(boost::vertex_index_t(), g, v)].first = intern(value);
+}
+
+void PropStringCore::setRight(Vertex v, const std::string &value) {
+	Base::setRight(v, value);
+	vertexIds[get(boost::vertex_index_t(), g, v)].second = intern(value);
+}
+
+void PropStringCore::setLeft(Edge e, const std::string &value) {
+	Base::setLeft(e, value);
+	edgeIds[get(boost::edge_index_t(), g, e)].first = intern(value);
+}
+
+void PropStringCore::setRight(Edge e, const std::string &value) {
+	Base::setRight(e, value);
+	edgeIds[get(boost::edge_index_t(), g, e)].second = intern(value);
+}
+
+PropStringCore::LabelId PropStringCore::getLeftId(Vertex v) const {
+	assert(g[v].membership != Membership::Right);
+	return vertexIds[get(boost::vertex_index_t(), g, v)].first;
+}
+
+PropStringCore::LabelId PropStringCore::getLeftId(Edge e) const {
+	assert(g[e].membership != Membership::Right);
+	return edgeIds[get(boost::edge_index_t(), g, e)].first;
+}
+
+PropStringCore::LabelId PropStringCore::getRightId(Vertex v) const {
+	assert(g[v].membership != Membership::Left);
+	return vertexIds[get(boost::vertex_index_t(), g, v)].second;
+}
+
+PropStringCore::LabelId PropStringCore::getRightId(Edge e) const {
+	assert(g[e].membership != Membership::Left);
+	return edgeIds[get(boost::edge_index_t(), g, e)].second;
+}
+
+PropStringCore::LabelId PropStringCore::intern(const std::string &label) {
+	const auto id = lib::Term::getStrings().getIndex(label);
+	assert(id <= std::numeric_limits<LabelId>::max());
+	return id;
+}
+
 } // namespace Rules
 } // namespace lib
 } // namespace mod
\ No newline at end of file
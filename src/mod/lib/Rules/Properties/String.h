@@ -5,17 +5,24 @@
 #include <mod/lib/Rules/GraphDecl.h>
 #include <mod/lib/Rules/Properties/Property.h>
 
+#include <cstdint>
+
 namespace mod {
 namespace lib {
 struct StringStore;
 namespace Rules {
 struct PropTermCore;
 
+// The labels are stored as strings, and additionally interned in the global string store, lib::Term::getStrings(),
+// so they can be compared by their ids, also with the labels of graphs, see Graph::PropString.
+
 struct PropStringCore : PropCore<PropStringCore, GraphType, std::string, std::string> {
+	using Base = PropCore<PropStringCore, GraphType, std::string, std::string>;
 	using ConstraintPtr = std::unique_ptr<GraphMorphism::Constraints::Constraint<SideGraphType> >;
+	using LabelId = std::uint32_t;
 public:
 
-	explicit PropStringCore(const GraphType &g) : PropCore(g) {
+	explicit PropStringCore(const GraphType &g) : Base(g) {
 		verify(&g);
 	}
 
@@ -23,6 +30,48 @@ public:
 			const std::vector<ConstraintPtr> &leftMatchConstraints,
 			const std::vector<ConstraintPtr> &rightMatchConstraints,
 			const PropTermCore &term, const StringStore &strings);
+public: // the modifiers of PropCore, keeping the ids up to date
+	void invert();
+	void add(Vertex v, const std::string &valueLeft, const std::string &valueRight);
+	void add(Edge e, const std::string &valueLeft, const std::string &valueRight);
+	void setLeft(Vertex v, const std::string &value);
+	void setRight(Vertex v, const std::string &value);
+	void setLeft(Edge e, const std::string &value);
+	void setRight(Edge e, const std::string &value);
+public:
+	LabelId getLeftId(Vertex v) const;
+	LabelId getLeftId(Edge e) const;
+	LabelId getRightId(Vertex v) const;
+	LabelId getRightId(Edge e) const;
+private:
+	static LabelId intern(const std::string &label);
+private:
+	// (left, right) ids, indexed as vertexState and edgeState
+	std::vector<std::pair<LabelId, LabelId> > vertexIds, edgeIds;
+public:
+
+	// A view of the label ids of one side, as a property.
+
+	template<bool IsLeft>
+	struct Ids {
+
+		explicit Ids(const PropStringCore &p) : p(p) { }
+
+		template<typename VertexOrEdge>
+		friend LabelId get(const Ids &ids, VertexOrEdge ve) {
+			return IsLeft ? ids.p.getLeftId(ve) : ids.p.getRightId(ve);
+		}
+	private:
+		const PropStringCore &p;
+	};
+
+	friend Ids<true> get_label_ids(const LeftType &p) {
+		return Ids<true>(p.state.getDerived());
+	}
+
+	friend Ids<false> get_label_ids(const RightType &p) {
+		return Ids<false>(p.state.getDerived());
+	}
 };
 
 } // namespace Rules
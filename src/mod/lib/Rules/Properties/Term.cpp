@@ -8,6 +8,8 @@
 
 #include <jla_boost/graph/PairToRangeAdaptor.hpp>
 
+#include <algorithm>
+
 namespace mod {
 namespace lib {
 namespace Rules {
@@ -35,6 +37,12 @@ PropTermCore::PropTermCore(const GraphType &core,
 		}
 		lib::Term::Address addr = lib::Term::append(machine, *rawTerm, varToAddr);
 		labelToAddress[label] = addr.addr;
+		// ground terms are always appended, so their addresses are increasing
+		const auto groundTermId = lib::Term::getGroundTerms().getId(machine, addr);
+		if(groundTermId != lib::Term::GroundTermStore::NotGround) {
+			assert(groundTermIds.empty() || groundTermIds.back().first < addr.addr);
+			groundTermIds.emplace_back(addr.addr, groundTermId);
+		}
 		return addr.addr;
 	};
 	vertexState.resize(num_vertices(core));
@@ -108,10 +116,14 @@ PropTermCore::PropTermCore(const GraphType &core,
 	};
 	handleConstraints(leftMatchConstraints);
 	handleConstraints(rightMatchConstraints);
+	// the machine is copied for each unification, so let the copies share the parsed terms
+	machine.share();
 	verify(&this->g);
 }
 
-PropTermCore::PropTermCore(const GraphType &core, lib::Term::Wam machine) : Base(core), machine(std::move(machine)) { }
+PropTermCore::PropTermCore(const GraphType &core, lib::Term::Wam machine) : Base(core), machine(std::move(machine)) {
+	this->machine.share();
+}
 
 bool isValid(const PropTermCore &core) {
 	return !core.parsingError.is_initialized();
@@ -130,6 +142,15 @@ const lib::Term::Wam &getMachine(const PropTermCore &core) {
 	return core.machine;
 }
 
+lib::Term::GroundTermStore::Id getGroundTermId(const PropTermCore &core, std::size_t addr) {
+	const auto iter = std::lower_bound(core.groundTermIds.begin(), core.groundTermIds.end(), addr,
+			[](const auto &pair, std::size_t addr) {
+				return pair.first < addr;
+			});
+	if(iter == core.groundTermIds.end() || iter->first != addr) return lib::Term::GroundTermStore::NotGround;
+	return iter->second;
+}
+
 } // namespace Rules
 } // namespace lib
 } // namespace mod
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <mod/lib/GraphMorphism/Constraints/Constraint.h>
 #include <mod/lib/Rules/GraphDecl.h>
 #include <mod/lib/Rules/Properties/Property.h>
+#include <mod/lib/Term/GroundTermStore.h>
 #include <mod/lib/Term/WAM.h>
 
 #include <boost/optional.hpp>
@@ -28,9 +29,13 @@ public:
 	const std::string &getParsingError() const;
 	friend lib::Term::Wam &getMachine(PropTermCore &core);
 	friend const lib::Term::Wam &getMachine(const PropTermCore &core);
+	// returns the id in lib::Term::getGroundTerms() of the label term at the given address,
+	// or NotGround if it is not ground or the machine was imported
+	friend lib::Term::GroundTermStore::Id getGroundTermId(const PropTermCore &core, std::size_t addr);
 private:
 	boost::optional<std::string> parsingError;
 	lib::Term::Wam machine;
+	std::vector<std::pair<std::size_t, lib::Term::GroundTermStore::Id> > groundTermIds; // sorted by address
 };
 
 inline const lib::Term::Wam &getMachine(const PropTermCore::LeftType &p) {
@@ -41,6 +46,10 @@ inline bool isValid(const PropTermCore::LeftType &p) {
 	return isValid(p.state.getDerived());
 }
 
+inline lib::Term::GroundTermStore::Id getGroundTermId(const PropTermCore::LeftType &p, std::size_t addr) {
+	return getGroundTermId(p.state.getDerived(), addr);
+}
+
 inline const lib::Term::Wam &getMachine(const PropTermCore::RightType &p) {
 	return getMachine(p.state.getDerived());
 }
@@ -49,6 +58,10 @@ inline bool isValid(const PropTermCore::RightType &p) {
 	return isValid(p.state.getDerived());
 }
 
+inline lib::Term::GroundTermStore::Id getGroundTermId(const PropTermCore::RightType &p, std::size_t addr) {
+	return getGroundTermId(p.state.getDerived(), addr);
+}
+
 } // namespace Rules
 } // namespace lib
 } // namespace mod
@@ -19,8 +19,11 @@
 
 #include <jla_boost/graph/morphism/callbacks/Limit.hpp>
 
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <atomic>
+
 namespace mod {
 namespace lib {
 namespace Rules {
@@ -74,7 +77,7 @@ bool Real::sanityChecks(const GraphType &core, const PropStringCore &labelState,
 }
 
 namespace {
-std::size_t nextRuleNum = 0;
+std::atomic<std::size_t> nextRuleNum(0);
 } // namespace 
 
 Real::Real(LabelledRule &&rule, boost::optional<LabelType> labelType)
@@ -181,6 +184,55 @@ const PropMoleculeCore &Real::getMoleculeState() const {
 	return get_molecule(getDPORule());
 }
 
+std::size_t Real::getInvariantHash(LabelType labelType) const {
+	const int idx = labelType == LabelType::String ? 0 : 1;
+	std::call_once((*invariantHashFlags)[idx], [this, labelType, idx]() {
+		invariantHash[idx] = computeInvariantHash(labelType);
+	});
+	return invariantHash[idx];
+}
+
+std::size_t Real::computeInvariantHash(LabelType labelType) const {
+	const auto &core = getGraph();
+	// terms are only isomorphic up to renaming of variables, so use only the structure for them
+	const bool withLabels = labelType == LabelType::String;
+	const auto combineLabels = [this, &core](std::size_t &h, const auto &ve) {
+		const auto &str = getStringState();
+		const auto m = core[ve].membership;
+		if(m != Membership::Right) boost::hash_combine(h, str.getLeft()[ve]);
+		if(m != Membership::Left) boost::hash_combine(h, str.getRight()[ve]);
+	};
+	std::size_t res = 0;
+	boost::hash_combine(res, num_vertices(core));
+	boost::hash_combine(res, num_edges(core));
+	std::vector<std::size_t> vData, eData;
+	vData.reserve(num_vertices(core));
+	eData.reserve(num_edges(core));
+	for(Vertex v : asRange(vertices(core))) {
+		std::size_t vHash = 0;
+		boost::hash_combine(vHash, static_cast<int> (core[v].membership));
+		boost::hash_combine(vHash, out_degree(v, core));
+		if(withLabels) combineLabels(vHash, v);
+		vData.push_back(vHash);
+	}
+	for(Edge e : asRange(edges(core))) {
+		std::size_t vSrc = vData[get(boost::vertex_index_t(), core, source(e, core))];
+		std::size_t vTar = vData[get(boost::vertex_index_t(), core, target(e, core))];
+		if(vSrc > vTar) std::swap(vSrc, vTar);
+		std::size_t eHash = 0;
+		boost::hash_combine(eHash, vSrc);
+		boost::hash_combine(eHash, vTar);
+		boost::hash_combine(eHash, static_cast<int> (core[e].membership));
+		if(withLabels) combineLabels(eHash, e);
+		eData.push_back(eHash);
+	}
+	std::sort(begin(vData), end(vData));
+	std::sort(begin(eData), end(eData));
+	boost::hash_range(res, begin(vData), end(vData));
+	boost::hash_range(res, begin(eData), end(eData));
+	return res;
+}
+
 namespace {
 
 template<typename Finder>
@@ -11,6 +11,10 @@
 
 #include <boost/optional/optional.hpp>
 
+#include <array>
+#include <memory>
+#include <mutex>
+
 namespace mod {
 namespace lib {
 namespace Graph {
@@ -50,9 +54,15 @@ public: // deprecated
 	const PropStringCore &getStringState() const;
 	const PropTermCore &getTermState() const;
 	const PropMoleculeCore &getMoleculeState() const;
+public:
+	// a hash value which is invariant under isomorphism with the given label type,
+	// i.e., isomorphic rules have the same value, but the reverse may not be true
+	std::size_t getInvariantHash(LabelType labelType) const;
 public:
 	static std::size_t isomorphism(const Real &rDom, const Real &rCodom, std::size_t maxNumMatches, LabelSettings labelSettings);
 	static std::size_t monomorphism(const Real &rDom, const Real &rCodom, std::size_t maxNumMatches, LabelSettings labelSettings);
+private:
+	std::size_t computeInvariantHash(LabelType labelType) const;
 private:
 	const std::size_t id;
 	std::weak_ptr<rule::Rule> apiReference;
@@ -61,6 +71,8 @@ private:
 private:
 	LabelledRule dpoRule;
 	mutable std::unique_ptr<DepictionDataCore> depictionData;
+	mutable std::unique_ptr<std::array<std::once_flag, 2> > invariantHashFlags = std::make_unique<std::array<std::once_flag, 2> >(); // indexed by label type
+	mutable std::array<std::size_t, 2> invariantHash;
 };
 
 struct LessById {
@@ -7,6 +7,7 @@ namespace mod {
 namespace lib {
 
 bool StringStore::hasString(const std::string &s) const {
+	std::lock_guard<std::mutex> lock(mutex);
 	return index.find(s) != end(index);
 }
 
@@ -20,24 +21,43 @@ std::size_t StringStore::getIndex(const std::string &s) const {
 			std::cout << "StringStore getIndex(" << s << ")" << std::endl;
 			std::cout << "================================================" << std::endl;
 			for(const auto &p : store.index) {
-				assert(p.second < store.strings.size());
-				assert(store.strings[p.second] == p.first);
+				assert(p.second < store.numStrings);
+				assert(store.getString(p.second) == p.first);
 				std::cout << "\t" << p.second << " -> " << p.first << std::endl;
 			}
 		}
 	private:
 		const StringStore &store;
 		const std::string &s;
-	} /*doPrint(*this, s)*/;
-	auto pIter = index.emplace(s, strings.size());
-	if(pIter.second) strings.push_back(s);
+	};
+	std::lock_guard<std::mutex> lock(mutex);
+	/*DoPrint doPrint(*this, s);*/
+	auto pIter = index.emplace(s, numStrings);
+	if(pIter.second) {
+		const auto chunkAndOffset = getChunkAndOffset(numStrings);
+		assert(chunkAndOffset.first < chunks.size());
+		auto &chunk = chunks[chunkAndOffset.first];
+		if(!chunk) chunk.reset(new std::string[FirstChunkSize << chunkAndOffset.first]);
+		chunk[chunkAndOffset.second] = s;
+		++numStrings;
+	}
 	return pIter.first->second;
 }
 
 const std::string &StringStore::getString(std::size_t index) const {
-	assert(index < strings.size());
-	return strings[index];
+	// the index was handed out by getIndex, after the string was stored, so we don't need to lock
+	const auto chunkAndOffset = getChunkAndOffset(index);
+	assert(chunks[chunkAndOffset.first]);
+	return chunks[chunkAndOffset.first][chunkAndOffset.second];
+}
+
+std::pair<std::size_t, std::size_t> StringStore::getChunkAndOffset(std::size_t index) {
+	// chunk k starts at FirstChunkSize * (2^k - 1), i.e., it is the position of the highest set bit in index / FirstChunkSize + 1
+	const unsigned long long q = index / FirstChunkSize + 1;
+	const std::size_t chunk = 8 * sizeof (q) - 1 - __builtin_clzll(q);
+	const std::size_t chunkBegin = FirstChunkSize * ((std::size_t(1) << chunk) - 1);
+	return std::make_pair(chunk, index - chunkBegin);
 }
 
 } // namespace lib
-} // namespace mod
\ No newline at end of file
+} // namespace mod
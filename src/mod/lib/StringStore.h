@@ -1,13 +1,18 @@
 #ifndef MOD_LIB_STRINGSTORE_H
 #define	MOD_LIB_STRINGSTORE_H
 
-#include <map>
+#include <array>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <vector>
+#include <unordered_map>
 
 namespace mod {
 namespace lib {
 
+// Interns strings as consecutive indices.
+// All operations are thread safe, and references returned by getString stay valid for the lifetime of the store.
+
 struct StringStore {
 	StringStore() = default;
 	StringStore(const StringStore&) = delete;
@@ -18,11 +23,18 @@ struct StringStore {
 	std::size_t getIndex(const std::string &s) const;
 	const std::string &getString(std::size_t index) const;
 private:
-	mutable std::vector<std::string> strings;
-	mutable std::map<std::string, std::size_t> index;
+	// chunk k holds FirstChunkSize * 2^k strings, and chunks are never moved,
+	// so getString can read without locking
+	static constexpr std::size_t FirstChunkSize = 64;
+	static std::pair<std::size_t, std::size_t> getChunkAndOffset(std::size_t index);
+private:
+	mutable std::mutex mutex;
+	mutable std::array<std::unique_ptr<std::string[]>, 32> chunks;
+	mutable std::size_t numStrings = 0;
+	mutable std::unordered_map<std::string, std::size_t> index;
 };
 
 } // namespace lib
 } // namespace mod
 
-#endif	/* MOD_LIB_STRINGSTORE_H */
\ No newline at end of file
+#endif	/* MOD_LIB_STRINGSTORE_H */
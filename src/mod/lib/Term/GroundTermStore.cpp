@@ -0,0 +1,52 @@
+#include "GroundTermStore.h"
+
+#include <mod/Config.h>
+#include <mod/lib/Term/WAM.h>
+
+#include <cassert>
+
+namespace mod {
+namespace lib {
+namespace Term {
+
+constexpr GroundTermStore::Id GroundTermStore::NotGround;
+
+GroundTermStore::Id GroundTermStore::getId(const Wam &machine, Address addr) {
+	addr = machine.deref(addr);
+	const Cell cell = machine.getCell(addr);
+	if(cell.getTag() == CellTag::REF) return NotGround;
+	assert(cell.getTag() == CellTag::Structure);
+	std::vector<Id> key;
+	key.reserve(cell.getArity() + 1);
+	assert(cell.getName() < NotGround);
+	key.push_back(cell.getName());
+	for(std::size_t i = 1; i <= cell.getArity(); ++i) {
+		const auto argId = getId(machine, addr + i);
+		if(argId == NotGround) return NotGround;
+		key.push_back(argId);
+	}
+	return intern(key);
+}
+
+std::size_t GroundTermStore::size() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return index.size();
+}
+
+GroundTermStore::Id GroundTermStore::intern(const std::vector<Id> &key) {
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto iter = index.find(key);
+	if(iter != index.end()) return iter->second;
+	if(index.size() >= getConfig().unification.groundTermStoreLimit.get()) return NotGround;
+	assert(index.size() < NotGround);
+	return index.emplace(key, index.size()).first->second;
+}
+
+GroundTermStore &getGroundTerms() {
+	static GroundTermStore terms;
+	return terms;
+}
+
+} // namespace Term
+} // namespace lib
+} // namespace mod
@@ -0,0 +1,54 @@
+#ifndef MOD_LIB_TERM_GROUNDTERMSTORE_H
+#define MOD_LIB_TERM_GROUNDTERMSTORE_H
+
+#include <boost/functional/hash.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace Term {
+struct Address;
+struct Wam;
+
+// Hash-conses ground terms as consecutive ids, across all machines.
+// A ground term is interned as its name and the ids of its arguments,
+// so two ground terms are structurally equal if and only if their ids are equal.
+// It is a speed-up for label matching only: the cells of the terms are still stored in each machine,
+// so the ids and the store take memory in addition to them.
+// The store lives as long as the program, and is never pruned, so it is bounded by
+// the unification.groundTermStoreLimit setting. When it is full, new terms are not interned,
+// and are compared structurally instead.
+// All operations are thread safe.
+
+struct GroundTermStore {
+	using Id = std::uint32_t;
+	static constexpr Id NotGround = std::numeric_limits<Id>::max();
+public:
+	GroundTermStore() = default;
+	GroundTermStore(const GroundTermStore&) = delete;
+	GroundTermStore(GroundTermStore&&) = delete;
+	GroundTermStore &operator=(const GroundTermStore&) = delete;
+	GroundTermStore &operator=(GroundTermStore&&) = delete;
+	// returns NotGround if the term contains a variable, or if the store is full and the term is not in it
+	Id getId(const Wam &machine, Address addr);
+	std::size_t size() const;
+private:
+	Id intern(const std::vector<Id> &key);
+private:
+	mutable std::mutex mutex;
+	// (name, ids of the arguments) -> id
+	std::unordered_map<std::vector<Id>, Id, boost::hash<std::vector<Id> > > index;
+};
+
+GroundTermStore &getGroundTerms();
+
+} // namespace Term
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TERM_GROUNDTERMSTORE_H */
@@ -51,7 +51,7 @@ Address append(Wam &machine, const RawTerm &term, RawAppendStore &varToAddr) {
 						varToAddr.emplace(var->name, vAddr);
 					} else {
 						auto addr = machine.putRefPtr();
-						machine.getCell(addr).REF.addr = iter->second;
+						machine.setCell(addr, Cell::makeREF(iter->second));
 					}
 				} else {
 					const RawStructure &str = boost::get<RawStructure>(term);
@@ -4,8 +4,11 @@
 #include <mod/Error.h>
 
 #include <cassert>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <stack>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -54,49 +57,73 @@ public:
 	friend std::ostream &operator<<(std::ostream &s, Address addr);
 };
 
+// A cell is packed into 64 bits:
+// - bits 0-1: the tag,
+// - STR and REF: bit 2 is the address type, and bits 32-63 the address,
+// - Structure: bits 2-31 are the arity, and bits 32-63 the name.
+
 struct Cell {
-	CellTag tag;
+	Cell() = default;
+
+	CellTag getTag() const {
+		return CellTag(data & TagMask);
+	}
 
-	union {
+	// requires: getTag() != CellTag::Structure
+	Address getAddr() const {
+		assert(getTag() != CellTag::Structure);
+		return Address{AddressType((data >> 2) & 1), std::size_t(data >> 32)};
+	}
 
-		struct {
-			Address addr;
-		} STR;
+	// requires: getTag() != CellTag::Structure
+	void setAddr(Address addr) {
+		assert(getTag() != CellTag::Structure);
+		data = (data & TagMask) | packAddr(addr);
+	}
 
-		struct {
-			Address addr;
-		} REF;
+	// requires: getTag() == CellTag::Structure
+	std::size_t getArity() const {
+		assert(getTag() == CellTag::Structure);
+		return (data >> 2) & ArityMask;
+	}
 
-		struct {
-			std::size_t arity;
-			std::size_t name;
-		} Structure;
-	};
+	// requires: getTag() == CellTag::Structure
+	std::size_t getName() const {
+		assert(getTag() == CellTag::Structure);
+		return std::size_t(data >> 32);
+	}
 public:
 
 	static Cell makeSTR(Address addr) {
-		Cell cell;
-		cell.tag = CellTag::STR;
-		cell.STR.addr = addr;
-		return cell;
+		return Cell(std::uint64_t(CellTag::STR) | packAddr(addr));
 	}
 
 	static Cell makeREF(Address addr) {
-		Cell cell;
-		cell.tag = CellTag::REF;
-		cell.REF.addr = addr;
-		return cell;
+		return Cell(std::uint64_t(CellTag::REF) | packAddr(addr));
 	}
 
 	static Cell makeStructure(std::size_t arity, std::size_t name) {
-		Cell cell;
-		cell.tag = CellTag::Structure;
-		cell.Structure.arity = arity;
-		cell.Structure.name = name;
-		return cell;
+		assert(arity <= ArityMask);
+		assert(name <= std::numeric_limits<std::uint32_t>::max());
+		return Cell(std::uint64_t(CellTag::Structure) | (std::uint64_t(arity) << 2) | (std::uint64_t(name) << 32));
 	}
+private:
+
+	explicit Cell(std::uint64_t data) : data(data) { }
+
+	static std::uint64_t packAddr(Address addr) {
+		// the dummy pointers of copyFromTemp are truncated, they are overwritten before use
+		assert(addr.addr <= std::numeric_limits<std::uint32_t>::max() || addr.addr == std::size_t(-1));
+		return (std::uint64_t(addr.type) << 2) | (std::uint64_t(std::uint32_t(addr.addr)) << 32);
+	}
+private:
+	static constexpr std::uint64_t TagMask = 3;
+	static constexpr std::uint64_t ArityMask = (std::uint64_t(1) << 30) - 1;
+	std::uint64_t data = 0;
 };
 
+static_assert(sizeof(Cell) == 8, "A Cell should be packed into 64 bits.");
+
 struct Wam;
 
 struct MGU {
@@ -107,6 +134,12 @@ struct MGU {
 public:
 	std::size_t preHeapSize;
 	std::vector<Address> bindings; // stack of addresses of REFs that were self-references before
+	std::vector<std::pair<Address, Cell> > overwritten; // stack of temp cells overwritten during unification, with their old content
+
+	// a point in a sequence of unifications, which can be reverted back to, see Wam::revert
+	struct Mark {
+		std::size_t numBindings, numOverwritten, heapSize;
+	};
 
 	enum class Status {
 		Exists, Fail
@@ -114,6 +147,72 @@ public:
 	Address errorLeft, errorRight;
 };
 
+// The cells of a heap or temp, as a prefix which is shared between copies and never written to,
+// followed by a private segment which new cells are appended to.
+// Writes to cells of the shared prefix are kept in a private overlay, so the prefix is never copied.
+
+struct CellStore {
+	CellStore() = default;
+
+	explicit CellStore(std::vector<Cell> cells) : own(std::move(cells)) { }
+
+	std::size_t size() const {
+		return sharedSize + own.size();
+	}
+
+	const Cell &operator[](std::size_t i) const {
+		if(i >= sharedSize) return own[i - sharedSize];
+		if(!overwritten.empty()) {
+			const auto iter = overwritten.find(i);
+			if(iter != overwritten.end()) return iter->second;
+		}
+		return (*shared)[i];
+	}
+
+	Cell &getMutable(std::size_t i) {
+		if(i >= sharedSize) return own[i - sharedSize];
+		auto iter = overwritten.find(i);
+		if(iter == overwritten.end()) iter = overwritten.emplace(i, (*shared)[i]).first;
+		return iter->second;
+	}
+
+	void push_back(Cell cell) {
+		own.push_back(cell);
+	}
+
+	// requires: n <= size()
+	void shrink(std::size_t n) {
+		assert(n <= size());
+		if(n < sharedSize) {
+			// only happens when shrinking below a point before share() was called, so not in the hot paths
+			std::vector<Cell> cells(n);
+			for(std::size_t i = 0; i < n; ++i) cells[i] = (*this)[i];
+			*this = CellStore(std::move(cells));
+		} else {
+			own.resize(n - sharedSize);
+		}
+	}
+
+	// move all cells into the shared prefix, so copies made afterwards do not copy them
+	void share() {
+		if(own.empty() && overwritten.empty()) return;
+		std::vector<Cell> cells(size());
+		for(std::size_t i = 0; i < cells.size(); ++i) cells[i] = (*this)[i];
+		*this = CellStore();
+		sharedSize = cells.size();
+		shared = std::make_shared<const std::vector<Cell> >(std::move(cells));
+	}
+private:
+	std::shared_ptr<const std::vector<Cell> > shared;
+	std::size_t sharedSize = 0;
+	std::vector<Cell> own;
+	std::unordered_map<std::size_t, Cell> overwritten; // only indices in the shared prefix
+};
+
+// The heap and temp cells are stored in CellStores, so copies of a machine share the cells present when share() was called,
+// and only the cells written or appended afterwards are private to each copy.
+// The shared cells are never written, so copies can be made and used from any thread.
+
 struct Wam {
 	void verify() const;
 
@@ -135,44 +234,42 @@ struct Wam {
 	Address copyFromTemp(std::size_t addrTemp) {
 		const auto addr = deref({AddressType::Temp, addrTemp});
 		if(addr.type == AddressType::Heap) return addr;
-		Cell &cellTemp = getCell(addr);
-		if(cellTemp.tag == CellTag::REF) {
+		Cell &cellTemp = getCellMutable(addr);
+		if(cellTemp.getTag() == CellTag::REF) {
 			// put a new variable on the heap, and bind the temp variable to it
 			const auto addrHeap = putRefPtr();
-			cellTemp.REF.addr = addrHeap;
+			cellTemp.setAddr(addrHeap);
 			return addrHeap;
 		}
 		// Copy the structure recursively
-		assert(cellTemp.tag == CellTag::Structure);
+		assert(cellTemp.getTag() == CellTag::Structure);
 		// first copy the header and overwrite it in temp
-		const auto arity = cellTemp.Structure.arity;
-		const auto addrHeap = putStructure(cellTemp.Structure.name, arity);
-		cellTemp.tag = CellTag::STR;
-		cellTemp.STR.addr = addrHeap;
+		const auto arity = cellTemp.getArity();
+		const auto addrHeap = putStructure(cellTemp.getName(), arity);
+		cellTemp = Cell::makeSTR(addrHeap);
 		// now make space for each argument, and copy singleton cells
 		std::vector<bool> doCopy(arity, false);
 		for(int i = 1; i <= arity; ++i) {
 			const auto addrArg = deref(addr + i);
-			auto &argCell = getCell(addrArg);
-			assert(argCell.tag != CellTag::STR);
-			if(argCell.tag == CellTag::REF) {
+			auto &argCell = getCellMutable(addrArg);
+			assert(argCell.getTag() != CellTag::STR);
+			if(argCell.getTag() == CellTag::REF) {
 				const auto heapAddrArg = putRefPtr();
-				argCell.REF.addr = heapAddrArg;
+				argCell.setAddr(heapAddrArg);
 				if(addrArg.type == AddressType::Heap) {
 					// bind the new to the old
-					getCell(heapAddrArg).REF.addr = addrArg;
+					getCellMutable(heapAddrArg).setAddr(addrArg);
 				} else {
 					// bind the temp to the heap
-					argCell.REF.addr = heapAddrArg;
+					argCell.setAddr(heapAddrArg);
 				}
 			} else {
-				assert(argCell.tag == CellTag::Structure);
-				const auto arity = argCell.Structure.arity;
+				assert(argCell.getTag() == CellTag::Structure);
+				const auto arity = argCell.getArity();
 				if(arity == 0) {
 					// just copy it inline
-					const auto addrNew = putStructure(argCell.Structure.name, arity);
-					argCell.tag = CellTag::STR;
-					argCell.STR.addr = addrNew;
+					const auto addrNew = putStructure(argCell.getName(), arity);
+					argCell = Cell::makeSTR(addrNew);
 				} else {
 					// put a dummy to reserve the space
 					putStructurePtr(-1);
@@ -184,17 +281,14 @@ struct Wam {
 		for(int i = 1; i <= arity; ++i) {
 			if(!doCopy[i - 1]) continue;
 			const auto argAddr = deref(addr + i);
-			auto &argCell = getCell(argAddr);
-			assert(argCell.tag == CellTag::Structure);
+			assert(getCell(argAddr).getTag() == CellTag::Structure);
 			const auto targetAddr = addrHeap + i;
-			auto &targetCell = getCell(targetAddr);
-			targetCell.tag = CellTag::STR;
 			if(argAddr.type == AddressType::Temp) {
-				// the targetCell reference may now dangle
+				// the target cell reference may dangle after the copy, so look it up again
 				const auto argCopyAddr = copyFromTemp(argAddr.addr);
-				getCell(targetAddr).STR.addr = argCopyAddr;
+				setCell(targetAddr, Cell::makeSTR(argCopyAddr));
 			} else {
-				targetCell.STR.addr = argAddr;
+				setCell(targetAddr, Cell::makeSTR(argAddr));
 			}
 		}
 		return addrHeap;
@@ -218,15 +312,16 @@ struct Wam {
 
 	Address deref(Address addr) const {
 		Cell cell = getCell(addr);
-		switch(cell.tag) {
-		case CellTag::STR: return deref(cell.STR.addr);
-		case CellTag::REF: return cell.REF.addr == addr ? addr: deref(cell.REF.addr);
+		switch(cell.getTag()) {
+		case CellTag::STR: return deref(cell.getAddr());
+		case CellTag::REF: return cell.getAddr() == addr ? addr: deref(cell.getAddr());
 		case CellTag::Structure: return addr;
 		}
 		MOD_ABORT;
 	}
 
-	Cell &getCell(Address addr) {
+	// reading never copies shared cells, so there is only a const accessor
+	const Cell &getCell(Address addr) const {
 		switch(addr.type) {
 		case AddressType::Heap: return heap[addr.addr];
 		case AddressType::Temp: return temp[addr.addr];
@@ -234,37 +329,33 @@ struct Wam {
 		MOD_ABORT;
 	}
 
-	const Cell &getCell(Address addr) const {
-		switch(addr.type) {
-		case AddressType::Heap: return heap[addr.addr];
-		case AddressType::Temp: return temp[addr.addr];
-		}
-		MOD_ABORT;
+	void setCell(Address addr, Cell cell) {
+		getCellMutable(addr) = cell;
 	}
 
-	const std::vector<Cell> &getHeap() const {
+	const CellStore &getHeap() const {
 		return heap;
 	}
 
-	const std::vector<Cell> &getTemp() const {
+	const CellStore &getTemp() const {
 		return temp;
 	}
 
 	void setTemp(const Wam &other) {
-		temp = other.heap;
-		for(Cell &cell : temp) {
-			switch(cell.tag) {
+		std::vector<Cell> newTemp(other.heap.size());
+		for(std::size_t i = 0; i < newTemp.size(); ++i) {
+			Cell cell = other.heap[i];
+			switch(cell.getTag()) {
 			case CellTag::REF:
-				assert(cell.REF.addr.type == AddressType::Heap);
-				cell.REF.addr.type = AddressType::Temp;
-				break;
 			case CellTag::STR:
-				assert(cell.STR.addr.type == AddressType::Heap);
-				cell.STR.addr.type = AddressType::Temp;
+				assert(cell.getAddr().type == AddressType::Heap);
+				cell.setAddr(Address{AddressType::Temp, cell.getAddr().addr});
 				break;
 			case CellTag::Structure: break;
 			}
+			newTemp[i] = cell;
 		}
+		temp = CellStore(std::move(newTemp));
 	}
 
 	void swapHeapTemp() {
@@ -272,19 +363,58 @@ struct Wam {
 		swap(heap, temp);
 	}
 
+	// makes the current cells shared by the copies of this machine made afterwards,
+	// call it when the machine is complete, before it is copied for unification
+	void share() {
+		heap.share();
+		temp.share();
+	}
+
+	MGU::Mark getMark(const MGU &mgu) const {
+		return MGU::Mark{mgu.bindings.size(), mgu.overwritten.size(), heap.size()};
+	}
+
+	// undo the unifications recorded in mgu after the mark was taken, including a failed one
+	void revert(MGU &mgu, const MGU::Mark &mark) {
+		for(auto i = mgu.overwritten.size(); i > mark.numOverwritten; --i) {
+			const auto &p = mgu.overwritten[i - 1];
+			setCell(p.first, p.second);
+		}
+		mgu.overwritten.resize(mark.numOverwritten);
+		for(auto i = mgu.bindings.size(); i > mark.numBindings; --i) {
+			const Address a = mgu.bindings[i - 1];
+			Cell &c = getCellMutable(a);
+			assert(c.getTag() == CellTag::REF);
+			c.setAddr(a);
+		}
+		mgu.bindings.resize(mark.numBindings);
+		assert(heap.size() >= mark.heapSize);
+		if(heap.size() != mark.heapSize) heap.shrink(mark.heapSize);
+		mgu.status = MGU::Status::Exists;
+	}
+
 	void revert(const MGU &mgu) {
 		for(const Address &a : mgu.bindings) {
-			Cell &c = getCell(a);
-			assert(c.tag == CellTag::REF);
-			assert(c.REF.addr != a);
-			c.REF.addr = a;
+			Cell &c = getCellMutable(a);
+			assert(c.getTag() == CellTag::REF);
+			assert(c.getAddr() != a);
+			c.setAddr(a);
 		}
 		assert(heap.size() >= mgu.preHeapSize);
-		heap.resize(mgu.preHeapSize);
+		if(heap.size() != mgu.preHeapSize) heap.shrink(mgu.preHeapSize);
 	}
 private:
-	std::vector<Cell> heap;
-	std::vector<Cell> temp;
+
+	// only for writing, as writes to shared cells go to the overlay
+	Cell &getCellMutable(Address addr) {
+		switch(addr.type) {
+		case AddressType::Heap: return heap.getMutable(addr.addr);
+		case AddressType::Temp: return temp.getMutable(addr.addr);
+		}
+		MOD_ABORT;
+	}
+private:
+	CellStore heap, temp;
 };
 
 //------------------------------------------------------------------------------
@@ -303,7 +433,7 @@ inline bool MGU::isRenaming(const Wam &machine) const {
 		addr = machine.deref(addr);
 		assert(addr.type == AddressType::Heap);
 		Cell target = machine.getCell(addr);
-		if(target.tag != CellTag::REF) return false;
+		if(target.getTag() != CellTag::REF) return false;
 		if(isTarget[addr.addr]) return false;
 		isTarget[addr.addr] = true;
 	}
@@ -336,37 +466,37 @@ inline void Wam::unifyHeapHeap(std::size_t lhs, std::size_t rhs, MGU &mgu) {
 		stack.pop();
 		if(lhs == rhs) continue;
 		Cell leftCell = heap[lhs], rightCell = heap[rhs];
-		assert(leftCell.tag != CellTag::STR);
-		assert(rightCell.tag != CellTag::STR);
-		if(leftCell.tag != CellTag::REF && rightCell.tag == CellTag::REF) {
+		assert(leftCell.getTag() != CellTag::STR);
+		assert(rightCell.getTag() != CellTag::STR);
+		if(leftCell.getTag() != CellTag::REF && rightCell.getTag() == CellTag::REF) {
 			std::swap(lhs, rhs);
 			std::swap(leftCell, rightCell);
 		}
 
-		if(leftCell.tag == CellTag::REF) {
+		if(leftCell.getTag() == CellTag::REF) {
 			// bind
-			if(rightCell.tag == CellTag::REF && rightCell.REF.addr < leftCell.REF.addr) {
+			if(rightCell.getTag() == CellTag::REF && rightCell.getAddr() < leftCell.getAddr()) {
 				// right = left
-				assert(heap[rhs].REF.addr.type == AddressType::Heap);
-				heap[rhs].REF.addr.addr = lhs;
+				assert(heap[rhs].getAddr().type == AddressType::Heap);
+				heap.getMutable(rhs).setAddr(Address{AddressType::Heap, lhs});
 				mgu.bindings.push_back(Address{AddressType::Heap, rhs});
 			} else {
 				// left = right
-				assert(heap[lhs].REF.addr.type == AddressType::Heap);
-				heap[lhs].REF.addr.addr = rhs;
+				assert(heap[lhs].getAddr().type == AddressType::Heap);
+				heap.getMutable(lhs).setAddr(Address{AddressType::Heap, rhs});
 				mgu.bindings.push_back(Address{AddressType::Heap, lhs});
 			}
 		} else {
-			assert(leftCell.tag == CellTag::Structure);
-			assert(rightCell.tag == CellTag::Structure);
-			if(leftCell.Structure.name != rightCell.Structure.name
-					|| leftCell.Structure.arity != rightCell.Structure.arity) {
+			assert(leftCell.getTag() == CellTag::Structure);
+			assert(rightCell.getTag() == CellTag::Structure);
+			if(leftCell.getName() != rightCell.getName()
+					|| leftCell.getArity() != rightCell.getArity()) {
 				mgu.status = MGU::Status::Fail;
 				mgu.errorLeft = Address{AddressType::Heap, lhs};
 				mgu.errorRight = Address{AddressType::Heap, rhs};
 				return;
 			}
-			for(std::size_t i = leftCell.Structure.arity; i > 0; i--)
+			for(std::size_t i = leftCell.getArity(); i > 0; i--)
 				stack.emplace(lhs + i, rhs + i);
 		}
 	}
@@ -374,13 +504,12 @@ inline void Wam::unifyHeapHeap(std::size_t lhs, std::size_t rhs, MGU &mgu) {
 
 inline void Wam::verify() const {
 	// nothing in the heap should point at temp
-	for(Cell cell : heap) {
-		switch(cell.tag) {
+	for(std::size_t i = 0; i < heap.size(); ++i) {
+		const Cell cell = heap[i];
+		switch(cell.getTag()) {
 		case CellTag::REF:
-			if(cell.REF.addr.type != AddressType::Heap) MOD_ABORT;
-			break;
 		case CellTag::STR:
-			if(cell.STR.addr.type != AddressType::Heap) MOD_ABORT;
+			if(cell.getAddr().type != AddressType::Heap) MOD_ABORT;
 			break;
 		case CellTag::Structure:
 			break;
@@ -406,47 +535,47 @@ inline void Wam::unifyHeapTemp(std::size_t lhsIndex, std::size_t rhsIndex, MGU &
 			unifyHeapHeap(lhsAddr.addr, rhsAddr.addr, mgu);
 		} else {
 			Cell rhsCell = getCell(rhsAddr);
-			if(rhsCell.tag == CellTag::REF) {
-				assert(rhsCell.REF.addr == rhsAddr);
-				getCell(rhsAddr).REF.addr = lhsAddr;
+			if(rhsCell.getTag() == CellTag::REF) {
+				assert(rhsCell.getAddr() == rhsAddr);
+				getCellMutable(rhsAddr).setAddr(lhsAddr);
 				mgu.bindings.push_back(rhsAddr);
-			} else if(rhsCell.tag == CellTag::Structure) {
+			} else if(rhsCell.getTag() == CellTag::Structure) {
 				Cell lhsCell = getCell(lhsAddr);
-				if(lhsCell.tag == CellTag::REF) {
-					assert(lhsCell.REF.addr == lhsAddr);
+				if(lhsCell.getTag() == CellTag::REF) {
+					assert(lhsCell.getAddr() == lhsAddr);
 					// copy the structure to the heap, and bind lhs to it
-					Address rhsAddrNew = putStructure(rhsCell.Structure.name, rhsCell.Structure.arity);
-					getCell(lhsAddr).REF.addr = rhsAddrNew;
+					Address rhsAddrNew = putStructure(rhsCell.getName(), rhsCell.getArity());
+					getCellMutable(lhsAddr).setAddr(rhsAddrNew);
 					mgu.bindings.push_back(lhsAddr);
 					// overwrite rhs
-					getCell(rhsAddr).tag = CellTag::STR;
-					getCell(rhsAddr).STR.addr = rhsAddrNew;
+					mgu.overwritten.emplace_back(rhsAddr, rhsCell);
+					setCell(rhsAddr, Cell::makeSTR(rhsAddrNew));
 					// copy arguments
-					for(std::size_t i = 1; i <= rhsCell.Structure.arity; i++) {
+					for(std::size_t i = 1; i <= rhsCell.getArity(); i++) {
 						Address rhsSubAddr = rhsAddr + i;
 						Cell rhsSubCell = getCell(rhsSubAddr);
-						switch(rhsSubCell.tag) {
+						switch(rhsSubCell.getTag()) {
 						case CellTag::REF:
 						case CellTag::STR:
 							// create a variable and schedule unification
 							stack.emplace(putRefPtr(), rhsSubAddr);
 							break;
 						case CellTag::Structure:
-							assert(rhsSubCell.Structure.arity == 0);
+							assert(rhsSubCell.getArity() == 0);
 							// overwrite rhs and append structure
-							getCell(rhsSubAddr).tag = CellTag::STR;
-							getCell(rhsSubAddr).STR.addr = putStructure(rhsSubCell.Structure.name, rhsSubCell.Structure.arity);
+							mgu.overwritten.emplace_back(rhsSubAddr, rhsSubCell);
+							setCell(rhsSubAddr, Cell::makeSTR(putStructure(rhsSubCell.getName(), rhsSubCell.getArity())));
 							break;
 						}
 					}
-				} else if(lhsCell.tag == CellTag::Structure) {
-					if(lhsCell.Structure.name == rhsCell.Structure.name &&
-							lhsCell.Structure.arity == rhsCell.Structure.arity) {
-						for(std::size_t i = lhsCell.Structure.arity; i > 0; i--)
+				} else if(lhsCell.getTag() == CellTag::Structure) {
+					if(lhsCell.getName() == rhsCell.getName() &&
+							lhsCell.getArity() == rhsCell.getArity()) {
+						for(std::size_t i = lhsCell.getArity(); i > 0; i--)
 							stack.emplace(lhsAddr + i, rhsAddr + i);
 						// overwrite rhs to point to heap
-						getCell(rhsAddr).tag = CellTag::STR;
-						getCell(rhsAddr).STR.addr = lhsAddr;
+						mgu.overwritten.emplace_back(rhsAddr, rhsCell);
+						setCell(rhsAddr, Cell::makeSTR(lhsAddr));
 					} else {
 						mgu.status = MGU::Status::Fail;
 						mgu.errorLeft = lhsAddr;
@@ -0,0 +1,83 @@
+#include "BoundRules.h"
+
+#include <mod/Config.h>
+#include <mod/dg/DG.h>
+#include <mod/dg/Strategies.h>
+#include <mod/graph/Graph.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/test/Util.h>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+
+// the verbose log of the calculation, which includes the number of intermediaries in each binding round
+std::string calcWithLog(std::shared_ptr<dg::DG> dg, unsigned int numThreads) {
+	auto &config = getConfig();
+	const auto oldVerbose = config.dg.calculateVerbose.get();
+	const auto oldNumThreads = config.common.numThreads.get();
+	config.dg.calculateVerbose.set(true);
+	config.common.numThreads.set(numThreads);
+	std::stringstream log;
+	auto *oldBuf = std::cout.rdbuf(log.rdbuf());
+	try {
+		dg->calc();
+	} catch(...) {
+		std::cout.rdbuf(oldBuf);
+		throw;
+	}
+	std::cout.rdbuf(oldBuf);
+	config.dg.calculateVerbose.set(oldVerbose);
+	config.common.numThreads.set(oldNumThreads);
+	return log.str();
+}
+
+} // namespace
+
+void boundRules() {
+	// three symmetric components, so binding the same graphs in any order gives isomorphic intermediaries
+	const auto rTriangle = rule::Rule::ruleGMLString(R"(rule [
+	ruleID "triangle"
+	context [
+		node [ id 0 label "C" ]
+		node [ id 1 label "C" ]
+		node [ id 2 label "C" ]
+	]
+	right [
+		edge [ source 0 target 1 label "-" ]
+		edge [ source 1 target 2 label "-" ]
+		edge [ source 2 target 0 label "-" ]
+	]
+])", false);
+	// each with a single C, so each binds exactly one component
+	const std::vector<std::shared_ptr<graph::Graph> > graphs{
+		graph::Graph::graphDFS("[C]"),
+		graph::Graph::graphDFS("[C][O]")
+	};
+	const auto labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	const auto strategy = dg::Strategy::makeSequence({
+		dg::Strategy::makeAdd(false, graphs),
+		dg::Strategy::makeRule(rTriangle)
+	});
+	for(const unsigned int numThreads : {1u, 2u}) {
+		const auto dg = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+		const auto log = calcWithLog(dg, numThreads);
+		// the first round binds each graph once
+		MOD_TEST_CHECK(log.find("Binding component 2 with 2 intermediaries") != std::string::npos);
+		// the second round binds both graphs to both intermediaries,
+		// but the two orders of binding one of each give the same intermediary, so it is only stored once
+		MOD_TEST_CHECK(log.find("Binding component 3 with 3 intermediaries") != std::string::npos);
+		// one derivation for each multiset of three graphs
+		MOD_TEST_CHECK(dg->numEdges() == 4);
+	}
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
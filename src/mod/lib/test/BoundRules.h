@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_BOUNDRULES_H
+#define MOD_LIB_TEST_BOUNDRULES_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// The deduplication of the intermediary bound rules in each binding round of a rule strategy.
+void boundRules();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_BOUNDRULES_H */
@@ -0,0 +1,71 @@
+#include "DGCheckpoint.h"
+
+#include <mod/Config.h>
+#include <mod/dg/DG.h>
+#include <mod/dg/Strategies.h>
+#include <mod/graph/Graph.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/DG/Dump.h>
+#include <mod/lib/Graph/Single.h>
+#include <mod/lib/IO/DG.h>
+#include <mod/lib/IO/IO.h>
+#include <mod/lib/test/Util.h>
+
+#include <sstream>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+
+void dgCheckpoint() {
+	const auto gC = graph::Graph::graphDFS("[C]");
+	const auto r = makeBondRule();
+	const std::vector<std::shared_ptr<graph::Graph> > graphs{gC};
+	const auto labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	// the nested Repeat must not take an id, and must not change the id of the following Repeat
+	const auto strategy = dg::Strategy::makeSequence({
+		dg::Strategy::makeAdd(false, graphs),
+		dg::Strategy::makeRepeat(1, dg::Strategy::makeRepeat(1, dg::Strategy::makeRule(r))),
+		dg::Strategy::makeRepeat(3, dg::Strategy::makeRule(r))
+	});
+	const auto dgFull = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+	dgFull->calc();
+
+	auto &config = getConfig().dg;
+	const auto file = lib::IO::getUniqueFilePrefix() + "DGCheckpoint.dgc";
+	const auto oldCheckpointFile = config.checkpointFile.get();
+	const auto oldCheckpointIntervalSeconds = config.checkpointIntervalSeconds.get();
+	const auto oldProductLimit = config.productLimit.get();
+	// CC is found in the first Repeat, and CCC and CCCC in the first iteration of the second,
+	// so the limit is reached during its second iteration
+	config.checkpointFile.set(file);
+	config.checkpointIntervalSeconds.set(0);
+	config.productLimit.set(4);
+	const auto dgStopped = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+	dgStopped->calc();
+	config.productLimit.set(oldProductLimit);
+	config.checkpointIntervalSeconds.set(oldCheckpointIntervalSeconds);
+	config.checkpointFile.set(oldCheckpointFile);
+	MOD_TEST_CHECK(dgStopped->getProducts().size() < dgFull->getProducts().size());
+
+	{ // the first Repeat is finished, and the second has one completed iteration
+		std::ostringstream err;
+		const auto checkpoint = lib::IO::DG::Read::checkpoint(file, err);
+		MOD_TEST_CHECK(checkpoint);
+		const auto &repeats = checkpoint->repeats;
+		MOD_TEST_CHECK(repeats.size() == 2);
+		MOD_TEST_CHECK(repeats[0].repeatId == 0 && repeats[0].finished);
+		MOD_TEST_CHECK(repeats[1].repeatId == 1 && !repeats[1].finished);
+		MOD_TEST_CHECK(repeats[1].numIterations == 1);
+	}
+
+	const auto dgResumed = dg::DG::ruleCompResume(graphs, strategy, labelSettings, false, file);
+	dgResumed->calc();
+	checkSameDG(dgFull, dgResumed, labelSettings);
+	MOD_TEST_CHECK(dgResumed->getProducts().size() == dgFull->getProducts().size());
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_DGCHECKPOINT_H
+#define MOD_LIB_TEST_DGCHECKPOINT_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// Stopping a rule composition DG during a Repeat strategy, and resuming it from the checkpoint.
+void dgCheckpoint();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_DGCHECKPOINT_H */
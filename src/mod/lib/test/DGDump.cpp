@@ -0,0 +1,148 @@
+#include "DGDump.h"
+
+#include <mod/Config.h>
+#include <mod/Misc.h>
+#include <mod/dg/DG.h>
+#include <mod/dg/GraphInterface.h>
+#include <mod/dg/Strategies.h>
+#include <mod/graph/Graph.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/DG/Dump.h>
+#include <mod/lib/DG/NonHyper.h>
+#include <mod/lib/Graph/Single.h>
+#include <mod/lib/test/Util.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+
+std::vector<char> readFile(const std::string &file) {
+	std::ifstream s(prefixFilename(file), std::ios::binary);
+	MOD_TEST_CHECK(s.is_open());
+	return std::vector<char>{std::istreambuf_iterator<char>(s), std::istreambuf_iterator<char>()};
+}
+
+// true iff the data is rejected with an error message
+bool isRejected(const std::vector<std::shared_ptr<graph::Graph> > &graphs, const std::vector<std::shared_ptr<rule::Rule> > &rules,
+		const std::vector<char> &data, std::size_t size) {
+	std::ostringstream err;
+	std::unique_ptr<lib::DG::NonHyper> dg(lib::DG::Dump::loadBinary(graphs, rules, data.data(), size, err, false));
+	return !dg && !err.str().empty();
+}
+
+template<typename T>
+void overwrite(std::vector<char> &data, std::size_t offset, T value) {
+	std::memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+} // namespace
+
+void dgDump() {
+	const auto gC = graph::Graph::graphDFS("[C]");
+	const auto r = makeBondRule();
+	const std::vector<std::shared_ptr<graph::Graph> > graphs{gC};
+	const std::vector<std::shared_ptr<rule::Rule> > rules{r};
+	const auto labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	const auto strategy = dg::Strategy::makeSequence({
+		dg::Strategy::makeAdd(false, graphs),
+		dg::Strategy::makeRepeat(2, dg::Strategy::makeRule(r))
+	});
+	const auto dg = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+	dg->calc();
+	MOD_TEST_CHECK(dg->numEdges() > 1);
+	const auto file = dg->dumpBinary();
+
+	{ // trusted round trip, the given graph must be reused
+		const auto dgLoaded = dg::DG::dumpImport(graphs, rules, file);
+		checkSameDG(dg, dgLoaded, labelSettings);
+		MOD_TEST_CHECK(!dgLoaded->findVertex(gC).isNull());
+	}
+	{ // validated round trip
+		auto &validate = getConfig().dg.validateBinaryDump;
+		const bool old = validate.get();
+		validate.set(true);
+		const auto dgLoaded = dg::DG::dumpImport(graphs, rules, file);
+		validate.set(old);
+		checkSameDG(dg, dgLoaded, labelSettings);
+		MOD_TEST_CHECK(!dgLoaded->findVertex(gC).isNull());
+	}
+
+	const auto data = readFile(file);
+	{ // the complete data must load, and every truncation of it must be rejected
+		std::ostringstream err;
+		std::unique_ptr<lib::DG::NonHyper> dgLoaded(lib::DG::Dump::loadBinary(graphs, rules, data.data(), data.size(), err, false));
+		MOD_TEST_CHECK(dgLoaded);
+		for(std::size_t size = 0; size < data.size(); size++)
+			MOD_TEST_CHECK(isRejected(graphs, rules, data, size));
+	}
+	// the header is the magic, 8 u32 fields, and then the u64 counts of strings, graphs, rules, and edges
+	const std::size_t offsetNumStrings = 8 + 8 * sizeof(std::uint32_t);
+	const std::size_t offsetNumGraphs = offsetNumStrings + sizeof(std::uint64_t);
+	const std::size_t offsetNumRules = offsetNumGraphs + sizeof(std::uint64_t);
+	{ // wrong magic
+		auto corrupt = data;
+		corrupt[0] = 'X';
+		MOD_TEST_CHECK(isRejected(graphs, rules, corrupt, corrupt.size()));
+	}
+	{ // unsupported version
+		auto corrupt = data;
+		overwrite(corrupt, 8, std::numeric_limits<std::uint32_t>::max());
+		MOD_TEST_CHECK(isRejected(graphs, rules, corrupt, corrupt.size()));
+	}
+	{ // counts which can not be allocated, or which do not fit the data
+		for(const auto offset : {offsetNumStrings, offsetNumGraphs, offsetNumRules}) {
+			for(const std::uint64_t value : {std::numeric_limits<std::uint64_t>::max(), std::uint64_t(1) << 40}) {
+				auto corrupt = data;
+				overwrite(corrupt, offset, value);
+				MOD_TEST_CHECK(isRejected(graphs, rules, corrupt, corrupt.size()));
+			}
+		}
+	}
+	{ // the rule is not given
+		MOD_TEST_CHECK(isRejected(graphs, {}, data, data.size()));
+	}
+	{ // the stored hashes may come from another build, so they must not be used for linking the given graphs
+		auto corrupt = data;
+		const auto read = [&](std::size_t offset, auto value) {
+			std::memcpy(&value, corrupt.data() + offset, sizeof(value));
+			return value;
+		};
+		const auto align = [](std::size_t offset) {
+			return (offset + 7) / 8 * 8;
+		};
+		const auto numStrings = read(offsetNumStrings, std::uint64_t());
+		const auto numGraphs = read(offsetNumGraphs, std::uint64_t());
+		const std::size_t offsetStrings = offsetNumRules + 2 * sizeof(std::uint64_t);
+		const auto stringDataSize = read(offsetStrings + numStrings * sizeof(std::uint64_t), std::uint64_t());
+		std::size_t offset = align(offsetStrings + (numStrings + 1) * sizeof(std::uint64_t) + stringDataSize);
+		for(std::size_t i = 0; i < numGraphs; i++) {
+			const std::size_t offsetHash = offset + sizeof(std::uint64_t);
+			overwrite(corrupt, offsetHash, ~read(offsetHash, std::uint64_t()));
+			const std::size_t offsetCounts = offsetHash + sizeof(std::uint64_t) + 2 * sizeof(std::uint32_t);
+			const auto numVertices = read(offsetCounts, std::uint32_t());
+			const auto numEdges = read(offsetCounts + sizeof(std::uint32_t), std::uint32_t());
+			offset = align(offsetCounts + 2 * sizeof(std::uint32_t) + (numVertices + 3 * std::size_t(numEdges)) * sizeof(std::uint32_t));
+		}
+		const auto corruptFile = file + ".hashes";
+		{
+			std::ofstream s(prefixFilename(corruptFile), std::ios::binary);
+			s.write(corrupt.data(), corrupt.size());
+		}
+		const auto dgLoaded = dg::DG::dumpImport(graphs, rules, corruptFile);
+		checkSameDG(dg, dgLoaded, labelSettings);
+		MOD_TEST_CHECK(!dgLoaded->findVertex(gC).isNull());
+	}
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
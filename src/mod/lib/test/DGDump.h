@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_DGDUMP_H
+#define MOD_LIB_TEST_DGDUMP_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// Round trips of the binary DG dump, and loading of truncated and corrupted dumps.
+void dgDump();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_DGDUMP_H */
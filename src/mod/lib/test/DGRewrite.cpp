@@ -0,0 +1,88 @@
+#include "DGRewrite.h"
+
+#include <mod/Config.h>
+#include <mod/dg/DG.h>
+#include <mod/dg/Strategies.h>
+#include <mod/graph/Graph.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/test/Util.h>
+
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+
+void dgRewrite() {
+	const std::vector<std::shared_ptr<graph::Graph> > graphs{
+		graph::Graph::graphDFS("[C]"),
+		graph::Graph::graphDFS("[O]")
+	};
+	// two left components, so the bindings go through intermediary rules
+	const auto rOxidise = rule::Rule::ruleGMLString(R"(rule [
+	ruleID "oxidise"
+	context [
+		node [ id 0 label "C" ]
+		node [ id 1 label "O" ]
+	]
+	right [
+		edge [ source 0 target 1 label "=" ]
+	]
+])", false);
+	// deletes an edge and relabels its end points
+	const auto rBreak = rule::Rule::ruleGMLString(R"(rule [
+	ruleID "break"
+	left [
+		node [ id 0 label "C" ]
+		edge [ source 0 target 1 label "-" ]
+	]
+	context [
+		node [ id 1 label "C" ]
+	]
+	right [
+		node [ id 0 label "C+" ]
+	]
+])", false);
+	// deletes a vertex, which fails when it has other edges
+	const auto rReduce = rule::Rule::ruleGMLString(R"(rule [
+	ruleID "reduce"
+	left [
+		node [ id 1 label "O" ]
+		edge [ source 0 target 1 label "=" ]
+	]
+	context [
+		node [ id 0 label "C" ]
+	]
+	right [
+		node [ id 2 label "H" ]
+		edge [ source 0 target 2 label "-" ]
+	]
+])", false);
+	const auto labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	const auto strategy = dg::Strategy::makeSequence({
+		dg::Strategy::makeAdd(false, graphs),
+		dg::Strategy::makeRepeat(3, dg::Strategy::makeParallel({
+			dg::Strategy::makeRule(makeBondRule()),
+			dg::Strategy::makeRule(rOxidise),
+			dg::Strategy::makeRule(rBreak),
+			dg::Strategy::makeRule(rReduce)
+		}))
+	});
+
+	auto &config = getConfig().dg;
+	const auto oldRewriteDirectly = config.rewriteDirectly.get();
+	config.rewriteDirectly.set(true);
+	const auto dgDirect = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+	dgDirect->calc();
+	config.rewriteDirectly.set(false);
+	const auto dgComposed = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+	dgComposed->calc();
+	config.rewriteDirectly.set(oldRewriteDirectly);
+	MOD_TEST_CHECK(dgDirect->numEdges() > 0);
+	// the products must be created in the same order as through the composed rules
+	checkSameDGStrict(dgDirect, dgComposed, labelSettings);
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
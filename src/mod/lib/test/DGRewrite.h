@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_DGREWRITE_H
+#define MOD_LIB_TEST_DGREWRITE_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// Rewriting complete matches directly, compared to composing the bind rules with the rules.
+void dgRewrite();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_DGREWRITE_H */
@@ -0,0 +1,86 @@
+#include "DGThreads.h"
+
+#include <mod/Config.h>
+#include <mod/dg/DG.h>
+#include <mod/dg/Strategies.h>
+#include <mod/graph/Graph.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/test/Util.h>
+
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+
+std::shared_ptr<dg::DG> calcWithThreads(const std::vector<std::shared_ptr<graph::Graph> > &graphs,
+		std::shared_ptr<dg::Strategy> strategy, LabelSettings labelSettings, unsigned int numThreads) {
+	auto &config = getConfig().common;
+	const auto oldNumThreads = config.numThreads.get();
+	config.numThreads.set(numThreads);
+	const auto dg = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+	dg->calc();
+	config.numThreads.set(oldNumThreads);
+	return dg;
+}
+
+} // namespace
+
+void dgThreads() {
+	const std::vector<std::shared_ptr<graph::Graph> > graphs{
+		graph::Graph::graphDFS("[C]"),
+		graph::Graph::graphDFS("[C][C]")
+	};
+	const auto labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	// the bond rule has two left components, so each graph is bound to intermediary rules as well
+	const auto strategy = dg::Strategy::makeSequence({
+		dg::Strategy::makeAdd(false, graphs),
+		dg::Strategy::makeRepeat(3, dg::Strategy::makeRule(makeBondRule()))
+	});
+	const auto dgSingle = calcWithThreads(graphs, strategy, labelSettings, 1);
+	const auto dgMulti = calcWithThreads(graphs, strategy, labelSettings, 4);
+	MOD_TEST_CHECK(dgSingle->numEdges() > 0);
+	checkSameDGStrict(dgSingle, dgMulti, labelSettings);
+
+	// more rule branches than threads, so the branches are staged in several groups,
+	// and some branches find the same products and derivations as earlier ones
+	const auto rBreak = rule::Rule::ruleGMLString(R"(rule [
+	ruleID "break"
+	left [
+		edge [ source 0 target 1 label "-" ]
+	]
+	context [
+		node [ id 0 label "C" ]
+		node [ id 1 label "C" ]
+	]
+])", false);
+	const auto rMethyl = rule::Rule::ruleGMLString(R"(rule [
+	ruleID "methyl"
+	context [
+		node [ id 0 label "C" ]
+	]
+	right [
+		node [ id 1 label "C" ]
+		edge [ source 0 target 1 label "-" ]
+	]
+])", false);
+	const auto strategyParallel = dg::Strategy::makeSequence({
+		dg::Strategy::makeAdd(false, graphs),
+		dg::Strategy::makeRepeat(2, dg::Strategy::makeParallel({
+			dg::Strategy::makeRule(makeBondRule()),
+			dg::Strategy::makeRule(rBreak),
+			dg::Strategy::makeRule(rMethyl),
+			dg::Strategy::makeRule(makeBondRule()),
+			dg::Strategy::makeRule(rMethyl)
+		}))
+	});
+	const auto dgParallelSingle = calcWithThreads(graphs, strategyParallel, labelSettings, 1);
+	const auto dgParallelMulti = calcWithThreads(graphs, strategyParallel, labelSettings, 2);
+	MOD_TEST_CHECK(dgParallelSingle->numEdges() > 0);
+	checkSameDGStrict(dgParallelSingle, dgParallelMulti, labelSettings);
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
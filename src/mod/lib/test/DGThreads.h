@@ -0,0 +1,16 @@
+#ifndef MOD_LIB_TEST_DGTHREADS_H
+#define MOD_LIB_TEST_DGTHREADS_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// Rule composition DGs calculated with several threads, compared to calculating them with a single thread,
+// both for the rule strategy on its own and for parallel strategies with rule branches.
+void dgThreads();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_DGTHREADS_H */
@@ -0,0 +1,54 @@
+#include "GraphCanon.h"
+
+#include <mod/Config.h>
+#include <mod/graph/Graph.h>
+#include <mod/lib/Graph/Single.h>
+#include <mod/lib/test/Util.h>
+
+#include <string>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+
+void graphCanon() {
+	// the first two are the same stereoisomer, as swapping two neighbours inverts the chirality symbol
+	const std::vector<std::shared_ptr<graph::Graph> > graphs{
+		graph::Graph::smiles("C[C@H](N)O"),
+		graph::Graph::smiles("C[C@@H](O)N"),
+		graph::Graph::smiles("C[C@@H](N)O"),
+		graph::Graph::smiles("OCC(=O)N"),
+		graph::Graph::smiles("NC(=O)CO"),
+		graph::Graph::smiles("NCC(=O)O")
+	};
+	const auto check = [&graphs](LabelType labelType, bool withStereo) {
+		const auto labelSettings = LabelSettings(labelType, LabelRelation::Isomorphism, withStereo, LabelRelation::Isomorphism);
+		for(const auto &gA : graphs) {
+			for(const auto &gB : graphs) {
+				const auto &a = gA->getGraph();
+				const auto &b = gB->getGraph();
+				const bool iso = 1 == lib::Graph::Single::isomorphismVF2(a, b, 1, labelSettings);
+				MOD_TEST_CHECK(iso == lib::Graph::Single::canonicalCompare(a, b, labelType, withStereo));
+				if(iso) MOD_TEST_CHECK(a.getInvariantHash(labelType) == b.getInvariantHash(labelType));
+			}
+		}
+	};
+	check(LabelType::String, false);
+	check(LabelType::Term, false);
+	check(LabelType::String, true);
+	check(LabelType::Term, true);
+
+	const auto &g0 = graphs[0]->getGraph();
+	const auto &g1 = graphs[1]->getGraph();
+	const auto &g2 = graphs[2]->getGraph();
+	MOD_TEST_CHECK(lib::Graph::Single::canonicalCompare(g0, g1, LabelType::Term, true));
+	MOD_TEST_CHECK(!lib::Graph::Single::canonicalCompare(g0, g2, LabelType::Term, true));
+	MOD_TEST_CHECK(lib::Graph::Single::canonicalCompare(g0, g2, LabelType::Term, false));
+	MOD_TEST_CHECK(lib::Graph::Single::canonicalCompare(graphs[3]->getGraph(), graphs[4]->getGraph(), LabelType::Term, false));
+	MOD_TEST_CHECK(!lib::Graph::Single::canonicalCompare(graphs[3]->getGraph(), graphs[5]->getGraph(), LabelType::Term, false));
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_GRAPHCANON_H
+#define MOD_LIB_TEST_GRAPHCANON_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// Canonical comparison of molecules with term labels and with stereo, compared to VF2 isomorphism.
+void graphCanon();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_GRAPHCANON_H */
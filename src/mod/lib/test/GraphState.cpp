@@ -0,0 +1,131 @@
+#include "GraphState.h"
+
+#include <mod/graph/Graph.h>
+#include <mod/lib/DG/Strategies/GraphState.h>
+#include <mod/lib/Graph/Single.h>
+#include <mod/lib/test/Util.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+using GraphState = lib::DG::Strategies::GraphState;
+
+std::vector<const lib::Graph::Single*> getSubsetGraphs(const GraphState &gs) {
+	return std::vector<const lib::Graph::Single*>(gs.getSubset(0).begin(), gs.getSubset(0).end());
+}
+
+} // namespace
+
+void graphState() {
+	const std::vector<std::shared_ptr<graph::Graph> > graphs{
+		graph::Graph::smiles("C"),
+		graph::Graph::smiles("N"),
+		graph::Graph::smiles("O"),
+		graph::Graph::smiles("S")
+	};
+	const auto *a = &graphs[0]->getGraph();
+	const auto *b = &graphs[1]->getGraph();
+	const auto *c = &graphs[2]->getGraph();
+	const auto *d = &graphs[3]->getGraph();
+
+	{ // the same contents in different orders are equal
+		GraphState gsA(std::vector<const lib::Graph::Single*>{a, b, c});
+		GraphState gsB;
+		MOD_TEST_CHECK(!(gsA == gsB));
+		gsB.addToUniverse(c);
+		gsB.addToUniverse(a);
+		gsB.addToUniverse(b);
+		MOD_TEST_CHECK(gsA == gsB);
+		MOD_TEST_CHECK(gsB.isInUniverse(a));
+		MOD_TEST_CHECK(!gsB.isInUniverse(d));
+		// with the same universe size, but different graphs
+		GraphState gsC(std::vector<const lib::Graph::Single*>{a, b, d});
+		MOD_TEST_CHECK(!(gsA == gsC));
+
+		gsA.addToSubset(0, b);
+		MOD_TEST_CHECK(!(gsA == gsB));
+		gsB.addToSubset(0, a);
+		MOD_TEST_CHECK(!(gsA == gsB));
+		gsA.addToSubset(0, a);
+		gsB.addToSubset(0, b);
+		MOD_TEST_CHECK(gsA == gsB);
+	}
+	{ // adding a graph which is already there changes nothing
+		GraphState gs;
+		gs.addToSubset(0, a);
+		const auto gen = gs.getGeneration();
+		gs.addToSubset(0, a);
+		gs.addToUniverse(a);
+		MOD_TEST_CHECK(gs.getGeneration() == gen);
+		MOD_TEST_CHECK(gs.getUniverse().size() == 1);
+		MOD_TEST_CHECK(gs.getSubset(0).size() == 1);
+		gs.addToUniverse(b);
+		MOD_TEST_CHECK(gs.getGeneration() != gen);
+		MOD_TEST_CHECK(gs.getUniverse().size() == 2);
+		MOD_TEST_CHECK(gs.getSubset(0).size() == 1);
+	}
+	{ // reordering keeps the membership, and the index follows the new order
+		GraphState gs;
+		for(const auto *g : {d, c, b, a}) gs.addToUniverse(g);
+		gs.addToSubset(0, c);
+		gs.addToSubset(0, a);
+		const GraphState before(gs);
+		MOD_TEST_CHECK(gs == before);
+		// a copy is a new state
+		MOD_TEST_CHECK(gs.getGeneration() != before.getGeneration());
+
+		auto gen = gs.getGeneration();
+		gs.sortUniverse(lib::Graph::Single::IdLess());
+		MOD_TEST_CHECK(gs.getGeneration() != gen);
+		MOD_TEST_CHECK(gs.getUniverse() == (std::vector<const lib::Graph::Single*>{a, b, c, d}));
+		MOD_TEST_CHECK(getSubsetGraphs(gs) == (std::vector<const lib::Graph::Single*>{c, a}));
+		MOD_TEST_CHECK(gs == before);
+		// the membership is looked up through the new indices
+		gs.addToSubset(0, a);
+		gs.addToSubset(0, c);
+		MOD_TEST_CHECK(gs.getSubset(0).size() == 2);
+		gs.addToSubset(0, d);
+		MOD_TEST_CHECK(getSubsetGraphs(gs) == (std::vector<const lib::Graph::Single*>{c, a, d}));
+		MOD_TEST_CHECK(!(gs == before));
+
+		gen = gs.getGeneration();
+		gs.setUniverseOrder({b, d, a, c});
+		MOD_TEST_CHECK(gs.getGeneration() != gen);
+		MOD_TEST_CHECK(getSubsetGraphs(gs) == (std::vector<const lib::Graph::Single*>{c, a, d}));
+		gen = gs.getGeneration();
+		gs.setSubsetOrder(0, {d, c, a});
+		MOD_TEST_CHECK(gs.getGeneration() != gen);
+		MOD_TEST_CHECK(getSubsetGraphs(gs) == (std::vector<const lib::Graph::Single*>{d, c, a}));
+		gs.addToSubset(0, d);
+		gs.addToSubset(0, b);
+		MOD_TEST_CHECK(getSubsetGraphs(gs) == (std::vector<const lib::Graph::Single*>{d, c, a, b}));
+	}
+	{ // merging states gives the union of the universes and of the subsets
+		GraphState gsA;
+		gsA.addToUniverse(c);
+		gsA.addToSubset(0, a);
+		GraphState gsB;
+		gsB.addToSubset(0, b);
+		gsB.addToSubset(0, a);
+		const GraphState merged(std::vector<const GraphState*>{&gsA, &gsB});
+		GraphState expected(std::vector<const lib::Graph::Single*>{a, b, c});
+		expected.addToSubset(0, a);
+		expected.addToSubset(0, b);
+		MOD_TEST_CHECK(merged == expected);
+		// and the merged index is usable
+		GraphState gs(merged);
+		gs.addToSubset(0, a);
+		gs.addToSubset(0, c);
+		MOD_TEST_CHECK(gs.getUniverse().size() == 3);
+		MOD_TEST_CHECK(gs.getSubset(0).size() == 3);
+	}
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
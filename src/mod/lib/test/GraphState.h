@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_GRAPHSTATE_H
+#define MOD_LIB_TEST_GRAPHSTATE_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// The index, fingerprints, and generations of strategy graph states, through additions, reorderings, copies, and merges.
+void graphState();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_GRAPHSTATE_H */
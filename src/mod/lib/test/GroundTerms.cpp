@@ -0,0 +1,87 @@
+#include "GroundTerms.h"
+
+#include <mod/Config.h>
+#include <mod/graph/Graph.h>
+#include <mod/lib/Term/GroundTermStore.h>
+#include <mod/lib/Term/WAM.h>
+#include <mod/lib/test/Util.h>
+
+namespace mod {
+namespace lib {
+namespace test {
+
+void groundTerms() {
+	using namespace lib::Term;
+	auto &store = getGroundTerms();
+	// names which are not used by any labels, so the terms are new to the store
+	const std::size_t nameF = 1000001, nameG = 1000002, nameA = 1000003, nameB = 1000004, nameC = 1000005;
+	{ // the same ground term in different layouts gets the same id
+		Wam m1; // f(a, g(b)), with the constant inline
+		m1.putStructure(nameF, 2);
+		m1.putStructure(nameA, 0);
+		m1.putStructurePtr(3);
+		m1.putStructure(nameG, 1);
+		m1.putStructure(nameB, 0);
+		Wam m2; // g(b), and then f(a, g(b)) pointing back at it
+		m2.putStructure(nameB, 0);
+		m2.putStructure(nameG, 1);
+		m2.putStructure(nameB, 0);
+		m2.putStructure(nameF, 2);
+		m2.putStructure(nameA, 0);
+		m2.putStructurePtr(1);
+		const auto id1 = store.getId(m1, {AddressType::Heap, 0});
+		const auto id2 = store.getId(m2, {AddressType::Heap, 3});
+		MOD_TEST_CHECK(id1 != GroundTermStore::NotGround);
+		MOD_TEST_CHECK(id1 == id2);
+		MOD_TEST_CHECK(store.getId(m1, {AddressType::Heap, 3}) == store.getId(m2, {AddressType::Heap, 1}));
+		MOD_TEST_CHECK(store.getId(m1, {AddressType::Heap, 4}) == store.getId(m2, {AddressType::Heap, 0}));
+		MOD_TEST_CHECK(store.getId(m1, {AddressType::Heap, 3}) != id1);
+
+		Wam m3; // f(a, g(c))
+		m3.putStructure(nameF, 2);
+		m3.putStructure(nameA, 0);
+		m3.putStructurePtr(3);
+		m3.putStructure(nameG, 1);
+		m3.putStructure(nameC, 0);
+		MOD_TEST_CHECK(store.getId(m3, {AddressType::Heap, 0}) != id1);
+		Wam m4; // f(a, X)
+		m4.putStructure(nameF, 2);
+		m4.putStructure(nameA, 0);
+		m4.putRefPtr();
+		MOD_TEST_CHECK(store.getId(m4, {AddressType::Heap, 0}) == GroundTermStore::NotGround);
+		MOD_TEST_CHECK(store.getId(m4, {AddressType::Heap, 2}) == GroundTermStore::NotGround);
+
+		// a full store still finds the terms it has, but does not intern new ones
+		auto &limit = getConfig().unification.groundTermStoreLimit;
+		const auto oldLimit = limit.get();
+		const auto size = store.size();
+		limit.set(static_cast<unsigned int>(size));
+		MOD_TEST_CHECK(store.getId(m2, {AddressType::Heap, 3}) == id1);
+		Wam m5; // g(c, c)
+		m5.putStructure(nameG, 2);
+		m5.putStructure(nameC, 0);
+		m5.putStructure(nameC, 0);
+		MOD_TEST_CHECK(store.getId(m5, {AddressType::Heap, 0}) == GroundTermStore::NotGround);
+		MOD_TEST_CHECK(store.size() == size);
+		limit.set(oldLimit);
+		MOD_TEST_CHECK(store.getId(m5, {AddressType::Heap, 0}) != GroundTermStore::NotGround);
+	}
+	{ // labels are matched by the ids when both are ground, and structurally otherwise
+		const auto gA = graph::Graph::graphDFS("[f(a,g(b))][c]");
+		const auto gB = graph::Graph::graphDFS("[c][f(a,g(b))]");
+		const auto gC = graph::Graph::graphDFS("[f(a,g(c))][c]");
+		const auto gVar = graph::Graph::graphDFS("[f(a,_X)][c]");
+		const auto iso = LabelSettings(LabelType::Term, LabelRelation::Isomorphism);
+		const auto spec = LabelSettings(LabelType::Term, LabelRelation::Specialisation);
+		MOD_TEST_CHECK(1 == gA->isomorphism(gB, 1, iso));
+		MOD_TEST_CHECK(0 == gA->isomorphism(gC, 1, iso));
+		MOD_TEST_CHECK(0 == gA->isomorphism(gVar, 1, iso));
+		MOD_TEST_CHECK(1 == gVar->monomorphism(gA, 1, spec));
+		MOD_TEST_CHECK(1 == gVar->monomorphism(gC, 1, spec));
+		MOD_TEST_CHECK(0 == gA->monomorphism(gVar, 1, spec));
+	}
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
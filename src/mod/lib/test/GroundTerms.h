@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_GROUNDTERMS_H
+#define MOD_LIB_TEST_GROUNDTERMS_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// The hash-consing of ground terms, and the matching of ground labels by their ids.
+void groundTerms();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_GROUNDTERMS_H */
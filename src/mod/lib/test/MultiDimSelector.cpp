@@ -0,0 +1,166 @@
+#include "MultiDimSelector.h"
+
+#include <mod/Config.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/Algorithm.h>
+#include <mod/lib/RC/ComposeRuleReal.h>
+#include <mod/lib/RC/MatchMaker/ComponentMorphismCache.h>
+#include <mod/lib/RC/MatchMaker/LazyComponentMorphisms.h>
+#include <mod/lib/RC/MatchMaker/Super.h>
+#include <mod/lib/Rules/Real.h>
+#include <mod/lib/test/Util.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+
+// pattern -> host -> morphisms, where a morphism is just a number
+using Morphisms = std::vector<std::vector<std::vector<int> > >;
+// the chosen (host, morphism) for each pattern, with host == numHosts for an unmatched pattern
+using Combination = std::vector<std::pair<std::size_t, int> >;
+
+bool isCompatible(std::size_t, int a, std::size_t, int b) {
+	return (a + b) % 3 != 0;
+}
+
+void bruteForce(const Morphisms &morphisms, std::size_t numHosts, bool allowPartial,
+		Combination &current, std::vector<Combination> &result) {
+	const std::size_t pattern = current.size();
+	if(pattern == morphisms.size()) {
+		const bool anyMatched = std::any_of(current.begin(), current.end(), [numHosts](const std::pair<std::size_t, int> &p) {
+			return p.first != numHosts;
+		});
+		if(allowPartial && !anyMatched) return;
+		for(std::size_t a = 0; a < current.size(); ++a) {
+			for(std::size_t b = a + 1; b < current.size(); ++b) {
+				if(current[a].first == numHosts || current[a].first != current[b].first) continue;
+				if(!isCompatible(a, current[a].second, b, current[b].second)) return;
+			}
+		}
+		result.push_back(current);
+		return;
+	}
+	for(std::size_t host = 0; host < numHosts; ++host) {
+		for(const int m : morphisms[pattern][host]) {
+			current.emplace_back(host, m);
+			bruteForce(morphisms, numHosts, allowPartial, current, result);
+			current.pop_back();
+		}
+	}
+	if(allowPartial) {
+		current.emplace_back(numHosts, -1);
+		bruteForce(morphisms, numHosts, allowPartial, current, result);
+		current.pop_back();
+	}
+}
+
+template<bool AllowPartial, typename Provider>
+std::vector<Combination> select(std::size_t numPatterns, std::size_t numHosts, Provider provider) {
+	std::vector<Combination> result;
+	auto mm = makeMultiDimSelector<AllowPartial>(numPatterns, numHosts, provider, &isCompatible);
+	for(const auto &position : mm) {
+		Combination c;
+		for(const auto &p : position) {
+			if(p.host == numHosts) c.emplace_back(numHosts, -1);
+			else c.emplace_back(p.host, *p.iterMorphism);
+		}
+		result.push_back(c);
+	}
+	return result;
+}
+
+template<bool AllowPartial>
+void checkSelector(const Morphisms &morphisms, std::size_t numHosts) {
+	std::vector<Combination> expected;
+	Combination current;
+	bruteForce(morphisms, numHosts, AllowPartial, current, expected);
+	std::sort(expected.begin(), expected.end());
+	const auto complete = select<AllowPartial>(morphisms.size(), numHosts, [&](std::size_t pattern, std::size_t host) {
+		return morphisms[pattern][host];
+	});
+	// fetched in chunks from a finder which continues where it stopped
+	const auto lazy = select<AllowPartial>(morphisms.size(), numHosts, [&](std::size_t pattern, std::size_t host) {
+		const auto &ms = morphisms[pattern][host];
+		std::size_t next = 0;
+		return RC::LazyComponentMorphisms<int>([&ms, next](std::size_t limit) mutable {
+			const std::size_t last = std::min(ms.size(), next + limit);
+			std::vector<int> chunk(ms.begin() + next, ms.begin() + last);
+			next = last;
+			return chunk;
+		});
+	});
+	MOD_TEST_CHECK(complete == lazy);
+	auto sorted = complete;
+	std::sort(sorted.begin(), sorted.end());
+	MOD_TEST_CHECK(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+	MOD_TEST_CHECK(sorted == expected);
+}
+
+std::vector<std::unique_ptr<lib::Rules::Real> > compose(const lib::Rules::Real &rFirst, const lib::Rules::Real &rSecond,
+		LabelSettings labelSettings, RC::ComponentMorphismCache *morphismCache) {
+	std::vector<std::unique_ptr<lib::Rules::Real> > result;
+	RC::Super mm(true, true, morphismCache);
+	RC::composeRuleRealByMatchMaker(rFirst, rSecond, mm, [&result](std::unique_ptr<lib::Rules::Real> r) {
+		result.push_back(std::move(r));
+	}, labelSettings);
+	return result;
+}
+
+} // namespace
+
+void multiDimSelector() {
+	{ // three patterns into three hosts, with empty ranges and ranges longer than the first chunk
+		const std::size_t numHosts = 3;
+		Morphisms morphisms(3, std::vector<std::vector<int> >(numHosts));
+		for(std::size_t pattern = 0; pattern < morphisms.size(); ++pattern) {
+			for(std::size_t host = 0; host < numHosts; ++host) {
+				const int num = (pattern + host) % 2 == 0 ? 11 : 2 * host;
+				for(int i = 0; i < num; ++i)
+					morphisms[pattern][host].push_back(100 * pattern + 10 * host + i);
+			}
+		}
+		checkSelector<false>(morphisms, numHosts);
+		checkSelector<true>(morphisms, numHosts);
+		// a pattern without morphisms
+		morphisms[1] = std::vector<std::vector<int> >(numHosts);
+		checkSelector<false>(morphisms, numHosts);
+		checkSelector<true>(morphisms, numHosts);
+	}
+
+	// a chain of 10 carbons and a chain of 3 carbons, so the ranges of the bond rule components cross a chunk
+	const auto rFirst = rule::Rule::ruleGMLString(R"(rule [
+	ruleID "chains"
+	right [
+		node [ id 0 label "C" ] node [ id 1 label "C" ] node [ id 2 label "C" ] node [ id 3 label "C" ]
+		node [ id 4 label "C" ] node [ id 5 label "C" ] node [ id 6 label "C" ] node [ id 7 label "C" ]
+		node [ id 8 label "C" ] node [ id 9 label "C" ]
+		edge [ source 0 target 1 label "-" ] edge [ source 1 target 2 label "-" ] edge [ source 2 target 3 label "-" ]
+		edge [ source 3 target 4 label "-" ] edge [ source 4 target 5 label "-" ] edge [ source 5 target 6 label "-" ]
+		edge [ source 6 target 7 label "-" ] edge [ source 7 target 8 label "-" ] edge [ source 8 target 9 label "-" ]
+		node [ id 10 label "C" ] node [ id 11 label "C" ] node [ id 12 label "C" ]
+		edge [ source 10 target 11 label "-" ] edge [ source 11 target 12 label "-" ]
+	]
+])", false);
+	const auto rSecond = makeBondRule();
+	const auto labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	const auto expected = compose(rFirst->getRule(), rSecond->getRule(), labelSettings, nullptr);
+	MOD_TEST_CHECK(!expected.empty());
+	RC::ComponentMorphismCache cache(100000);
+	// the first use fills the cache, the second iterates the cached ranges
+	for(int round = 0; round < 2; ++round) {
+		const auto cached = compose(rFirst->getRule(), rSecond->getRule(), labelSettings, &cache);
+		MOD_TEST_CHECK(cached.size() == expected.size());
+		for(std::size_t i = 0; i < cached.size(); ++i)
+			MOD_TEST_CHECK(1 == lib::Rules::Real::isomorphism(*cached[i], *expected[i], 1, labelSettings));
+	}
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
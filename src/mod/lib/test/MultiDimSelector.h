@@ -0,0 +1,16 @@
+#ifndef MOD_LIB_TEST_MULTIDIMSELECTOR_H
+#define MOD_LIB_TEST_MULTIDIMSELECTOR_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// The combinations of the MultiDimSelector with complete and with lazy morphism ranges, compared to brute force,
+// and rule compositions with and without the component morphism cache.
+void multiDimSelector();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_MULTIDIMSELECTOR_H */
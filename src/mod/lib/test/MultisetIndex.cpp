@@ -0,0 +1,101 @@
+#include "MultisetIndex.h"
+
+#include <mod/graph/Graph.h>
+#include <mod/lib/DG/GraphDecl.h>
+#include <mod/lib/DG/MultisetIndex.h>
+#include <mod/lib/Graph/Single.h>
+#include <mod/lib/test/Util.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+using GraphList = std::vector<const lib::Graph::Single*>;
+using DG::GraphMultiset;
+
+// all multisets of the given graphs with sizes from 1 to maxSize, each sorted by position in graphs
+void makeMultisets(const GraphList &graphs, std::size_t maxSize, std::size_t first, GraphList &current, std::vector<GraphList> &result) {
+	if(!current.empty()) result.push_back(current);
+	if(current.size() == maxSize) return;
+	for(std::size_t i = first; i < graphs.size(); ++i) {
+		current.push_back(graphs[i]);
+		makeMultisets(graphs, maxSize, i, current, result);
+		current.pop_back();
+	}
+}
+
+} // namespace
+
+void multisetIndex() {
+	std::vector<std::shared_ptr<graph::Graph> > graphsOwner;
+	GraphList graphs;
+	for(const auto *smiles : {"C", "N", "O", "S", "P", "CC"}) {
+		graphsOwner.push_back(graph::Graph::smiles(smiles));
+		graphs.push_back(&graphsOwner.back()->getGraph());
+	}
+	const auto *a = graphs[0];
+	const auto *b = graphs[1];
+	const auto *c = graphs[2];
+	const auto *d = graphs[3];
+
+	{ // the order of construction does not matter, and copies are equal, both for inline and heap storage
+		for(const auto &gs : {GraphList{a, b}, GraphList{a, b, c, d}}) {
+			auto gsReversed = gs;
+			std::reverse(gsReversed.begin(), gsReversed.end());
+			const GraphMultiset gms(gs), gmsReversed(gsReversed);
+			MOD_TEST_CHECK(gms == gmsReversed);
+			MOD_TEST_CHECK(gms.getHash() == gmsReversed.getHash());
+			MOD_TEST_CHECK(gms.size() == gs.size());
+			MOD_TEST_CHECK(std::is_sorted(gms.begin(), gms.end(), lib::Graph::Single::IdLess()));
+			GraphMultiset gmsCopy(gms);
+			MOD_TEST_CHECK(gmsCopy == gms);
+			GraphMultiset gmsMoved(std::move(gmsCopy));
+			MOD_TEST_CHECK(gmsMoved == gms);
+		}
+		// assignments between the two kinds of storage
+		const GraphMultiset gmsSmall(GraphList{a, a}), gmsLarge(GraphList{a, b, c, d});
+		GraphMultiset gms(gmsSmall);
+		gms = gmsLarge;
+		MOD_TEST_CHECK(gms == gmsLarge);
+		gms = gmsSmall;
+		MOD_TEST_CHECK(gms == gmsSmall);
+		gms = GraphMultiset(GraphList{a, b, c, d});
+		MOD_TEST_CHECK(gms == gmsLarge);
+		gms = GraphMultiset(a);
+		MOD_TEST_CHECK(gms == GraphMultiset(GraphList{a}));
+		// the multiplicity matters
+		MOD_TEST_CHECK(!(GraphMultiset(GraphList{a, a, b}) == GraphMultiset(GraphList{a, b, b})));
+		MOD_TEST_CHECK(!(GraphMultiset(GraphList{a, a, b}) == GraphMultiset(GraphList{a, b})));
+	}
+	{ // enough vertices for the table to grow several times, and each can be found while the others are inserted
+		std::vector<GraphList> multisets;
+		GraphList current;
+		makeMultisets(graphs, 4, 0, current, multisets);
+		DG::NonHyperGraphType dg;
+		DG::MultisetIndex index(dg);
+		const auto nullVertex = dg.null_vertex();
+		MOD_TEST_CHECK(index.find(GraphMultiset(a)) == nullVertex);
+		for(std::size_t i = 0; i < multisets.size(); ++i) {
+			auto gs = multisets[i];
+			std::reverse(gs.begin(), gs.end());
+			const GraphMultiset gms(std::move(gs));
+			MOD_TEST_CHECK(index.find(gms) == nullVertex);
+			const auto v = add_vertex(dg);
+			dg[v].graphs = gms;
+			index.insert(v);
+			MOD_TEST_CHECK(index.find(gms) == v);
+		}
+		for(std::size_t i = 0; i < multisets.size(); ++i)
+			MOD_TEST_CHECK(index.find(GraphMultiset(multisets[i])) == vertex(i, dg));
+		MOD_TEST_CHECK(index.find(GraphMultiset(GraphList{a, b, c, d, a})) == nullVertex);
+	}
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_MULTISETINDEX_H
+#define MOD_LIB_TEST_MULTISETINDEX_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// Graph multisets, stored inline and on the heap, and the hash table of derivation graph vertices by their multisets.
+void multisetIndex();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_MULTISETINDEX_H */
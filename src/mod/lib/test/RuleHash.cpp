@@ -0,0 +1,73 @@
+#include "RuleHash.h"
+
+#include <mod/Config.h>
+#include <mod/rule/Composer.h>
+#include <mod/rule/CompositionExpr.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/Rules/Real.h>
+#include <mod/lib/test/Util.h>
+
+#include <unordered_set>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+
+void ruleHash() {
+	// the same rule with the vertices in different orders
+	const auto rA = rule::Rule::ruleGMLString(R"(rule [
+	left [
+		edge [ source 0 target 1 label "-" ]
+	]
+	context [
+		node [ id 0 label "C" ]
+		node [ id 1 label "O" ]
+		node [ id 2 label "N" ]
+	]
+	right [
+		edge [ source 1 target 2 label "=" ]
+	]
+])", false);
+	const auto rB = rule::Rule::ruleGMLString(R"(rule [
+	left [
+		edge [ source 2 target 1 label "-" ]
+	]
+	context [
+		node [ id 0 label "N" ]
+		node [ id 1 label "O" ]
+		node [ id 2 label "C" ]
+	]
+	right [
+		edge [ source 0 target 1 label "=" ]
+	]
+])", false);
+	for(const auto labelType : {LabelType::String, LabelType::Term}) {
+		const auto labelSettings = LabelSettings(labelType, LabelRelation::Isomorphism);
+		MOD_TEST_CHECK(1 == rA->isomorphism(rB, 1, labelSettings));
+		MOD_TEST_CHECK(rA->getRule().getInvariantHash(labelType) == rB->getRule().getInvariantHash(labelType));
+	}
+
+	// the results of a composition are deduplicated against the database and each other
+	const auto labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	const auto rBond = makeBondRule();
+	const auto composer = rule::Composer::create({rBond, rA, rB}, labelSettings);
+	// the given rules are kept as they are
+	MOD_TEST_CHECK(composer->getRuleDatabase().size() == 3);
+	const auto exp = rule::RCExp::Expression(rule::RCExp::ComposeCommon(rBond, rBond, false, false, false));
+	const auto results = composer->eval(exp);
+	MOD_TEST_CHECK(!results.empty());
+	const std::vector<std::shared_ptr<rule::Rule> > resultList(results.begin(), results.end());
+	for(std::size_t i = 0; i < resultList.size(); ++i)
+		for(std::size_t j = i + 1; j < resultList.size(); ++j)
+			MOD_TEST_CHECK(0 == resultList[i]->isomorphism(resultList[j], 1, labelSettings));
+	// none of the results are isomorphic to the given rules, so they are all new
+	MOD_TEST_CHECK(composer->getRuleDatabase().size() == 3 + results.size());
+	// evaluating again finds the same rules in the database
+	MOD_TEST_CHECK(composer->eval(exp) == results);
+	MOD_TEST_CHECK(composer->getRuleDatabase().size() == 3 + results.size());
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
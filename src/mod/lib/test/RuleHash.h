@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_RULEHASH_H
+#define MOD_LIB_TEST_RULEHASH_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// The invariant hash of rules, and the duplicate detection in rule composition built on it.
+void ruleHash();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_RULEHASH_H */
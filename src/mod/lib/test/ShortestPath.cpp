@@ -0,0 +1,116 @@
+#include "ShortestPath.h"
+
+#include <mod/Config.h>
+#include <mod/dg/DG.h>
+#include <mod/dg/GraphInterface.h>
+#include <mod/dg/Strategies.h>
+#include <mod/graph/Graph.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/Rules/Real.h>
+#include <mod/lib/test/Util.h>
+
+#include <jla_boost/graph/BFSDistances.hpp>
+
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+
+// changes C-C to C=C in a C-C-C path where the ends have the given distance in the host
+std::shared_ptr<rule::Rule> makeRule(const std::string &op, int length) {
+	return rule::Rule::ruleGMLString(R"(rule [
+	ruleID "double"
+	left [
+		edge [ source 0 target 1 label "-" ]
+	]
+	context [
+		node [ id 0 label "C" ]
+		node [ id 1 label "C" ]
+		node [ id 2 label "C" ]
+		edge [ source 1 target 2 label "-" ]
+	]
+	right [
+		edge [ source 0 target 1 label "=" ]
+	]
+	constrainShortestPath [ source 0 target 2 op ")" + op + R"(" length )" + std::to_string(length) + R"( ]
+])", false);
+}
+
+// the graphs the rule was applied to
+std::set<std::shared_ptr<graph::Graph> > getSources(const std::vector<std::shared_ptr<graph::Graph> > &graphs,
+		std::shared_ptr<rule::Rule> r) {
+	const auto labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	const auto strategy = dg::Strategy::makeSequence({
+		dg::Strategy::makeAdd(false, graphs),
+		dg::Strategy::makeRule(r)
+	});
+	const auto dg = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+	dg->calc();
+	std::set<std::shared_ptr<graph::Graph> > sources;
+	for(const auto e : dg->edges()) {
+		for(const auto v : e.sources()) sources.insert(v.getGraph());
+	}
+	return sources;
+}
+
+} // namespace
+
+void shortestPath() {
+	constexpr int inf = std::numeric_limits<int>::max();
+	{ // the cached distances of a rule side agree with the search, also when the search is bounded
+		const auto r = rule::Rule::ruleGMLString(R"(rule [
+	context [
+		node [ id 0 label "C" ]
+		node [ id 1 label "C" ]
+		node [ id 2 label "C" ]
+		node [ id 3 label "C" ]
+		edge [ source 0 target 1 label "-" ]
+		edge [ source 1 target 2 label "-" ]
+	]
+])", false);
+		const auto gLeft = get_labelled_left(r->getRule().getDPORule());
+		const auto &g = get_graph(gLeft);
+		const auto idx = get(boost::vertex_index_t(), g);
+		std::vector<int> distanceCounts(3, 0);
+		int numUnreachable = 0;
+		for(const auto u : asRange(vertices(g))) {
+			const auto &distances = get_shortest_path_distances(gLeft, u);
+			const auto distancesBounded = jla_boost::bfs_distances(g, u, 1);
+			// cached, so the same vector is returned again
+			MOD_TEST_CHECK(&get_shortest_path_distances(gLeft, u) == &distances);
+			for(const auto v : asRange(vertices(g))) {
+				const int d = distances[get(idx, v)];
+				MOD_TEST_CHECK(d == get_shortest_path_distances(gLeft, v)[get(idx, u)]);
+				MOD_TEST_CHECK(d == jla_boost::bfs_distance(g, u, v));
+				MOD_TEST_CHECK(jla_boost::bfs_distance(g, u, v, 1) == (d <= 1 ? d : inf));
+				MOD_TEST_CHECK(distancesBounded[get(idx, v)] == (d <= 1 ? d : inf));
+				if(d == inf) ++numUnreachable;
+				else ++distanceCounts[d];
+			}
+		}
+		MOD_TEST_CHECK(distanceCounts == (std::vector<int>{4, 4, 2}));
+		MOD_TEST_CHECK(numUnreachable == 6);
+	}
+
+	// the constraint decides which graphs the rule can be applied to
+	const auto gOpen = graph::Graph::graphDFS("[C][C][C]");
+	const auto gRing = graph::Graph::graphDFS("[C]1[C][C]1");
+	const std::vector<std::shared_ptr<graph::Graph> > graphs{gOpen, gRing};
+	using Sources = std::set<std::shared_ptr<graph::Graph> >;
+	MOD_TEST_CHECK(getSources(graphs, makeRule("=", 2)) == (Sources{gOpen}));
+	MOD_TEST_CHECK(getSources(graphs, makeRule("=", 1)) == (Sources{gRing}));
+	MOD_TEST_CHECK(getSources(graphs, makeRule("<", 2)) == (Sources{gRing}));
+	MOD_TEST_CHECK(getSources(graphs, makeRule("<=", 2)) == (Sources{gOpen, gRing}));
+	MOD_TEST_CHECK(getSources(graphs, makeRule(">=", 2)) == (Sources{gOpen}));
+	MOD_TEST_CHECK(getSources(graphs, makeRule(">", 2)) == Sources());
+	MOD_TEST_CHECK(getSources(graphs, makeRule("=", 0)) == Sources());
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
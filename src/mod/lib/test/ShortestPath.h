@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_SHORTESTPATH_H
+#define MOD_LIB_TEST_SHORTESTPATH_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// The shortest path match constraint, with the distances cached in the codomain rule and with the bounded search.
+void shortestPath();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_SHORTESTPATH_H */
@@ -0,0 +1,91 @@
+#include "SortByKey.h"
+
+#include <mod/Config.h>
+#include <mod/Function.h>
+#include <mod/dg/DG.h>
+#include <mod/dg/Strategies.h>
+#include <mod/graph/Graph.h>
+#include <mod/lib/test/Util.h>
+
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+
+void sortByKey() {
+	using GraphList = std::vector<std::shared_ptr<graph::Graph> >;
+	using GS = dg::Strategy::GraphState;
+	const GraphList graphs{
+		graph::Graph::graphDFS("[C]"),
+		graph::Graph::graphDFS("[N]"),
+		graph::Graph::graphDFS("[O]"),
+		graph::Graph::graphDFS("[S]"),
+		graph::Graph::graphDFS("[P]")
+	};
+	// the names are in reverse order of the graphs
+	const std::vector<std::string> names{"e", "d", "c", "b", "a"};
+	for(std::size_t i = 0; i < graphs.size(); ++i) graphs[i]->setName(names[i]);
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	// a tie between the first and third graph, which must keep their order, and two NaN keys which must be last
+	const std::map<std::shared_ptr<graph::Graph>, double> keys{
+		{graphs[0], 2},
+		{graphs[1], nan},
+		{graphs[2], 2},
+		{graphs[3], -1},
+		{graphs[4], nan}
+	};
+
+	int numKeyCalls = 0;
+	GraphList subset, universe;
+	const auto numKey = fromStdFunction<double(std::shared_ptr<graph::Graph>, const GS&)>(
+			"numKey", [&](std::shared_ptr<graph::Graph> g, const GS &gs) {
+				++numKeyCalls;
+				return keys.at(g);
+			});
+	const auto nameKey = fromStdFunction<std::string(std::shared_ptr<graph::Graph>, const GS&)>(
+			"nameKey", [&](std::shared_ptr<graph::Graph> g, const GS &gs) {
+				++numKeyCalls;
+				return g->getName();
+			});
+	const auto record = fromStdFunction<void(const GS&)>(
+			"record", [&](const GS &gs) {
+				subset = gs.getSubset();
+				universe = gs.getUniverse();
+			});
+
+	const auto labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	const auto run = [&](std::shared_ptr<dg::Strategy> sort) {
+		numKeyCalls = 0;
+		subset.clear();
+		universe.clear();
+		const auto strategy = dg::Strategy::makeSequence({
+			dg::Strategy::makeAdd(false, graphs),
+			sort,
+			dg::Strategy::makeExecute(record->clone())
+		});
+		const auto dg = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+		dg->calc();
+	};
+
+	// the subset by numbers, where the universe must not be reordered
+	run(dg::Strategy::makeSortByKey(false, numKey->clone()));
+	MOD_TEST_CHECK(numKeyCalls == 5);
+	MOD_TEST_CHECK(subset == GraphList({graphs[3], graphs[0], graphs[2], graphs[1], graphs[4]}));
+	MOD_TEST_CHECK(universe.size() == graphs.size());
+	const auto universeUnsorted = universe;
+
+	// the universe by names, where the subset must not be reordered
+	run(dg::Strategy::makeSortByKey(true, nameKey->clone()));
+	MOD_TEST_CHECK(numKeyCalls == 5);
+	MOD_TEST_CHECK(universe == GraphList({graphs[4], graphs[3], graphs[2], graphs[1], graphs[0]}));
+	MOD_TEST_CHECK(subset == graphs);
+	MOD_TEST_CHECK(universeUnsorted != universe);
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
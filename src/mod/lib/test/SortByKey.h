@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_SORTBYKEY_H
+#define MOD_LIB_TEST_SORTBYKEY_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// The sort strategy by per-graph keys, its order of ties and NaN keys, and the number of key evaluations.
+void sortByKey();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_SORTBYKEY_H */
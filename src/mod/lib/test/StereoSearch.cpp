@@ -0,0 +1,69 @@
+#include "StereoSearch.h"
+
+#include <mod/Config.h>
+#include <mod/graph/Graph.h>
+#include <mod/lib/test/Util.h>
+
+#include <limits>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+
+LabelSettings makeLabelSettings(LabelType labelType, LabelRelation stereoRelation, bool incremental) {
+	auto labelSettings = LabelSettings(labelType, LabelRelation::Isomorphism, stereoRelation);
+	labelSettings.incrementalStereo = incremental;
+	return labelSettings;
+}
+
+// the number of isomorphisms, checked to be the same with and without the incremental check
+std::size_t countIso(std::shared_ptr<graph::Graph> gDom, std::shared_ptr<graph::Graph> gCodom, LabelType labelType) {
+	const auto max = std::numeric_limits<std::size_t>::max();
+	const auto labelSettings = makeLabelSettings(labelType, LabelRelation::Isomorphism, true);
+	const auto num = gDom->isomorphism(gCodom, max, labelSettings);
+	MOD_TEST_CHECK(num == gDom->isomorphism(gCodom, max, makeLabelSettings(labelType, LabelRelation::Isomorphism, false)));
+	return num;
+}
+
+} // namespace
+
+void stereoSearch() {
+	const std::vector<std::shared_ptr<graph::Graph> > graphs{
+		graph::Graph::smiles("C[C@H](N)O"),
+		graph::Graph::smiles("C[C@@H](N)O"),
+		graph::Graph::smiles("C[C@@H](O)N"),
+		graph::Graph::smiles("N[C@@H](C)C(=O)O"),
+		graph::Graph::smiles("N[C@H](C)C(=O)O"),
+		graph::Graph::smiles("C/C=C/C"),
+		graph::Graph::smiles("C/C=C\\C"),
+		graph::Graph::smiles("CC(N)O"),
+		graph::Graph::smiles("CC(N)CO")
+	};
+	const auto max = std::numeric_limits<std::size_t>::max();
+	for(const auto labelType : {LabelType::String, LabelType::Term}) {
+		for(const auto stereoRelation : {LabelRelation::Isomorphism, LabelRelation::Specialisation}) {
+			for(const auto &gDom : graphs) {
+				for(const auto &gCodom : graphs) {
+					const auto numIso = gDom->isomorphism(gCodom, max, makeLabelSettings(labelType, stereoRelation, true));
+					MOD_TEST_CHECK(numIso == gDom->isomorphism(gCodom, max, makeLabelSettings(labelType, stereoRelation, false)));
+					const auto numMono = gDom->monomorphism(gCodom, max, makeLabelSettings(labelType, stereoRelation, true));
+					MOD_TEST_CHECK(numMono == gDom->monomorphism(gCodom, max, makeLabelSettings(labelType, stereoRelation, false)));
+					MOD_TEST_CHECK(numIso <= numMono);
+				}
+			}
+		}
+		// swapping two neighbours inverts the chirality symbol, so the first and third are the same
+		MOD_TEST_CHECK(countIso(graphs[0], graphs[2], labelType) > 0);
+		MOD_TEST_CHECK(countIso(graphs[0], graphs[1], labelType) == 0);
+		MOD_TEST_CHECK(countIso(graphs[3], graphs[4], labelType) == 0);
+		MOD_TEST_CHECK(countIso(graphs[3], graphs[3], labelType) > 0);
+		MOD_TEST_CHECK(countIso(graphs[5], graphs[6], labelType) == 0);
+		MOD_TEST_CHECK(countIso(graphs[5], graphs[5], labelType) > 0);
+	}
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
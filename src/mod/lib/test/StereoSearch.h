@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_STEREOSEARCH_H
+#define MOD_LIB_TEST_STEREOSEARCH_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// Morphisms with stereo, where the configurations are checked during the search, compared to checking complete morphisms.
+void stereoSearch();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_STEREOSEARCH_H */
@@ -0,0 +1,151 @@
+#include "TermMorphism.h"
+
+#include <mod/Config.h>
+#include <mod/dg/DG.h>
+#include <mod/dg/GraphInterface.h>
+#include <mod/dg/Strategies.h>
+#include <mod/graph/Graph.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/Graph/Single.h>
+#include <mod/lib/Graph/Properties/Stereo.h>
+#include <mod/lib/Graph/Properties/String.h>
+#include <mod/lib/Graph/Properties/Term.h>
+#include <mod/lib/GraphMorphism/LabelledMorphism.h>
+#include <mod/lib/GraphMorphism/VF2Finder.hpp>
+#include <mod/lib/test/Util.h>
+
+#include <jla_boost/graph/morphism/callbacks/Limit.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+namespace GM = jla_boost::GraphMorphism;
+
+// the same search, but as it is not declared to call the search hooks, each morphism is unified from scratch
+struct VF2MonomorphismFromScratch : lib::GraphMorphism::VF2Monomorphism {
+};
+
+struct VF2IsomorphismFromScratch : lib::GraphMorphism::VF2Isomorphism {
+};
+
+template<typename Finder>
+std::size_t count(std::shared_ptr<graph::Graph> gDom, std::shared_ptr<graph::Graph> gCodom, LabelRelation relation, Finder finder) {
+	const auto labelSettings = LabelSettings(LabelType::Term, relation);
+	auto mr = GM::makeLimit(std::numeric_limits<std::size_t>::max());
+	lib::GraphMorphism::morphismSelectByLabelSettings(gDom->getGraph().getLabelledGraph(), gCodom->getGraph().getLabelledGraph(),
+			labelSettings, finder, std::ref(mr));
+	return mr.getNumHits();
+}
+
+std::size_t countMono(std::shared_ptr<graph::Graph> gDom, std::shared_ptr<graph::Graph> gCodom, LabelRelation relation) {
+	const auto numIncremental = count(gDom, gCodom, relation, lib::GraphMorphism::VF2Monomorphism());
+	const auto numFromScratch = count(gDom, gCodom, relation, VF2MonomorphismFromScratch());
+	MOD_TEST_CHECK(numIncremental == numFromScratch);
+	return numIncremental;
+}
+
+std::size_t countIso(std::shared_ptr<graph::Graph> gDom, std::shared_ptr<graph::Graph> gCodom) {
+	const auto numIncremental = count(gDom, gCodom, LabelRelation::Isomorphism, lib::GraphMorphism::VF2Isomorphism());
+	const auto numFromScratch = count(gDom, gCodom, LabelRelation::Isomorphism, VF2IsomorphismFromScratch());
+	MOD_TEST_CHECK(numIncremental == numFromScratch);
+	return numIncremental;
+}
+
+} // namespace
+
+void termMorphism() {
+	{ // vertex terms, where a variable used twice must get the same value
+		const auto pattern = graph::Graph::graphDFS("[_X][_Y][_X]");
+		const auto hostABA = graph::Graph::graphDFS("[a][b][a]");
+		const auto hostABC = graph::Graph::graphDFS("[a][b][c]");
+		const auto hostAAA = graph::Graph::graphDFS("[a][a][a]");
+		const auto hostVar = graph::Graph::graphDFS("[f(_Z)][b][f(c)]");
+		for(const auto relation : {LabelRelation::Specialisation, LabelRelation::Unification}) {
+			// the morphism and its reverse
+			MOD_TEST_CHECK(countMono(pattern, hostABA, relation) == 2);
+			MOD_TEST_CHECK(countMono(pattern, hostABC, relation) == 0);
+			MOD_TEST_CHECK(countMono(pattern, hostAAA, relation) == 2);
+		}
+		// _X = f(_Z) = f(c) only unifies when the host variable may be bound
+		MOD_TEST_CHECK(countMono(pattern, hostVar, LabelRelation::Unification) == 2);
+		countMono(pattern, hostVar, LabelRelation::Specialisation);
+		// the other way around, the host variables are bound to different constants
+		MOD_TEST_CHECK(countMono(hostABA, pattern, LabelRelation::Unification) == 2);
+		MOD_TEST_CHECK(countMono(hostABC, pattern, LabelRelation::Unification) == 0);
+	}
+	{ // edge terms, which are unified when the second end point is mapped, and undone when the search backtracks
+		const auto pattern = graph::Graph::graphGMLString(R"(graph [
+	node [ id 0 label "_C" ]
+	node [ id 1 label "_L" ]
+	node [ id 2 label "_L" ]
+	edge [ source 0 target 1 label "_E" ]
+	edge [ source 0 target 2 label "_E" ]
+])");
+		const auto host = graph::Graph::graphGMLString(R"(graph [
+	node [ id 0 label "c" ]
+	node [ id 1 label "a" ]
+	node [ id 2 label "a" ]
+	node [ id 3 label "a" ]
+	node [ id 4 label "b" ]
+	edge [ source 0 target 1 label "x" ]
+	edge [ source 0 target 2 label "x" ]
+	edge [ source 0 target 3 label "y" ]
+	edge [ source 0 target 4 label "x" ]
+])");
+		// only the two leaves with label a and edge x, in both orders
+		for(const auto relation : {LabelRelation::Specialisation, LabelRelation::Unification})
+			MOD_TEST_CHECK(countMono(pattern, host, relation) == 2);
+		MOD_TEST_CHECK(countMono(host, pattern, LabelRelation::Unification) == 0);
+	}
+	{ // isomorphism requires the unifier to be a renaming
+		const auto gXY = graph::Graph::graphDFS("[_X][_Y]");
+		const auto gAB = graph::Graph::graphDFS("[_A][_B]");
+		const auto gAA = graph::Graph::graphDFS("[_A][_A]");
+		MOD_TEST_CHECK(countIso(gXY, gAB) == 2);
+		MOD_TEST_CHECK(countIso(gXY, gAA) == 0);
+		MOD_TEST_CHECK(countIso(gAA, gXY) == 0);
+	}
+	{ // in a derivation graph a variable shared between left components must be bound to the same term in both
+		const auto rLink = rule::Rule::ruleGMLString(R"(rule [
+	ruleID "link"
+	context [
+		node [ id 0 label "_X" ]
+		node [ id 1 label "_X" ]
+	]
+	right [
+		edge [ source 0 target 1 label "-" ]
+	]
+])", false);
+		const std::vector<std::shared_ptr<graph::Graph> > graphs{
+			graph::Graph::graphDFS("[a]"),
+			graph::Graph::graphDFS("[b]")
+		};
+		const auto labelSettings = LabelSettings(LabelType::Term, LabelRelation::Specialisation);
+		const auto strategy = dg::Strategy::makeSequence({
+			dg::Strategy::makeAdd(false, graphs),
+			dg::Strategy::makeRule(rLink)
+		});
+		const auto dg = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+		dg->calc();
+		MOD_TEST_CHECK(dg->numEdges() == 2);
+		const auto isoLabelSettings = LabelSettings(LabelType::Term, LabelRelation::Isomorphism);
+		const auto gAA = graph::Graph::graphDFS("[a][a]");
+		const auto gBB = graph::Graph::graphDFS("[b][b]");
+		for(const auto e : dg->edges()) {
+			MOD_TEST_CHECK(e.numSources() == 2);
+			MOD_TEST_CHECK(e.numTargets() == 1);
+			const auto gSrc = (*e.sources().begin()).getGraph();
+			const auto gTar = (*e.targets().begin()).getGraph();
+			const auto gExpected = gSrc == graphs[0] ? gAA : gBB;
+			MOD_TEST_CHECK(1 == gTar->isomorphism(gExpected, 1, isoLabelSettings));
+		}
+	}
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
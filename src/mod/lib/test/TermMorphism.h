@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_TERMMORPHISM_H
+#define MOD_LIB_TEST_TERMMORPHISM_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// Morphisms with term labels, where the terms are unified during the search, compared to unifying each found morphism.
+void termMorphism();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_TERMMORPHISM_H */
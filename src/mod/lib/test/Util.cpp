@@ -0,0 +1,114 @@
+#include "Util.h"
+
+#include <mod/dg/DG.h>
+#include <mod/dg/GraphInterface.h>
+#include <mod/graph/Graph.h>
+#include <mod/rule/Rule.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+
+std::vector<std::string> getRuleNames(const dg::DG::HyperEdge &e) {
+	std::vector<std::string> names;
+	for(const auto r : e.rules()) names.push_back(r->getName());
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+// the rank of the graph id of each vertex, among the graph ids in the derivation graph
+std::vector<std::size_t> getGraphRanks(const dg::DG &dg) {
+	std::vector<std::size_t> ids;
+	for(const auto v : dg.vertices()) ids.push_back(v.getGraph()->getId());
+	auto sorted = ids;
+	std::sort(sorted.begin(), sorted.end());
+	for(auto &id : ids) id = std::lower_bound(sorted.begin(), sorted.end(), id) - sorted.begin();
+	return ids;
+}
+
+// the name of the graph, or the empty string if it is the default name derived from the id
+std::string getNonDefaultName(const graph::Graph &g) {
+	const auto &name = g.getName();
+	if(name == "g_{" + std::to_string(g.getId()) + "}") return "";
+	return name;
+}
+
+} // namespace
+
+void checkSameDG(std::shared_ptr<dg::DG> dgA, std::shared_ptr<dg::DG> dgB, LabelSettings labelSettings) {
+	MOD_TEST_CHECK(dgA->numVertices() == dgB->numVertices());
+	MOD_TEST_CHECK(dgA->numEdges() == dgB->numEdges());
+	std::vector<dg::DG::Vertex> verticesB;
+	for(const auto v : dgB->vertices()) verticesB.push_back(v);
+	std::map<std::size_t, dg::DG::Vertex> vMap; // from the ids of vertices in A
+	for(const auto vA : dgA->vertices()) {
+		const auto iter = std::find_if(verticesB.begin(), verticesB.end(), [&](const dg::DG::Vertex &vB) {
+			return 1 == vA.getGraph()->isomorphism(vB.getGraph(), 1, labelSettings);
+		});
+		MOD_TEST_CHECK(iter != verticesB.end());
+		vMap.emplace(vA.getId(), *iter);
+	}
+	for(const auto eA : dgA->edges()) {
+		std::vector<dg::DG::Vertex> sources, targets;
+		for(const auto v : eA.sources()) sources.push_back(vMap.at(v.getId()));
+		for(const auto v : eA.targets()) targets.push_back(vMap.at(v.getId()));
+		const auto eB = dgB->findEdge(sources, targets);
+		MOD_TEST_CHECK(!eB.isNull());
+		MOD_TEST_CHECK(getRuleNames(eA) == getRuleNames(eB));
+	}
+}
+
+void checkSameDGStrict(std::shared_ptr<dg::DG> dgA, std::shared_ptr<dg::DG> dgB, LabelSettings labelSettings) {
+	MOD_TEST_CHECK(dgA->numVertices() == dgB->numVertices());
+	MOD_TEST_CHECK(dgA->numEdges() == dgB->numEdges());
+	const auto ranksA = getGraphRanks(*dgA);
+	const auto ranksB = getGraphRanks(*dgB);
+	MOD_TEST_CHECK(ranksA == ranksB);
+	std::vector<dg::DG::Vertex> verticesB;
+	for(const auto v : dgB->vertices()) verticesB.push_back(v);
+	std::size_t i = 0;
+	for(const auto vA : dgA->vertices()) {
+		const auto vB = verticesB[i++];
+		MOD_TEST_CHECK(vA.getId() == vB.getId());
+		MOD_TEST_CHECK(getNonDefaultName(*vA.getGraph()) == getNonDefaultName(*vB.getGraph()));
+		MOD_TEST_CHECK(1 == vA.getGraph()->isomorphism(vB.getGraph(), 1, labelSettings));
+	}
+	std::vector<dg::DG::HyperEdge> edgesB;
+	for(const auto e : dgB->edges()) edgesB.push_back(e);
+	i = 0;
+	for(const auto eA : dgA->edges()) {
+		const auto eB = edgesB[i++];
+		MOD_TEST_CHECK(eA.getId() == eB.getId());
+		std::vector<std::size_t> endsA, endsB;
+		for(const auto v : eA.sources()) endsA.push_back(v.getId());
+		for(const auto v : eB.sources()) endsB.push_back(v.getId());
+		endsA.push_back(-1);
+		endsB.push_back(-1);
+		for(const auto v : eA.targets()) endsA.push_back(v.getId());
+		for(const auto v : eB.targets()) endsB.push_back(v.getId());
+		MOD_TEST_CHECK(endsA == endsB);
+		MOD_TEST_CHECK(getRuleNames(eA) == getRuleNames(eB));
+	}
+}
+
+std::shared_ptr<rule::Rule> makeBondRule() {
+	return rule::Rule::ruleGMLString(R"(rule [
+	ruleID "bond"
+	context [
+		node [ id 0 label "C" ]
+		node [ id 1 label "C" ]
+	]
+	right [
+		edge [ source 0 target 1 label "-" ]
+	]
+])", false);
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
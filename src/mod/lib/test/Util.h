@@ -0,0 +1,41 @@
+#ifndef MOD_LIB_TEST_UTIL_H
+#define MOD_LIB_TEST_UTIL_H
+
+#include <mod/Config.h>
+#include <mod/Error.h>
+#include <mod/dg/ForwardDecl.h>
+#include <mod/rule/ForwardDecl.h>
+
+#include <memory>
+#include <string>
+
+// The tests are run through the library, so a failed check throws instead of aborting.
+#define MOD_TEST_CHECK(exp)                                                     \
+	do {                                                                          \
+		if(!(exp)) {                                                                \
+			throw mod::LogicError(std::string("Test check failed, '") + #exp + "', in " \
+					+ __func__ + " at " + __FILE__ + ":" + std::to_string(__LINE__)); \
+		}                                                                           \
+	} while(false)
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// Checks that the two derivation graphs have the same vertices and hyperedges,
+// where vertices are matched by isomorphism of their graphs, and hyperedges by their end points and rule names.
+void checkSameDG(std::shared_ptr<dg::DG> dgA, std::shared_ptr<dg::DG> dgB, LabelSettings labelSettings);
+// Checks that the two derivation graphs were built in the same order,
+// i.e., vertices and hyperedges have the same ids, the graphs have the same names and relative ids,
+// and the hyperedges have the same end points and rule names.
+// Default graph names contain the graph id, so they are compared as relative ids as well.
+void checkSameDGStrict(std::shared_ptr<dg::DG> dgA, std::shared_ptr<dg::DG> dgB, LabelSettings labelSettings);
+
+// A rule bonding two carbons, so chains are grown from single carbons.
+std::shared_ptr<rule::Rule> makeBondRule();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_UTIL_H */
@@ -0,0 +1,108 @@
+#include "VertexOrder.h"
+
+#include <mod/Config.h>
+#include <mod/dg/DG.h>
+#include <mod/dg/Strategies.h>
+#include <mod/graph/Graph.h>
+#include <mod/rule/Rule.h>
+#include <mod/lib/Rules/Real.h>
+#include <mod/lib/test/Util.h>
+
+#include <string>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+
+std::shared_ptr<dg::DG> calcWithOrder(const std::vector<std::shared_ptr<graph::Graph> > &graphs,
+		std::shared_ptr<dg::Strategy> strategy, LabelSettings labelSettings, bool byFrequency) {
+	auto &config = getConfig().rc;
+	const auto oldByFrequency = config.vertexOrderByLabelFrequency.get();
+	config.vertexOrderByLabelFrequency.set(byFrequency);
+	const auto dg = dg::DG::ruleComp(graphs, strategy, labelSettings, false);
+	dg->calc();
+	config.vertexOrderByLabelFrequency.set(oldByFrequency);
+	return dg;
+}
+
+} // namespace
+
+void vertexOrder() {
+	const auto rOxidise = rule::Rule::ruleGMLString(R"(rule [
+	ruleID "oxidise"
+	left [
+		edge [ source 1 target 2 label "-" ]
+	]
+	context [
+		node [ id 0 label "C" ]
+		node [ id 1 label "C" ]
+		node [ id 2 label "O" ]
+		edge [ source 0 target 1 label "-" ]
+	]
+	right [
+		edge [ source 1 target 2 label "=" ]
+	]
+])", false);
+	{ // the order of the left side for a host with many C and few O, and the other way around
+		const auto gLeft = get_labelled_left(rOxidise->getRule().getDPORule());
+		MOD_TEST_CHECK(get_num_connected_components(gLeft) == 1);
+		const auto gComponent = get_component_graph(0, gLeft);
+		const auto labels = get_string(gLeft);
+		const auto ids = get_label_ids(labels);
+		Rules::PropStringCore::LabelId idC = -1, idO = -1;
+		for(const auto v : asRange(vertices(gComponent))) {
+			if(labels[v] == "C") idC = get(ids, v);
+			else idO = get(ids, v);
+		}
+		const auto makeHost = [&](std::size_t numC, std::size_t numO) {
+			std::vector<Rules::PropStringCore::LabelId> hostIds(numC, idC);
+			hostIds.resize(numC + numO, idO);
+			return Rules::makeLabelFrequencies(std::move(hostIds));
+		};
+		const auto checkOrder = [&](const auto &order, const std::vector<std::string> &expected) {
+			MOD_TEST_CHECK(order.size() == num_vertices(gComponent));
+			for(std::size_t i = 0; i < order.size(); ++i) {
+				MOD_TEST_CHECK(labels[order[i]] == expected[i]);
+				// each vertex is adjacent to an earlier one, as the component is connected
+				if(i == 0) continue;
+				bool adjacent = false;
+				for(std::size_t j = 0; j < i; ++j)
+					adjacent = adjacent || edge(order[j], order[i], gComponent).second;
+				MOD_TEST_CHECK(adjacent);
+			}
+		};
+		const auto &orderRareO = get_vertex_order_component(0, gLeft, makeHost(10, 1));
+		checkOrder(orderRareO, {"O", "C", "C"});
+		// the rare C with two neighbours comes first, and then the other rare C
+		const auto &orderRareC = get_vertex_order_component(0, gLeft, makeHost(1, 10));
+		checkOrder(orderRareC, {"C", "C", "O"});
+		MOD_TEST_CHECK(boost::out_degree(orderRareC.front(), gComponent) == 2);
+		// hosts with frequencies in the same logarithmic buckets share the cached order
+		MOD_TEST_CHECK(&get_vertex_order_component(0, gLeft, makeHost(12, 1)) == &orderRareO);
+		MOD_TEST_CHECK(&get_vertex_order_component(0, gLeft, makeHost(1, 12)) == &orderRareC);
+	}
+
+	// the order only changes the search, not what is found
+	const std::vector<std::shared_ptr<graph::Graph> > graphs{
+		graph::Graph::graphDFS("[C][C][O]"),
+		graph::Graph::graphDFS("[O][C]([C][O])[C][O]")
+	};
+	const auto labelSettings = LabelSettings(LabelType::String, LabelRelation::Isomorphism);
+	const auto strategy = dg::Strategy::makeSequence({
+		dg::Strategy::makeAdd(false, graphs),
+		dg::Strategy::makeRepeat(2, dg::Strategy::makeParallel({
+			dg::Strategy::makeRule(rOxidise),
+			dg::Strategy::makeRule(makeBondRule())
+		}))
+	});
+	const auto dgDefault = calcWithOrder(graphs, strategy, labelSettings, false);
+	const auto dgByFrequency = calcWithOrder(graphs, strategy, labelSettings, true);
+	MOD_TEST_CHECK(dgDefault->numEdges() > 0);
+	checkSameDG(dgDefault, dgByFrequency, labelSettings);
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
@@ -0,0 +1,16 @@
+#ifndef MOD_LIB_TEST_VERTEXORDER_H
+#define MOD_LIB_TEST_VERTEXORDER_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// The vertex orders selected by label frequencies in the host, see rc.vertexOrderByLabelFrequency,
+// and that they do not change the derivation graph.
+void vertexOrder();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_VERTEXORDER_H */
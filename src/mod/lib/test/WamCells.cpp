@@ -0,0 +1,127 @@
+#include "WamCells.h"
+
+#include <mod/lib/Term/WAM.h>
+#include <mod/lib/test/Util.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mod {
+namespace lib {
+namespace test {
+namespace {
+using namespace lib::Term;
+
+bool isRef(const Cell &cell, Address addr) {
+	return cell.getTag() == CellTag::REF && cell.getAddr() == addr;
+}
+
+bool isConstant(const Cell &cell, std::size_t name) {
+	return cell.getTag() == CellTag::Structure && cell.getArity() == 0 && cell.getName() == name;
+}
+
+} // namespace
+
+void wamCells() {
+	const std::size_t nameF = 1, nameA = 2, nameB = 3;
+	{ // packing
+		const std::size_t maxAddr = std::numeric_limits<std::uint32_t>::max();
+		for(const auto type : {AddressType::Heap, AddressType::Temp}) {
+			for(const std::size_t addr : {std::size_t(0), std::size_t(42), maxAddr}) {
+				auto cell = Cell::makeSTR({type, addr});
+				MOD_TEST_CHECK(cell.getTag() == CellTag::STR);
+				MOD_TEST_CHECK(cell.getAddr() == (Address{type, addr}));
+				cell.setAddr({AddressType::Heap, 7});
+				MOD_TEST_CHECK(cell.getTag() == CellTag::STR);
+				MOD_TEST_CHECK(cell.getAddr() == (Address{AddressType::Heap, 7}));
+				MOD_TEST_CHECK(isRef(Cell::makeREF({type, addr}), Address{type, addr}));
+			}
+		}
+		const auto cell = Cell::makeStructure((std::size_t(1) << 30) - 1, maxAddr);
+		MOD_TEST_CHECK(cell.getTag() == CellTag::Structure);
+		MOD_TEST_CHECK(cell.getArity() == (std::size_t(1) << 30) - 1);
+		MOD_TEST_CHECK(cell.getName() == maxAddr);
+	}
+	{ // writes to a copy go to its overlay or its own segment, and never to the shared prefix
+		CellStore store(std::vector<Cell>{Cell::makeStructure(0, nameA), Cell::makeStructure(0, nameB)});
+		store.share();
+		CellStore copy = store;
+		copy.getMutable(0) = Cell::makeStructure(0, nameB);
+		copy.push_back(Cell::makeStructure(0, nameF));
+		MOD_TEST_CHECK(copy.size() == 3);
+		MOD_TEST_CHECK(isConstant(copy[0], nameB));
+		MOD_TEST_CHECK(isConstant(copy[2], nameF));
+		MOD_TEST_CHECK(store.size() == 2);
+		MOD_TEST_CHECK(isConstant(store[0], nameA));
+		// sharing again keeps the overlay and the own cells
+		copy.share();
+		MOD_TEST_CHECK(copy.size() == 3);
+		MOD_TEST_CHECK(isConstant(copy[0], nameB));
+		MOD_TEST_CHECK(isConstant(copy[1], nameB));
+		MOD_TEST_CHECK(isConstant(copy[2], nameF));
+		// shrinking into the own segment, and into the shared prefix
+		copy.push_back(Cell::makeStructure(0, nameA));
+		copy.shrink(3);
+		MOD_TEST_CHECK(copy.size() == 3);
+		copy.shrink(1);
+		MOD_TEST_CHECK(copy.size() == 1);
+		MOD_TEST_CHECK(isConstant(copy[0], nameB));
+		copy.push_back(Cell::makeStructure(0, nameF));
+		MOD_TEST_CHECK(isConstant(copy[1], nameF));
+		MOD_TEST_CHECK(isConstant(store[1], nameB));
+	}
+	{ // unification in a copy of a shared machine, f(X) with f(a)
+		Wam original;
+		original.putStructure(nameF, 1);
+		original.putRefPtr();
+		Wam other;
+		other.putStructure(nameF, 1);
+		other.putStructure(nameA, 0);
+		original.setTemp(other);
+		original.share();
+
+		Wam machine = original;
+		MGU mgu(machine.getHeap().size());
+		const auto mark = machine.getMark(mgu);
+		machine.unifyHeapTemp(0, 0, mgu);
+		MOD_TEST_CHECK(mgu.status == MGU::Status::Exists);
+		// X is bound to a copy of a on the heap, and the temp a now points to it
+		const auto addrX = machine.deref({AddressType::Heap, 1});
+		MOD_TEST_CHECK(addrX.type == AddressType::Heap);
+		MOD_TEST_CHECK(addrX.addr >= 2);
+		MOD_TEST_CHECK(isConstant(machine.getCell(addrX), nameA));
+		MOD_TEST_CHECK(machine.getTemp()[1].getTag() == CellTag::STR);
+		// the original is untouched
+		MOD_TEST_CHECK(original.getHeap().size() == 2);
+		MOD_TEST_CHECK(isRef(original.getHeap()[1], Address{AddressType::Heap, 1}));
+		MOD_TEST_CHECK(isConstant(original.getTemp()[1], nameA));
+
+		// reverting the copy gives the original cells back
+		machine.revert(mgu, mark);
+		MOD_TEST_CHECK(machine.getHeap().size() == 2);
+		MOD_TEST_CHECK(isRef(machine.getHeap()[1], Address{AddressType::Heap, 1}));
+		MOD_TEST_CHECK(isConstant(machine.getTemp()[1], nameA));
+		MOD_TEST_CHECK(mgu.bindings.empty());
+		MOD_TEST_CHECK(mgu.overwritten.empty());
+
+		// and a failing unification, f(X) with f(b), fails in a second copy
+		Wam otherB;
+		otherB.putStructure(nameF, 1);
+		otherB.putStructure(nameB, 0);
+		Wam machineB = original;
+		machineB.setTemp(otherB);
+		machineB.putStructure(nameA, 0);
+		MGU mguB(machineB.getHeap().size());
+		machineB.unifyHeapTemp(1, 0, mguB); // X with f(b)
+		MOD_TEST_CHECK(mguB.status == MGU::Status::Exists);
+		machineB.unifyHeapTemp(2, 1, mguB); // a with b
+		MOD_TEST_CHECK(mguB.status == MGU::Status::Fail);
+		MOD_TEST_CHECK(original.getHeap().size() == 2);
+		MOD_TEST_CHECK(isRef(original.getHeap()[1], Address{AddressType::Heap, 1}));
+	}
+}
+
+} // namespace test
+} // namespace lib
+} // namespace mod
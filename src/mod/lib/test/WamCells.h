@@ -0,0 +1,15 @@
+#ifndef MOD_LIB_TEST_WAMCELLS_H
+#define MOD_LIB_TEST_WAMCELLS_H
+
+namespace mod {
+namespace lib {
+namespace test {
+
+// The packed WAM cells, and the sharing of cells between copies of a machine.
+void wamCells();
+
+} // namespace test
+} // namespace lib
+} // namespace mod
+
+#endif /* MOD_LIB_TEST_WAMCELLS_H */
@@ -128,6 +128,14 @@ else
 		echo "Running the wrapper script failed."
 		exit $res
 	fi
+	echo "Library tests"
+	echo "======================================================================"
+	cd $root_PWD/build/mod-*/build && make installcheck
+	res=$?
+	if [ $res -ne 0 ]; then
+		echo "Library tests failed."
+		exit $res
+	fi
 fi
 cd $root_PWD/build/mod-*/
 cd build